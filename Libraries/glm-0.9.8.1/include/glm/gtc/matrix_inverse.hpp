@@ -16,7 +16,10 @@
 #include "../matrix.hpp"
 #include "../mat2x2.hpp"
 #include "../mat3x3.hpp"
+#include "../mat3x4.hpp"
 #include "../mat4x4.hpp"
+#include "../simd/matrix.h"
+#include <cstddef>
 
 #if GLM_MESSAGES == GLM_MESSAGES_ENABLED && !defined(GLM_EXT_INCLUDED)
 #	pragma message("GLM: GLM_GTC_matrix_inverse extension included")
@@ -43,6 +46,27 @@ namespace glm
 	template <typename genType>
 	GLM_FUNC_DECL genType inverseTranspose(genType const & m);
 
+	/// Fast inverse of an array of affine matrices: Out[i] = affineInverse(In[i]).
+	/// Single precision arrays go through SIMD kernels that invert several matrices at once.
+	/// 
+	/// @param In Matrices to invert. Their last row is assumed to be (0, 0, 0, 1).
+	/// @param Out Where the inverses go. It may be the same array as In.
+	/// @param Count Number of matrices.
+	/// @see gtc_matrix_inverse
+	template <typename T, precision P>
+	GLM_FUNC_DECL void affineInverse(tmat4x4<T, P> const * In, tmat4x4<T, P> * Out, std::size_t Count);
+
+	/// Normal matrices for an array of matrices: the inverse transpose of each one's upper 3x3.
+	/// Each result has its columns padded to 4 components with 0, the same layout as a std140 mat3.
+	/// Single precision arrays go through SIMD kernels that handle several matrices at once.
+	/// 
+	/// @param In Matrices to take the normal matrix of.
+	/// @param Out Where the normal matrices go. It can't overlap In.
+	/// @param Count Number of matrices.
+	/// @see gtc_matrix_inverse
+	template <typename T, precision P>
+	GLM_FUNC_DECL void inverseTranspose(tmat4x4<T, P> const * In, tmat3x4<T, P> * Out, std::size_t Count);
+
 	/// @}
 }//namespace glm
 
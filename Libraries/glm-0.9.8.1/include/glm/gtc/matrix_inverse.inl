@@ -117,4 +117,67 @@ namespace glm
 
 		return Inverse;
 	}
+
+namespace detail
+{
+	template <typename T, precision P>
+	struct compute_affineInverse_array
+	{
+		GLM_FUNC_QUALIFIER static void call(tmat4x4<T, P> const * In, tmat4x4<T, P> * Out, std::size_t Count)
+		{
+			for(std::size_t i = 0; i < Count; ++i)
+				Out[i] = affineInverse(In[i]);
+		}
+	};
+
+	template <typename T, precision P>
+	struct compute_inverseTranspose_array
+	{
+		GLM_FUNC_QUALIFIER static void call(tmat4x4<T, P> const * In, tmat3x4<T, P> * Out, std::size_t Count)
+		{
+			for(std::size_t i = 0; i < Count; ++i)
+			{
+				tmat3x3<T, P> const Normal(inverseTranspose(tmat3x3<T, P>(In[i])));
+				Out[i] = tmat3x4<T, P>(
+					tvec4<T, P>(Normal[0], static_cast<T>(0)),
+					tvec4<T, P>(Normal[1], static_cast<T>(0)),
+					tvec4<T, P>(Normal[2], static_cast<T>(0)));
+			}
+		}
+	};
+
+#	if GLM_ARCH & GLM_ARCH_SSE2_BIT
+	template <precision P>
+	struct compute_affineInverse_array<float, P>
+	{
+		GLM_FUNC_QUALIFIER static void call(tmat4x4<float, P> const * In, tmat4x4<float, P> * Out, std::size_t Count)
+		{
+			glm_mat4_affine_inverse_array(&In[0][0][0], &Out[0][0][0], Count);
+		}
+	};
+
+	template <precision P>
+	struct compute_inverseTranspose_array<float, P>
+	{
+		GLM_FUNC_QUALIFIER static void call(tmat4x4<float, P> const * In, tmat3x4<float, P> * Out, std::size_t Count)
+		{
+			glm_mat4_normal_array(&In[0][0][0], &Out[0][0][0], Count);
+		}
+	};
+#	endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+}//namespace detail
+
+	template <typename T, precision P>
+	GLM_FUNC_QUALIFIER void affineInverse(tmat4x4<T, P> const * In, tmat4x4<T, P> * Out, std::size_t Count)
+	{
+		if(Count > 0)
+			detail::compute_affineInverse_array<T, P>::call(In, Out, Count);
+	}
+
+	template <typename T, precision P>
+	GLM_FUNC_QUALIFIER void inverseTranspose(tmat4x4<T, P> const * In, tmat3x4<T, P> * Out, std::size_t Count)
+	{
+		if(Count > 0)
+			detail::compute_inverseTranspose_array<T, P>::call(In, Out, Count);
+	}
 }//namespace glm
@@ -0,0 +1,85 @@
+/// @ref gtx_matrix_batch
+/// @file glm/gtx/matrix_batch.hpp
+///
+/// @see core (dependence)
+///
+/// @defgroup gtx_matrix_batch GLM_GTX_matrix_batch
+/// @ingroup gtx
+///
+/// @brief Multiply whole arrays of vectors and matrices in one call.
+///
+/// Single precision arrays go through the widest SIMD kernels the build allows, prefetching ahead of
+/// the data. Other types fall back to a plain loop.
+///
+/// <glm/gtx/matrix_batch.hpp> need to be included to use these functionalities.
+
+#pragma once
+
+// Dependency:
+#include "../glm.hpp"
+#include "../simd/matrix.h"
+
+#if GLM_HAS_CXX11_STL
+#	include <thread>
+#	include <vector>
+#endif
+
+#if GLM_MESSAGES == GLM_MESSAGES_ENABLED && !defined(GLM_EXT_INCLUDED)
+#	pragma message("GLM: GLM_GTX_matrix_batch extension included")
+#endif
+
+namespace glm
+{
+	/// @addtogroup gtx_matrix_batch
+	/// @{
+
+	/// Transforms Count vectors by one matrix: Out[i] = m * In[i].
+	/// In and Out may be the same array.
+	/// From GLM_GTX_matrix_batch extension.
+	template <typename T, precision P>
+	GLM_FUNC_DECL void batchMul(
+		tmat4x4<T, P> const & m,
+		tvec4<T, P> const * In,
+		tvec4<T, P> * Out,
+		std::size_t Count);
+
+	/// Multiplies parallel arrays of matrices: Out[i] = A[i] * B[i].
+	/// Out may be the same array as A or B.
+	/// From GLM_GTX_matrix_batch extension.
+	template <typename T, precision P>
+	GLM_FUNC_DECL void batchMul(
+		tmat4x4<T, P> const * A,
+		tmat4x4<T, P> const * B,
+		tmat4x4<T, P> * Out,
+		std::size_t Count);
+
+#if GLM_HAS_CXX11_STL
+	/// Same as batchMul, split across up to ThreadCount threads (zero for one per hardware thread),
+	/// counting the calling thread. Arrays too small to be worth starting threads for are done on the
+	/// calling thread alone.
+	/// From GLM_GTX_matrix_batch extension.
+	template <typename T, precision P>
+	GLM_FUNC_DECL void batchMulParallel(
+		tmat4x4<T, P> const & m,
+		tvec4<T, P> const * In,
+		tvec4<T, P> * Out,
+		std::size_t Count,
+		unsigned ThreadCount = 0);
+
+	/// Same as batchMul, split across up to ThreadCount threads (zero for one per hardware thread),
+	/// counting the calling thread. Arrays too small to be worth starting threads for are done on the
+	/// calling thread alone.
+	/// From GLM_GTX_matrix_batch extension.
+	template <typename T, precision P>
+	GLM_FUNC_DECL void batchMulParallel(
+		tmat4x4<T, P> const * A,
+		tmat4x4<T, P> const * B,
+		tmat4x4<T, P> * Out,
+		std::size_t Count,
+		unsigned ThreadCount = 0);
+#endif//GLM_HAS_CXX11_STL
+
+	/// @}
+}//namespace glm
+
+#include "matrix_batch.inl"
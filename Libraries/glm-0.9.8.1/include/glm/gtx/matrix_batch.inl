@@ -0,0 +1,109 @@
+/// @ref gtx_matrix_batch
+/// @file glm/gtx/matrix_batch.inl
+
+namespace glm{
+namespace detail
+{
+	template <typename T, precision P>
+	struct compute_batchMul
+	{
+		GLM_FUNC_QUALIFIER static void call(tmat4x4<T, P> const & m, tvec4<T, P> const * In, tvec4<T, P> * Out, std::size_t Count)
+		{
+			for(std::size_t i = 0; i < Count; ++i)
+				Out[i] = m * In[i];
+		}
+
+		GLM_FUNC_QUALIFIER static void call(tmat4x4<T, P> const * A, tmat4x4<T, P> const * B, tmat4x4<T, P> * Out, std::size_t Count)
+		{
+			for(std::size_t i = 0; i < Count; ++i)
+				Out[i] = A[i] * B[i];
+		}
+	};
+
+#	if GLM_ARCH & GLM_ARCH_SSE2_BIT
+	// Every float precision is laid out as tightly packed floats, so they can all take the SIMD path.
+	template <precision P>
+	struct compute_batchMul<float, P>
+	{
+		GLM_FUNC_QUALIFIER static void call(tmat4x4<float, P> const & m, tvec4<float, P> const * In, tvec4<float, P> * Out, std::size_t Count)
+		{
+			glm_vec4 Columns[4];
+			for(length_t i = 0; i < 4; ++i)
+				Columns[i] = _mm_loadu_ps(&m[i][0]);
+			glm_mat4_mul_vec4_array(Columns, &In[0][0], &Out[0][0], Count);
+		}
+
+		GLM_FUNC_QUALIFIER static void call(tmat4x4<float, P> const * A, tmat4x4<float, P> const * B, tmat4x4<float, P> * Out, std::size_t Count)
+		{
+			glm_mat4_mul_array(&A[0][0][0], &B[0][0][0], &Out[0][0][0], Count);
+		}
+	};
+#	endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+#	if GLM_HAS_CXX11_STL
+	// Splits [0, Count) into one contiguous range per thread, each a multiple of Granularity long so no
+	// two threads write to the same cache line, and runs Func(Begin, End) on each.
+	template <typename F>
+	void batch_parallel_for(std::size_t Count, std::size_t MinPerThread, std::size_t Granularity, unsigned ThreadCount, F Func)
+	{
+		if(ThreadCount == 0)
+			ThreadCount = std::thread::hardware_concurrency();
+		std::size_t const MaxThreads = Count / MinPerThread;
+		if(ThreadCount > MaxThreads)
+			ThreadCount = static_cast<unsigned>(MaxThreads);
+		if(ThreadCount <= 1)
+		{
+			Func(static_cast<std::size_t>(0), Count);
+			return;
+		}
+
+		std::size_t PerThread = (Count + ThreadCount - 1) / ThreadCount;
+		PerThread = (PerThread + Granularity - 1) / Granularity * Granularity;
+
+		std::vector<std::thread> Threads;
+		for(std::size_t Begin = PerThread; Begin < Count; Begin += PerThread)
+			Threads.push_back(std::thread(Func, Begin, Begin + PerThread < Count ? Begin + PerThread : Count));
+		Func(static_cast<std::size_t>(0), PerThread < Count ? PerThread : Count);
+
+		for(std::size_t i = 0; i < Threads.size(); ++i)
+			Threads[i].join();
+	}
+#	endif//GLM_HAS_CXX11_STL
+}//namespace detail
+
+	template <typename T, precision P>
+	GLM_FUNC_QUALIFIER void batchMul(tmat4x4<T, P> const & m, tvec4<T, P> const * In, tvec4<T, P> * Out, std::size_t Count)
+	{
+		if(Count > 0)
+			detail::compute_batchMul<T, P>::call(m, In, Out, Count);
+	}
+
+	template <typename T, precision P>
+	GLM_FUNC_QUALIFIER void batchMul(tmat4x4<T, P> const * A, tmat4x4<T, P> const * B, tmat4x4<T, P> * Out, std::size_t Count)
+	{
+		if(Count > 0)
+			detail::compute_batchMul<T, P>::call(A, B, Out, Count);
+	}
+
+#if GLM_HAS_CXX11_STL
+	// Starting a thread costs about as much as transforming a few thousand vectors, so each thread gets
+	// at least enough work to make that back many times over.
+	template <typename T, precision P>
+	GLM_FUNC_QUALIFIER void batchMulParallel(tmat4x4<T, P> const & m, tvec4<T, P> const * In, tvec4<T, P> * Out, std::size_t Count, unsigned ThreadCount)
+	{
+		detail::batch_parallel_for(Count, 65536, 16, ThreadCount, [&m, In, Out](std::size_t Begin, std::size_t End)
+		{
+			batchMul(m, In + Begin, Out + Begin, End - Begin);
+		});
+	}
+
+	template <typename T, precision P>
+	GLM_FUNC_QUALIFIER void batchMulParallel(tmat4x4<T, P> const * A, tmat4x4<T, P> const * B, tmat4x4<T, P> * Out, std::size_t Count, unsigned ThreadCount)
+	{
+		detail::batch_parallel_for(Count, 16384, 4, ThreadCount, [A, B, Out](std::size_t Begin, std::size_t End)
+		{
+			batchMul(A + Begin, B + Begin, Out + Begin, End - Begin);
+		});
+	}
+#endif//GLM_HAS_CXX11_STL
+}//namespace glm
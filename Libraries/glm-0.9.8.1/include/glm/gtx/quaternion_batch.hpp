@@ -0,0 +1,102 @@
+/// @ref gtx_quaternion_batch
+/// @file glm/gtx/quaternion_batch.hpp
+///
+/// @see core (dependence)
+/// @see gtc_quaternion (dependence)
+/// @see gtx_vec_packet (dependence)
+///
+/// @defgroup gtx_quaternion_batch GLM_GTX_quaternion_batch
+/// @ingroup gtx
+///
+/// @brief Multiply, normalize, interpolate and convert whole arrays of quaternions in one call.
+///
+/// Single precision arrays are transposed into GLM_GTX_vec_packet registers, as many quaternions at a
+/// time as the widest registers the build has (16 with AVX-512, 8 with AVX, 4 otherwise). Other types
+/// fall back to a loop over the GLM_GTC_quaternion functions.
+///
+/// <glm/gtx/quaternion_batch.hpp> need to be included to use these functionalities.
+
+#pragma once
+
+// Dependency:
+#include "../glm.hpp"
+#include "../gtc/quaternion.hpp"
+#include "../gtx/vec_packet.hpp"
+
+#if GLM_MESSAGES == GLM_MESSAGES_ENABLED && !defined(GLM_EXT_INCLUDED)
+#	pragma message("GLM: GLM_GTX_quaternion_batch extension included")
+#endif
+
+namespace glm
+{
+	/// @addtogroup gtx_quaternion_batch
+	/// @{
+
+	/// Multiplies parallel arrays of quaternions: Out[i] = A[i] * B[i].
+	/// Out may be the same array as A or B.
+	/// From GLM_GTX_quaternion_batch extension.
+	template <typename T, precision P>
+	GLM_FUNC_DECL void batchMul(
+		tquat<T, P> const * A,
+		tquat<T, P> const * B,
+		tquat<T, P> * Out,
+		std::size_t Count);
+
+	/// Out[i] = normalize(In[i]), with zero length quaternions becoming the identity like normalize does.
+	/// Out may be the same array as In.
+	/// From GLM_GTX_quaternion_batch extension.
+	template <typename T, precision P>
+	GLM_FUNC_DECL void batchNormalize(
+		tquat<T, P> const * In,
+		tquat<T, P> * Out,
+		std::size_t Count);
+
+	/// Normalized linear interpolation from A[i] to B[i] by a, taking the short way round.
+	/// Out may be the same array as A or B.
+	/// From GLM_GTX_quaternion_batch extension.
+	template <typename T, precision P>
+	GLM_FUNC_DECL void batchNlerp(
+		tquat<T, P> const * A,
+		tquat<T, P> const * B,
+		T a,
+		tquat<T, P> * Out,
+		std::size_t Count);
+
+	/// Out[i] = slerp(A[i], B[i], a), including the linear mix slerp falls back to for nearly equal
+	/// quaternions. The float version evaluates acos and sin as polynomials, so a has to be in [0, 1].
+	/// Out may be the same array as A or B.
+	/// From GLM_GTX_quaternion_batch extension.
+	template <typename T, precision P>
+	GLM_FUNC_DECL void batchSlerp(
+		tquat<T, P> const * A,
+		tquat<T, P> const * B,
+		T a,
+		tquat<T, P> * Out,
+		std::size_t Count);
+
+	/// Approximates batchSlerp with an nlerp whose interpolation factor is corrected by a polynomial in a
+	/// and the angle between the quaternions, staying within about 1e-3 of slerp for roughly the cost of
+	/// batchNlerp. The results are normalized.
+	/// Out may be the same array as A or B.
+	/// From GLM_GTX_quaternion_batch extension.
+	template <typename T, precision P>
+	GLM_FUNC_DECL void batchFastSlerp(
+		tquat<T, P> const * A,
+		tquat<T, P> const * B,
+		T a,
+		tquat<T, P> * Out,
+		std::size_t Count);
+
+	/// Out[i] = mat3_cast(In[i]), with each column padded with a zero so the result can be copied
+	/// straight into a std140 mat3 or the top of a mat4 with a translation in the fourth column.
+	/// From GLM_GTX_quaternion_batch extension.
+	template <typename T, precision P>
+	GLM_FUNC_DECL void batchMat3x4Cast(
+		tquat<T, P> const * In,
+		tmat3x4<T, P> * Out,
+		std::size_t Count);
+
+	/// @}
+}//namespace glm
+
+#include "quaternion_batch.inl"
@@ -0,0 +1,428 @@
+/// @ref gtx_quaternion_batch
+/// @file glm/gtx/quaternion_batch.inl
+
+namespace glm{
+namespace detail
+{
+	// The factor nlerp has to interpolate by to land close to where slerp would, from "Approximating
+	// slerp" by Arseny Kapoulkine. CosTheta is the absolute cosine of the angle between the quaternions.
+	template <typename genType>
+	GLM_FUNC_QUALIFIER genType fast_slerp_factor(genType const & CosTheta, genType const & a)
+	{
+		genType const Half(0.5f);
+		genType const Scale = genType(1.0904f) + CosTheta * (genType(-3.2452f) + CosTheta * (genType(3.55645f) - CosTheta * genType(1.43519f)));
+		genType const Bias = genType(0.848013f) + CosTheta * (genType(-1.06021f) + CosTheta * genType(0.215638f));
+		genType const k = Scale * (a - Half) * (a - Half) + Bias;
+		return a + a * (a - Half) * (a - genType(1.0f)) * k;
+	}
+
+	template <typename T, precision P>
+	struct compute_quat_batchMul
+	{
+		GLM_FUNC_QUALIFIER static void call(tquat<T, P> const * A, tquat<T, P> const * B, tquat<T, P> * Out, std::size_t Count)
+		{
+			for(std::size_t i = 0; i < Count; ++i)
+				Out[i] = A[i] * B[i];
+		}
+	};
+
+	template <typename T, precision P>
+	struct compute_quat_batchNormalize
+	{
+		GLM_FUNC_QUALIFIER static void call(tquat<T, P> const * In, tquat<T, P> * Out, std::size_t Count)
+		{
+			for(std::size_t i = 0; i < Count; ++i)
+				Out[i] = normalize(In[i]);
+		}
+	};
+
+	template <typename T, precision P>
+	struct compute_quat_batchNlerp
+	{
+		GLM_FUNC_QUALIFIER static void call(tquat<T, P> const * A, tquat<T, P> const * B, T a, tquat<T, P> * Out, std::size_t Count)
+		{
+			for(std::size_t i = 0; i < Count; ++i)
+			{
+				tquat<T, P> const b = dot(A[i], B[i]) < T(0) ? -B[i] : B[i];
+				Out[i] = normalize(A[i] * (T(1) - a) + b * a);
+			}
+		}
+	};
+
+	template <typename T, precision P>
+	struct compute_quat_batchSlerp
+	{
+		GLM_FUNC_QUALIFIER static void call(tquat<T, P> const * A, tquat<T, P> const * B, T a, tquat<T, P> * Out, std::size_t Count)
+		{
+			for(std::size_t i = 0; i < Count; ++i)
+				Out[i] = slerp(A[i], B[i], a);
+		}
+	};
+
+	template <typename T, precision P>
+	struct compute_quat_batchFastSlerp
+	{
+		GLM_FUNC_QUALIFIER static void call(tquat<T, P> const * A, tquat<T, P> const * B, T a, tquat<T, P> * Out, std::size_t Count)
+		{
+			for(std::size_t i = 0; i < Count; ++i)
+			{
+				T CosTheta = dot(A[i], B[i]);
+				tquat<T, P> b = B[i];
+				if(CosTheta < T(0))
+				{
+					b = -b;
+					CosTheta = -CosTheta;
+				}
+				T const Factor = fast_slerp_factor(CosTheta, a);
+				Out[i] = normalize(A[i] * (T(1) - Factor) + b * Factor);
+			}
+		}
+	};
+
+	template <typename T, precision P>
+	struct compute_quat_batchMat3x4Cast
+	{
+		GLM_FUNC_QUALIFIER static void call(tquat<T, P> const * In, tmat3x4<T, P> * Out, std::size_t Count)
+		{
+			for(std::size_t i = 0; i < Count; ++i)
+			{
+				tmat3x3<T, P> const m = mat3_cast(In[i]);
+				Out[i] = tmat3x4<T, P>(tvec4<T, P>(m[0], T(0)), tvec4<T, P>(m[1], T(0)), tvec4<T, P>(m[2], T(0)));
+			}
+		}
+	};
+
+	// How many single precision quaternions the kernels below work on at once: one register's worth.
+#	if (GLM_ARCH & GLM_ARCH_SSE2_BIT) && (GLM_ARCH & GLM_ARCH_AVX512_BIT)
+		length_t const quat_batch_lanes = 16;
+#	elif (GLM_ARCH & GLM_ARCH_SSE2_BIT) && (GLM_ARCH & GLM_ARCH_AVX_BIT)
+		length_t const quat_batch_lanes = 8;
+#	else
+		length_t const quat_batch_lanes = 4;
+#	endif
+
+	// Quaternions are packed as (x, y, z, w) in tvec4x lanes.
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec4x<N> quat_packet_identity()
+	{
+		tfloatx<N> const Zero(0.0f);
+		return tvec4x<N>(Zero, Zero, Zero, tfloatx<N>(1.0f));
+	}
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec4x<N> quat_packet_normalize(tvec4x<N> const & q)
+	{
+		tfloatx<N> const Len2 = dot(q, q);
+		return select(greaterThan(Len2, tfloatx<N>(0.0f)), q * inversesqrt(Len2), quat_packet_identity<N>());
+	}
+
+	// Negates b in the lanes where it is on the far side of the sphere from a, and returns the absolute
+	// cosine of the angle between them.
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tfloatx<N> quat_packet_shortest(tvec4x<N> const & a, tvec4x<N> & b)
+	{
+		tfloatx<N> const CosTheta = dot(a, b);
+		b = select(lessThan(CosTheta, tfloatx<N>(0.0f)), -b, b);
+		return abs(CosTheta);
+	}
+
+	// acos over [0, 1], Abramowitz and Stegun 4.4.46, absolute error under 2e-8.
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tfloatx<N> quat_packet_acos(tfloatx<N> const & x)
+	{
+		tfloatx<N> p(-0.0012624911f);
+		p = fma(p, x, tfloatx<N>(0.0066700901f));
+		p = fma(p, x, tfloatx<N>(-0.0170881256f));
+		p = fma(p, x, tfloatx<N>(0.0308918810f));
+		p = fma(p, x, tfloatx<N>(-0.0501743046f));
+		p = fma(p, x, tfloatx<N>(0.0889789874f));
+		p = fma(p, x, tfloatx<N>(-0.2145988016f));
+		p = fma(p, x, tfloatx<N>(1.5707963050f));
+		return p * sqrt(tfloatx<N>(1.0f) - x);
+	}
+
+	// sin over [0, pi / 2] from its Taylor series up to x^11, absolute error under 6e-8.
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tfloatx<N> quat_packet_sin(tfloatx<N> const & x)
+	{
+		tfloatx<N> const x2 = x * x;
+		tfloatx<N> p(-1.0f / 39916800.0f);
+		p = fma(p, x2, tfloatx<N>(1.0f / 362880.0f));
+		p = fma(p, x2, tfloatx<N>(-1.0f / 5040.0f));
+		p = fma(p, x2, tfloatx<N>(1.0f / 120.0f));
+		p = fma(p, x2, tfloatx<N>(-1.0f / 6.0f));
+		p = fma(p, x2, tfloatx<N>(1.0f));
+		return p * x;
+	}
+
+	template <length_t N>
+	struct quat_packet_mul
+	{
+		GLM_FUNC_QUALIFIER tvec4x<N> operator()(tvec4x<N> const & a, tvec4x<N> const & b) const
+		{
+			return tvec4x<N>(
+				fma(a.w, b.x, fma(a.x, b.w, fma(a.y, b.z, -(a.z * b.y)))),
+				fma(a.w, b.y, fma(a.y, b.w, fma(a.z, b.x, -(a.x * b.z)))),
+				fma(a.w, b.z, fma(a.z, b.w, fma(a.x, b.y, -(a.y * b.x)))),
+				fma(a.w, b.w, -fma(a.x, b.x, fma(a.y, b.y, a.z * b.z))));
+		}
+	};
+
+	template <length_t N>
+	struct quat_packet_nlerp
+	{
+		tfloatx<N> t;
+
+		GLM_FUNC_QUALIFIER explicit quat_packet_nlerp(float a) : t(a) {}
+
+		GLM_FUNC_QUALIFIER tvec4x<N> operator()(tvec4x<N> const & a, tvec4x<N> const & b) const
+		{
+			tvec4x<N> Far = b;
+			quat_packet_shortest(a, Far);
+			return quat_packet_normalize(a * (tfloatx<N>(1.0f) - t) + Far * t);
+		}
+	};
+
+	template <length_t N>
+	struct quat_packet_slerp
+	{
+		tfloatx<N> t;
+
+		GLM_FUNC_QUALIFIER explicit quat_packet_slerp(float a) : t(a) {}
+
+		GLM_FUNC_QUALIFIER tvec4x<N> operator()(tvec4x<N> const & a, tvec4x<N> const & b) const
+		{
+			tfloatx<N> const One(1.0f);
+			tvec4x<N> Far = b;
+			tfloatx<N> const CosTheta = min(quat_packet_shortest(a, Far), One);
+
+			// Same cut off as slerp, below which sin(Angle) gets too small to divide by.
+			tboolx<N> const Linear = greaterThan(CosTheta, tfloatx<N>(1.0f - epsilon<float>()));
+			tfloatx<N> const Angle = quat_packet_acos(CosTheta);
+			tfloatx<N> const OneOverSin = One / select(Linear, One, quat_packet_sin(Angle));
+			tfloatx<N> const WeightA = select(Linear, One - t, quat_packet_sin((One - t) * Angle) * OneOverSin);
+			tfloatx<N> const WeightB = select(Linear, t, quat_packet_sin(t * Angle) * OneOverSin);
+			return a * WeightA + Far * WeightB;
+		}
+	};
+
+	template <length_t N>
+	struct quat_packet_fast_slerp
+	{
+		tfloatx<N> t;
+
+		GLM_FUNC_QUALIFIER explicit quat_packet_fast_slerp(float a) : t(a) {}
+
+		GLM_FUNC_QUALIFIER tvec4x<N> operator()(tvec4x<N> const & a, tvec4x<N> const & b) const
+		{
+			tvec4x<N> Far = b;
+			tfloatx<N> const Factor = fast_slerp_factor(quat_packet_shortest(a, Far), t);
+			return quat_packet_normalize(a * (tfloatx<N>(1.0f) - Factor) + Far * Factor);
+		}
+	};
+
+	template <length_t N>
+	struct quat_packet_normalize_op
+	{
+		GLM_FUNC_QUALIFIER tvec4x<N> operator()(tvec4x<N> const & q) const
+		{
+			return quat_packet_normalize(q);
+		}
+	};
+
+	// Copies the last Count % N quaternions into a block of N padded with identities, which every kernel
+	// here handles without dividing by zero, so the tail goes through the same code as the rest.
+	template <length_t N, precision P>
+	GLM_FUNC_QUALIFIER void quat_batch_tail(tquat<float, P> const * In, std::size_t Count, tquat<float, P> * Tail)
+	{
+		for(std::size_t i = 0; i < N; ++i)
+			Tail[i] = i < Count ? In[i] : tquat<float, P>(1.0f, 0.0f, 0.0f, 0.0f);
+	}
+
+	template <length_t N, precision P, typename F>
+	GLM_FUNC_QUALIFIER void quat_batch_unary(tquat<float, P> const * In, tquat<float, P> * Out, std::size_t Count, F const & Func)
+	{
+		std::size_t i = 0;
+		for(; i + N <= Count; i += N)
+		{
+			tvec4x<N> q;
+			load_aos4(&In[i].x, q.x, q.y, q.z, q.w, 4);
+			tvec4x<N> const r = Func(q);
+			store_aos4(&Out[i].x, r.x, r.y, r.z, r.w, 4);
+		}
+
+		if(i < Count)
+		{
+			tquat<float, P> Tail[N];
+			quat_batch_tail<N>(In + i, Count - i, Tail);
+			quat_batch_unary<N>(Tail, Tail, N, Func);
+			for(std::size_t j = 0; i + j < Count; ++j)
+				Out[i + j] = Tail[j];
+		}
+	}
+
+	template <length_t N, precision P, typename F>
+	GLM_FUNC_QUALIFIER void quat_batch_binary(tquat<float, P> const * A, tquat<float, P> const * B, tquat<float, P> * Out, std::size_t Count, F const & Func)
+	{
+		std::size_t i = 0;
+		for(; i + N <= Count; i += N)
+		{
+			tvec4x<N> a, b;
+			load_aos4(&A[i].x, a.x, a.y, a.z, a.w, 4);
+			load_aos4(&B[i].x, b.x, b.y, b.z, b.w, 4);
+			tvec4x<N> const r = Func(a, b);
+			store_aos4(&Out[i].x, r.x, r.y, r.z, r.w, 4);
+		}
+
+		if(i < Count)
+		{
+			tquat<float, P> TailA[N], TailB[N];
+			quat_batch_tail<N>(A + i, Count - i, TailA);
+			quat_batch_tail<N>(B + i, Count - i, TailB);
+			quat_batch_binary<N>(TailA, TailB, TailA, N, Func);
+			for(std::size_t j = 0; i + j < Count; ++j)
+				Out[i + j] = TailA[j];
+		}
+	}
+
+	// Every float precision is laid out as tightly packed floats, so they can all take the packet path.
+	template <precision P>
+	struct compute_quat_batchMul<float, P>
+	{
+		GLM_FUNC_QUALIFIER static void call(tquat<float, P> const * A, tquat<float, P> const * B, tquat<float, P> * Out, std::size_t Count)
+		{
+			quat_batch_binary<quat_batch_lanes>(A, B, Out, Count, quat_packet_mul<quat_batch_lanes>());
+		}
+	};
+
+	template <precision P>
+	struct compute_quat_batchNormalize<float, P>
+	{
+		GLM_FUNC_QUALIFIER static void call(tquat<float, P> const * In, tquat<float, P> * Out, std::size_t Count)
+		{
+			quat_batch_unary<quat_batch_lanes>(In, Out, Count, quat_packet_normalize_op<quat_batch_lanes>());
+		}
+	};
+
+	template <precision P>
+	struct compute_quat_batchNlerp<float, P>
+	{
+		GLM_FUNC_QUALIFIER static void call(tquat<float, P> const * A, tquat<float, P> const * B, float a, tquat<float, P> * Out, std::size_t Count)
+		{
+			quat_batch_binary<quat_batch_lanes>(A, B, Out, Count, quat_packet_nlerp<quat_batch_lanes>(a));
+		}
+	};
+
+	template <precision P>
+	struct compute_quat_batchSlerp<float, P>
+	{
+		GLM_FUNC_QUALIFIER static void call(tquat<float, P> const * A, tquat<float, P> const * B, float a, tquat<float, P> * Out, std::size_t Count)
+		{
+			quat_batch_binary<quat_batch_lanes>(A, B, Out, Count, quat_packet_slerp<quat_batch_lanes>(a));
+		}
+	};
+
+	template <precision P>
+	struct compute_quat_batchFastSlerp<float, P>
+	{
+		GLM_FUNC_QUALIFIER static void call(tquat<float, P> const * A, tquat<float, P> const * B, float a, tquat<float, P> * Out, std::size_t Count)
+		{
+			quat_batch_binary<quat_batch_lanes>(A, B, Out, Count, quat_packet_fast_slerp<quat_batch_lanes>(a));
+		}
+	};
+
+	template <precision P>
+	struct compute_quat_batchMat3x4Cast<float, P>
+	{
+		GLM_FUNC_QUALIFIER static void call(tquat<float, P> const * In, tmat3x4<float, P> * Out, std::size_t Count)
+		{
+			length_t const N = quat_batch_lanes;
+
+			std::size_t i = 0;
+			for(; i + N <= Count; i += N)
+				block(&In[i], &Out[i][0][0]);
+
+			if(i < Count)
+			{
+				tquat<float, P> TailIn[N];
+				tmat3x4<float, P> TailOut[N];
+				quat_batch_tail<N>(In + i, Count - i, TailIn);
+				block(TailIn, &TailOut[0][0][0]);
+				for(std::size_t j = 0; i + j < Count; ++j)
+					Out[i + j] = TailOut[j];
+			}
+		}
+
+	private:
+		// Writes N matrices of three padded columns each, 12 floats apart.
+		GLM_FUNC_QUALIFIER static void block(tquat<float, P> const * In, float * Out)
+		{
+			length_t const N = quat_batch_lanes;
+
+			tvec4x<N> q;
+			load_aos4(&In[0].x, q.x, q.y, q.z, q.w, 4);
+
+			tfloatx<N> const One(1.0f);
+			tfloatx<N> const Zero(0.0f);
+			tfloatx<N> const x2 = q.x + q.x;
+			tfloatx<N> const y2 = q.y + q.y;
+			tfloatx<N> const z2 = q.z + q.z;
+			tfloatx<N> const xx = q.x * x2;
+			tfloatx<N> const yy = q.y * y2;
+			tfloatx<N> const zz = q.z * z2;
+			tfloatx<N> const xy = q.x * y2;
+			tfloatx<N> const xz = q.x * z2;
+			tfloatx<N> const yz = q.y * z2;
+			tfloatx<N> const wx = q.w * x2;
+			tfloatx<N> const wy = q.w * y2;
+			tfloatx<N> const wz = q.w * z2;
+
+			store_aos4(Out + 0, One - (yy + zz), xy + wz, xz - wy, Zero, 12);
+			store_aos4(Out + 4, xy - wz, One - (xx + zz), yz + wx, Zero, 12);
+			store_aos4(Out + 8, xz + wy, yz - wx, One - (xx + yy), Zero, 12);
+		}
+	};
+}//namespace detail
+
+	template <typename T, precision P>
+	GLM_FUNC_QUALIFIER void batchMul(tquat<T, P> const * A, tquat<T, P> const * B, tquat<T, P> * Out, std::size_t Count)
+	{
+		if(Count > 0)
+			detail::compute_quat_batchMul<T, P>::call(A, B, Out, Count);
+	}
+
+	template <typename T, precision P>
+	GLM_FUNC_QUALIFIER void batchNormalize(tquat<T, P> const * In, tquat<T, P> * Out, std::size_t Count)
+	{
+		if(Count > 0)
+			detail::compute_quat_batchNormalize<T, P>::call(In, Out, Count);
+	}
+
+	template <typename T, precision P>
+	GLM_FUNC_QUALIFIER void batchNlerp(tquat<T, P> const * A, tquat<T, P> const * B, T a, tquat<T, P> * Out, std::size_t Count)
+	{
+		if(Count > 0)
+			detail::compute_quat_batchNlerp<T, P>::call(A, B, a, Out, Count);
+	}
+
+	template <typename T, precision P>
+	GLM_FUNC_QUALIFIER void batchSlerp(tquat<T, P> const * A, tquat<T, P> const * B, T a, tquat<T, P> * Out, std::size_t Count)
+	{
+		if(Count > 0)
+			detail::compute_quat_batchSlerp<T, P>::call(A, B, a, Out, Count);
+	}
+
+	template <typename T, precision P>
+	GLM_FUNC_QUALIFIER void batchFastSlerp(tquat<T, P> const * A, tquat<T, P> const * B, T a, tquat<T, P> * Out, std::size_t Count)
+	{
+		if(Count > 0)
+			detail::compute_quat_batchFastSlerp<T, P>::call(A, B, a, Out, Count);
+	}
+
+	template <typename T, precision P>
+	GLM_FUNC_QUALIFIER void batchMat3x4Cast(tquat<T, P> const * In, tmat3x4<T, P> * Out, std::size_t Count)
+	{
+		if(Count > 0)
+			detail::compute_quat_batchMat3x4Cast<T, P>::call(In, Out, Count);
+	}
+}//namespace glm
@@ -0,0 +1,370 @@
+/// @ref gtx_vec_packet
+/// @file glm/gtx/vec_packet.hpp
+///
+/// @see core (dependence)
+///
+/// @defgroup gtx_vec_packet GLM_GTX_vec_packet
+/// @ingroup gtx
+///
+/// @brief Structure of arrays vectors that hold one component of N vectors per register.
+///
+/// A tvec3x<N> is N vec3s stored as N x values, N y values and N z values, so every operation works on N
+/// vectors at once without wasting lanes on padding or horizontal adds. tfloatx<N> is one of those
+/// components and tboolx<N> is the mask that comparisons on it return. Widths the build has registers
+/// for (4 with SSE2, 8 with AVX, 16 with AVX-512) map to one register each, and wider ones are made of
+/// two narrower halves.
+///
+/// <glm/gtx/vec_packet.hpp> need to be included to use these functionalities.
+
+#pragma once
+
+// Dependency:
+#include "../glm.hpp"
+#include "../simd/matrix.h"
+
+#if GLM_MESSAGES == GLM_MESSAGES_ENABLED && !defined(GLM_EXT_INCLUDED)
+#	pragma message("GLM: GLM_GTX_vec_packet extension included")
+#endif
+
+namespace glm
+{
+	/// @addtogroup gtx_vec_packet
+	/// @{
+
+	/// N float lanes. N has to be a power of two.
+	template <length_t N>
+	struct tfloatx
+	{
+		tfloatx<N / 2> lo, hi;
+
+		GLM_FUNC_DECL tfloatx() GLM_DEFAULT_CTOR;
+		GLM_FUNC_DECL explicit tfloatx(float s);
+		GLM_FUNC_DECL tfloatx(tfloatx<N / 2> const & lo, tfloatx<N / 2> const & hi);
+
+		/// Loads N consecutive floats, with no alignment needed.
+		GLM_FUNC_DECL static tfloatx load(float const * p);
+		GLM_FUNC_DECL void store(float * p) const;
+	};
+
+	/// A true or false for each of N lanes.
+	template <length_t N>
+	struct tboolx
+	{
+		tboolx<N / 2> lo, hi;
+
+		GLM_FUNC_DECL tboolx() GLM_DEFAULT_CTOR;
+		GLM_FUNC_DECL tboolx(tboolx<N / 2> const & lo, tboolx<N / 2> const & hi);
+	};
+
+	template <>
+	struct tfloatx<1>
+	{
+		float data;
+
+		GLM_FUNC_DECL tfloatx() GLM_DEFAULT_CTOR;
+		GLM_FUNC_DECL explicit tfloatx(float s);
+
+		GLM_FUNC_DECL static tfloatx load(float const * p);
+		GLM_FUNC_DECL void store(float * p) const;
+	};
+
+	template <>
+	struct tboolx<1>
+	{
+		bool data;
+
+		GLM_FUNC_DECL tboolx() GLM_DEFAULT_CTOR;
+		GLM_FUNC_DECL explicit tboolx(bool b);
+	};
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+	template <>
+	struct tfloatx<4>
+	{
+		glm_vec4 data;
+
+		GLM_FUNC_DECL tfloatx() GLM_DEFAULT_CTOR;
+		GLM_FUNC_DECL explicit tfloatx(float s);
+		GLM_FUNC_DECL explicit tfloatx(glm_vec4 v);
+
+		GLM_FUNC_DECL static tfloatx load(float const * p);
+		GLM_FUNC_DECL void store(float * p) const;
+	};
+
+	/// Each lane is all ones or all zeros, as SSE comparisons return them.
+	template <>
+	struct tboolx<4>
+	{
+		glm_vec4 data;
+
+		GLM_FUNC_DECL tboolx() GLM_DEFAULT_CTOR;
+		GLM_FUNC_DECL explicit tboolx(glm_vec4 v);
+	};
+
+#	if GLM_ARCH & GLM_ARCH_AVX_BIT
+	template <>
+	struct tfloatx<8>
+	{
+		__m256 data;
+
+		GLM_FUNC_DECL tfloatx() GLM_DEFAULT_CTOR;
+		GLM_FUNC_DECL explicit tfloatx(float s);
+		GLM_FUNC_DECL explicit tfloatx(__m256 v);
+		GLM_FUNC_DECL tfloatx(tfloatx<4> const & lo, tfloatx<4> const & hi);
+
+		GLM_FUNC_DECL static tfloatx load(float const * p);
+		GLM_FUNC_DECL void store(float * p) const;
+	};
+
+	template <>
+	struct tboolx<8>
+	{
+		__m256 data;
+
+		GLM_FUNC_DECL tboolx() GLM_DEFAULT_CTOR;
+		GLM_FUNC_DECL explicit tboolx(__m256 v);
+	};
+#	endif//GLM_ARCH & GLM_ARCH_AVX_BIT
+
+#	if GLM_ARCH & GLM_ARCH_AVX512_BIT
+	template <>
+	struct tfloatx<16>
+	{
+		__m512 data;
+
+		GLM_FUNC_DECL tfloatx() GLM_DEFAULT_CTOR;
+		GLM_FUNC_DECL explicit tfloatx(float s);
+		GLM_FUNC_DECL explicit tfloatx(__m512 v);
+		GLM_FUNC_DECL tfloatx(tfloatx<8> const & lo, tfloatx<8> const & hi);
+
+		GLM_FUNC_DECL static tfloatx load(float const * p);
+		GLM_FUNC_DECL void store(float * p) const;
+	};
+
+	/// One bit per lane, as AVX-512 comparisons return them.
+	template <>
+	struct tboolx<16>
+	{
+		__mmask16 data;
+
+		GLM_FUNC_DECL tboolx() GLM_DEFAULT_CTOR;
+		GLM_FUNC_DECL explicit tboolx(__mmask16 m);
+	};
+#	endif//GLM_ARCH & GLM_ARCH_AVX512_BIT
+#endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+	/// N vec3s, one tfloatx<N> per component.
+	template <length_t N>
+	struct tvec3x
+	{
+		tfloatx<N> x, y, z;
+
+		GLM_FUNC_DECL tvec3x() GLM_DEFAULT_CTOR;
+		GLM_FUNC_DECL explicit tvec3x(tfloatx<N> const & s);
+		GLM_FUNC_DECL tvec3x(tfloatx<N> const & x, tfloatx<N> const & y, tfloatx<N> const & z);
+
+		/// The same vector in every lane.
+		template <precision P>
+		GLM_FUNC_DECL explicit tvec3x(tvec3<float, P> const & v);
+
+		/// Loads N consecutive vec3s, with no alignment needed.
+		template <precision P>
+		GLM_FUNC_DECL static tvec3x load(tvec3<float, P> const * In);
+		template <precision P>
+		GLM_FUNC_DECL void store(tvec3<float, P> * Out) const;
+
+		/// Loads N consecutive values from each of three arrays of components.
+		GLM_FUNC_DECL static tvec3x load(float const * x, float const * y, float const * z);
+		GLM_FUNC_DECL void store(float * x, float * y, float * z) const;
+	};
+
+	/// N vec4s, one tfloatx<N> per component.
+	template <length_t N>
+	struct tvec4x
+	{
+		tfloatx<N> x, y, z, w;
+
+		GLM_FUNC_DECL tvec4x() GLM_DEFAULT_CTOR;
+		GLM_FUNC_DECL explicit tvec4x(tfloatx<N> const & s);
+		GLM_FUNC_DECL tvec4x(tfloatx<N> const & x, tfloatx<N> const & y, tfloatx<N> const & z, tfloatx<N> const & w);
+
+		/// The same vector in every lane.
+		template <precision P>
+		GLM_FUNC_DECL explicit tvec4x(tvec4<float, P> const & v);
+
+		/// Loads N consecutive vec4s, with no alignment needed.
+		template <precision P>
+		GLM_FUNC_DECL static tvec4x load(tvec4<float, P> const * In);
+		template <precision P>
+		GLM_FUNC_DECL void store(tvec4<float, P> * Out) const;
+
+		/// Loads N consecutive values from each of four arrays of components.
+		GLM_FUNC_DECL static tvec4x load(float const * x, float const * y, float const * z, float const * w);
+		GLM_FUNC_DECL void store(float * x, float * y, float * z, float * w) const;
+	};
+
+	typedef tfloatx<4> floatx4;
+	typedef tfloatx<8> floatx8;
+	typedef tfloatx<16> floatx16;
+	typedef tboolx<4> boolx4;
+	typedef tboolx<8> boolx8;
+	typedef tboolx<16> boolx16;
+	typedef tvec3x<4> vec3x4;
+	typedef tvec3x<8> vec3x8;
+	typedef tvec3x<16> vec3x16;
+	typedef tvec4x<4> vec4x4;
+	typedef tvec4x<8> vec4x8;
+	typedef tvec4x<16> vec4x16;
+
+	// -- Lanes --
+
+	template <length_t N>
+	GLM_FUNC_DECL tfloatx<N> operator-(tfloatx<N> const & a);
+	template <length_t N>
+	GLM_FUNC_DECL tfloatx<N> operator+(tfloatx<N> const & a, tfloatx<N> const & b);
+	template <length_t N>
+	GLM_FUNC_DECL tfloatx<N> operator-(tfloatx<N> const & a, tfloatx<N> const & b);
+	template <length_t N>
+	GLM_FUNC_DECL tfloatx<N> operator*(tfloatx<N> const & a, tfloatx<N> const & b);
+	template <length_t N>
+	GLM_FUNC_DECL tfloatx<N> operator/(tfloatx<N> const & a, tfloatx<N> const & b);
+
+	/// a * b + c, fused where the build has FMA.
+	/// From GLM_GTX_vec_packet extension.
+	template <length_t N>
+	GLM_FUNC_DECL tfloatx<N> fma(tfloatx<N> const & a, tfloatx<N> const & b, tfloatx<N> const & c);
+
+	template <length_t N>
+	GLM_FUNC_DECL tfloatx<N> min(tfloatx<N> const & a, tfloatx<N> const & b);
+	template <length_t N>
+	GLM_FUNC_DECL tfloatx<N> max(tfloatx<N> const & a, tfloatx<N> const & b);
+	template <length_t N>
+	GLM_FUNC_DECL tfloatx<N> abs(tfloatx<N> const & a);
+	template <length_t N>
+	GLM_FUNC_DECL tfloatx<N> sqrt(tfloatx<N> const & a);
+	template <length_t N>
+	GLM_FUNC_DECL tfloatx<N> inversesqrt(tfloatx<N> const & a);
+
+	template <length_t N>
+	GLM_FUNC_DECL tboolx<N> lessThan(tfloatx<N> const & a, tfloatx<N> const & b);
+	template <length_t N>
+	GLM_FUNC_DECL tboolx<N> lessThanEqual(tfloatx<N> const & a, tfloatx<N> const & b);
+	template <length_t N>
+	GLM_FUNC_DECL tboolx<N> greaterThan(tfloatx<N> const & a, tfloatx<N> const & b);
+	template <length_t N>
+	GLM_FUNC_DECL tboolx<N> greaterThanEqual(tfloatx<N> const & a, tfloatx<N> const & b);
+	template <length_t N>
+	GLM_FUNC_DECL tboolx<N> equal(tfloatx<N> const & a, tfloatx<N> const & b);
+	template <length_t N>
+	GLM_FUNC_DECL tboolx<N> notEqual(tfloatx<N> const & a, tfloatx<N> const & b);
+
+	/// a in the lanes where m is true, b in the rest.
+	/// From GLM_GTX_vec_packet extension.
+	template <length_t N>
+	GLM_FUNC_DECL tfloatx<N> select(tboolx<N> const & m, tfloatx<N> const & a, tfloatx<N> const & b);
+
+	// -- Masks --
+
+	template <length_t N>
+	GLM_FUNC_DECL tboolx<N> operator&(tboolx<N> const & a, tboolx<N> const & b);
+	template <length_t N>
+	GLM_FUNC_DECL tboolx<N> operator|(tboolx<N> const & a, tboolx<N> const & b);
+	template <length_t N>
+	GLM_FUNC_DECL tboolx<N> not_(tboolx<N> const & m);
+	template <length_t N>
+	GLM_FUNC_DECL bool any(tboolx<N> const & m);
+	template <length_t N>
+	GLM_FUNC_DECL bool all(tboolx<N> const & m);
+
+	/// Bit i is set if lane i is true, for up to 32 lanes.
+	/// From GLM_GTX_vec_packet extension.
+	template <length_t N>
+	GLM_FUNC_DECL unsigned int laneMask(tboolx<N> const & m);
+
+	// -- Vectors --
+
+	template <length_t N>
+	GLM_FUNC_DECL tvec3x<N> operator-(tvec3x<N> const & a);
+	template <length_t N>
+	GLM_FUNC_DECL tvec3x<N> operator+(tvec3x<N> const & a, tvec3x<N> const & b);
+	template <length_t N>
+	GLM_FUNC_DECL tvec3x<N> operator-(tvec3x<N> const & a, tvec3x<N> const & b);
+	template <length_t N>
+	GLM_FUNC_DECL tvec3x<N> operator*(tvec3x<N> const & a, tvec3x<N> const & b);
+	template <length_t N>
+	GLM_FUNC_DECL tvec3x<N> operator*(tvec3x<N> const & a, tfloatx<N> const & s);
+	template <length_t N>
+	GLM_FUNC_DECL tvec3x<N> operator*(tfloatx<N> const & s, tvec3x<N> const & a);
+	template <length_t N>
+	GLM_FUNC_DECL tvec3x<N> operator/(tvec3x<N> const & a, tvec3x<N> const & b);
+	template <length_t N>
+	GLM_FUNC_DECL tvec3x<N> operator/(tvec3x<N> const & a, tfloatx<N> const & s);
+
+	template <length_t N>
+	GLM_FUNC_DECL tvec4x<N> operator-(tvec4x<N> const & a);
+	template <length_t N>
+	GLM_FUNC_DECL tvec4x<N> operator+(tvec4x<N> const & a, tvec4x<N> const & b);
+	template <length_t N>
+	GLM_FUNC_DECL tvec4x<N> operator-(tvec4x<N> const & a, tvec4x<N> const & b);
+	template <length_t N>
+	GLM_FUNC_DECL tvec4x<N> operator*(tvec4x<N> const & a, tvec4x<N> const & b);
+	template <length_t N>
+	GLM_FUNC_DECL tvec4x<N> operator*(tvec4x<N> const & a, tfloatx<N> const & s);
+	template <length_t N>
+	GLM_FUNC_DECL tvec4x<N> operator*(tfloatx<N> const & s, tvec4x<N> const & a);
+	template <length_t N>
+	GLM_FUNC_DECL tvec4x<N> operator/(tvec4x<N> const & a, tvec4x<N> const & b);
+	template <length_t N>
+	GLM_FUNC_DECL tvec4x<N> operator/(tvec4x<N> const & a, tfloatx<N> const & s);
+
+	/// From GLM_GTX_vec_packet extension.
+	template <length_t N>
+	GLM_FUNC_DECL tfloatx<N> dot(tvec3x<N> const & a, tvec3x<N> const & b);
+	template <length_t N>
+	GLM_FUNC_DECL tfloatx<N> dot(tvec4x<N> const & a, tvec4x<N> const & b);
+
+	/// From GLM_GTX_vec_packet extension.
+	template <length_t N>
+	GLM_FUNC_DECL tvec3x<N> cross(tvec3x<N> const & a, tvec3x<N> const & b);
+
+	/// From GLM_GTX_vec_packet extension.
+	template <length_t N>
+	GLM_FUNC_DECL tfloatx<N> length(tvec3x<N> const & a);
+	template <length_t N>
+	GLM_FUNC_DECL tfloatx<N> length(tvec4x<N> const & a);
+
+	/// From GLM_GTX_vec_packet extension.
+	template <length_t N>
+	GLM_FUNC_DECL tvec3x<N> normalize(tvec3x<N> const & a);
+	template <length_t N>
+	GLM_FUNC_DECL tvec4x<N> normalize(tvec4x<N> const & a);
+
+	/// Component-wise.
+	/// From GLM_GTX_vec_packet extension.
+	template <length_t N>
+	GLM_FUNC_DECL tvec3x<N> min(tvec3x<N> const & a, tvec3x<N> const & b);
+	template <length_t N>
+	GLM_FUNC_DECL tvec3x<N> max(tvec3x<N> const & a, tvec3x<N> const & b);
+	template <length_t N>
+	GLM_FUNC_DECL tvec4x<N> min(tvec4x<N> const & a, tvec4x<N> const & b);
+	template <length_t N>
+	GLM_FUNC_DECL tvec4x<N> max(tvec4x<N> const & a, tvec4x<N> const & b);
+
+	/// a * b + c, component-wise.
+	/// From GLM_GTX_vec_packet extension.
+	template <length_t N>
+	GLM_FUNC_DECL tvec3x<N> fma(tvec3x<N> const & a, tvec3x<N> const & b, tvec3x<N> const & c);
+	template <length_t N>
+	GLM_FUNC_DECL tvec4x<N> fma(tvec4x<N> const & a, tvec4x<N> const & b, tvec4x<N> const & c);
+
+	/// The vector from a in the lanes where m is true, and from b in the rest.
+	/// From GLM_GTX_vec_packet extension.
+	template <length_t N>
+	GLM_FUNC_DECL tvec3x<N> select(tboolx<N> const & m, tvec3x<N> const & a, tvec3x<N> const & b);
+	template <length_t N>
+	GLM_FUNC_DECL tvec4x<N> select(tboolx<N> const & m, tvec4x<N> const & a, tvec4x<N> const & b);
+
+	/// @}
+}//namespace glm
+
+#include "vec_packet.inl"
@@ -0,0 +1,711 @@
+/// @ref gtx_vec_packet
+/// @file glm/gtx/vec_packet.inl
+
+namespace glm
+{
+	// -- One lane --
+
+#	if !GLM_HAS_DEFAULTED_FUNCTIONS || !defined(GLM_FORCE_NO_CTOR_INIT)
+		GLM_FUNC_QUALIFIER tfloatx<1>::tfloatx()
+#			ifndef GLM_FORCE_NO_CTOR_INIT
+				: data(0.0f)
+#			endif
+		{}
+
+		GLM_FUNC_QUALIFIER tboolx<1>::tboolx()
+#			ifndef GLM_FORCE_NO_CTOR_INIT
+				: data(false)
+#			endif
+		{}
+#	endif
+
+	GLM_FUNC_QUALIFIER tfloatx<1>::tfloatx(float s) : data(s) {}
+	GLM_FUNC_QUALIFIER tfloatx<1> tfloatx<1>::load(float const * p) { return tfloatx<1>(*p); }
+	GLM_FUNC_QUALIFIER void tfloatx<1>::store(float * p) const { *p = data; }
+	GLM_FUNC_QUALIFIER tboolx<1>::tboolx(bool b) : data(b) {}
+
+	GLM_FUNC_QUALIFIER tfloatx<1> operator-(tfloatx<1> const & a) { return tfloatx<1>(-a.data); }
+	GLM_FUNC_QUALIFIER tfloatx<1> operator+(tfloatx<1> const & a, tfloatx<1> const & b) { return tfloatx<1>(a.data + b.data); }
+	GLM_FUNC_QUALIFIER tfloatx<1> operator-(tfloatx<1> const & a, tfloatx<1> const & b) { return tfloatx<1>(a.data - b.data); }
+	GLM_FUNC_QUALIFIER tfloatx<1> operator*(tfloatx<1> const & a, tfloatx<1> const & b) { return tfloatx<1>(a.data * b.data); }
+	GLM_FUNC_QUALIFIER tfloatx<1> operator/(tfloatx<1> const & a, tfloatx<1> const & b) { return tfloatx<1>(a.data / b.data); }
+	GLM_FUNC_QUALIFIER tfloatx<1> fma(tfloatx<1> const & a, tfloatx<1> const & b, tfloatx<1> const & c) { return tfloatx<1>(a.data * b.data + c.data); }
+	GLM_FUNC_QUALIFIER tfloatx<1> min(tfloatx<1> const & a, tfloatx<1> const & b) { return tfloatx<1>(a.data < b.data ? a.data : b.data); }
+	GLM_FUNC_QUALIFIER tfloatx<1> max(tfloatx<1> const & a, tfloatx<1> const & b) { return tfloatx<1>(a.data > b.data ? a.data : b.data); }
+	GLM_FUNC_QUALIFIER tfloatx<1> abs(tfloatx<1> const & a) { return tfloatx<1>(std::abs(a.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<1> sqrt(tfloatx<1> const & a) { return tfloatx<1>(std::sqrt(a.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<1> inversesqrt(tfloatx<1> const & a) { return tfloatx<1>(1.0f / std::sqrt(a.data)); }
+
+	GLM_FUNC_QUALIFIER tboolx<1> lessThan(tfloatx<1> const & a, tfloatx<1> const & b) { return tboolx<1>(a.data < b.data); }
+	GLM_FUNC_QUALIFIER tboolx<1> lessThanEqual(tfloatx<1> const & a, tfloatx<1> const & b) { return tboolx<1>(a.data <= b.data); }
+	GLM_FUNC_QUALIFIER tboolx<1> greaterThan(tfloatx<1> const & a, tfloatx<1> const & b) { return tboolx<1>(a.data > b.data); }
+	GLM_FUNC_QUALIFIER tboolx<1> greaterThanEqual(tfloatx<1> const & a, tfloatx<1> const & b) { return tboolx<1>(a.data >= b.data); }
+	GLM_FUNC_QUALIFIER tboolx<1> equal(tfloatx<1> const & a, tfloatx<1> const & b) { return tboolx<1>(a.data == b.data); }
+	GLM_FUNC_QUALIFIER tboolx<1> notEqual(tfloatx<1> const & a, tfloatx<1> const & b) { return tboolx<1>(a.data != b.data); }
+	GLM_FUNC_QUALIFIER tfloatx<1> select(tboolx<1> const & m, tfloatx<1> const & a, tfloatx<1> const & b) { return m.data ? a : b; }
+
+	GLM_FUNC_QUALIFIER tboolx<1> operator&(tboolx<1> const & a, tboolx<1> const & b) { return tboolx<1>(a.data && b.data); }
+	GLM_FUNC_QUALIFIER tboolx<1> operator|(tboolx<1> const & a, tboolx<1> const & b) { return tboolx<1>(a.data || b.data); }
+	GLM_FUNC_QUALIFIER tboolx<1> not_(tboolx<1> const & m) { return tboolx<1>(!m.data); }
+	GLM_FUNC_QUALIFIER bool any(tboolx<1> const & m) { return m.data; }
+	GLM_FUNC_QUALIFIER bool all(tboolx<1> const & m) { return m.data; }
+	GLM_FUNC_QUALIFIER unsigned int laneMask(tboolx<1> const & m) { return m.data ? 1u : 0u; }
+
+namespace detail
+{
+	// Going between vectors stored one after another and one register per component. p points at 3 floats
+	// per lane, or 4 floats every stride floats.
+	GLM_FUNC_QUALIFIER void load_aos3(float const * p, tfloatx<1> & x, tfloatx<1> & y, tfloatx<1> & z)
+	{
+		x.data = p[0];
+		y.data = p[1];
+		z.data = p[2];
+	}
+
+	GLM_FUNC_QUALIFIER void store_aos3(float * p, tfloatx<1> const & x, tfloatx<1> const & y, tfloatx<1> const & z)
+	{
+		p[0] = x.data;
+		p[1] = y.data;
+		p[2] = z.data;
+	}
+
+	GLM_FUNC_QUALIFIER void load_aos4(float const * p, tfloatx<1> & x, tfloatx<1> & y, tfloatx<1> & z, tfloatx<1> & w, std::size_t)
+	{
+		x.data = p[0];
+		y.data = p[1];
+		z.data = p[2];
+		w.data = p[3];
+	}
+
+	GLM_FUNC_QUALIFIER void store_aos4(float * p, tfloatx<1> const & x, tfloatx<1> const & y, tfloatx<1> const & z, tfloatx<1> const & w, std::size_t)
+	{
+		p[0] = x.data;
+		p[1] = y.data;
+		p[2] = z.data;
+		p[3] = w.data;
+	}
+}//namespace detail
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+	// -- 4 lanes: SSE --
+
+#	if !GLM_HAS_DEFAULTED_FUNCTIONS || !defined(GLM_FORCE_NO_CTOR_INIT)
+		GLM_FUNC_QUALIFIER tfloatx<4>::tfloatx()
+#			ifndef GLM_FORCE_NO_CTOR_INIT
+				: data(_mm_setzero_ps())
+#			endif
+		{}
+
+		GLM_FUNC_QUALIFIER tboolx<4>::tboolx()
+#			ifndef GLM_FORCE_NO_CTOR_INIT
+				: data(_mm_setzero_ps())
+#			endif
+		{}
+#	endif
+
+	GLM_FUNC_QUALIFIER tfloatx<4>::tfloatx(float s) : data(_mm_set1_ps(s)) {}
+	GLM_FUNC_QUALIFIER tfloatx<4>::tfloatx(glm_vec4 v) : data(v) {}
+	GLM_FUNC_QUALIFIER tfloatx<4> tfloatx<4>::load(float const * p) { return tfloatx<4>(_mm_loadu_ps(p)); }
+	GLM_FUNC_QUALIFIER void tfloatx<4>::store(float * p) const { _mm_storeu_ps(p, data); }
+	GLM_FUNC_QUALIFIER tboolx<4>::tboolx(glm_vec4 v) : data(v) {}
+
+	GLM_FUNC_QUALIFIER tfloatx<4> operator-(tfloatx<4> const & a) { return tfloatx<4>(_mm_xor_ps(a.data, _mm_set1_ps(-0.0f))); }
+	GLM_FUNC_QUALIFIER tfloatx<4> operator+(tfloatx<4> const & a, tfloatx<4> const & b) { return tfloatx<4>(_mm_add_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<4> operator-(tfloatx<4> const & a, tfloatx<4> const & b) { return tfloatx<4>(_mm_sub_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<4> operator*(tfloatx<4> const & a, tfloatx<4> const & b) { return tfloatx<4>(_mm_mul_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<4> operator/(tfloatx<4> const & a, tfloatx<4> const & b) { return tfloatx<4>(_mm_div_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<4> min(tfloatx<4> const & a, tfloatx<4> const & b) { return tfloatx<4>(_mm_min_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<4> max(tfloatx<4> const & a, tfloatx<4> const & b) { return tfloatx<4>(_mm_max_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<4> abs(tfloatx<4> const & a) { return tfloatx<4>(_mm_andnot_ps(_mm_set1_ps(-0.0f), a.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<4> sqrt(tfloatx<4> const & a) { return tfloatx<4>(_mm_sqrt_ps(a.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<4> inversesqrt(tfloatx<4> const & a) { return tfloatx<4>(_mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(a.data))); }
+
+	GLM_FUNC_QUALIFIER tfloatx<4> fma(tfloatx<4> const & a, tfloatx<4> const & b, tfloatx<4> const & c)
+	{
+#		if (GLM_ARCH & GLM_ARCH_AVX2_BIT) && (defined(__FMA__) || (GLM_COMPILER & GLM_COMPILER_VC))
+			return tfloatx<4>(_mm_fmadd_ps(a.data, b.data, c.data));
+#		else
+			return tfloatx<4>(_mm_add_ps(_mm_mul_ps(a.data, b.data), c.data));
+#		endif
+	}
+
+	GLM_FUNC_QUALIFIER tboolx<4> lessThan(tfloatx<4> const & a, tfloatx<4> const & b) { return tboolx<4>(_mm_cmplt_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tboolx<4> lessThanEqual(tfloatx<4> const & a, tfloatx<4> const & b) { return tboolx<4>(_mm_cmple_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tboolx<4> greaterThan(tfloatx<4> const & a, tfloatx<4> const & b) { return tboolx<4>(_mm_cmpgt_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tboolx<4> greaterThanEqual(tfloatx<4> const & a, tfloatx<4> const & b) { return tboolx<4>(_mm_cmpge_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tboolx<4> equal(tfloatx<4> const & a, tfloatx<4> const & b) { return tboolx<4>(_mm_cmpeq_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tboolx<4> notEqual(tfloatx<4> const & a, tfloatx<4> const & b) { return tboolx<4>(_mm_cmpneq_ps(a.data, b.data)); }
+
+	GLM_FUNC_QUALIFIER tfloatx<4> select(tboolx<4> const & m, tfloatx<4> const & a, tfloatx<4> const & b)
+	{
+#		if GLM_ARCH & GLM_ARCH_SSE41_BIT
+			return tfloatx<4>(_mm_blendv_ps(b.data, a.data, m.data));
+#		else
+			return tfloatx<4>(_mm_or_ps(_mm_and_ps(m.data, a.data), _mm_andnot_ps(m.data, b.data)));
+#		endif
+	}
+
+	GLM_FUNC_QUALIFIER tboolx<4> operator&(tboolx<4> const & a, tboolx<4> const & b) { return tboolx<4>(_mm_and_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tboolx<4> operator|(tboolx<4> const & a, tboolx<4> const & b) { return tboolx<4>(_mm_or_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tboolx<4> not_(tboolx<4> const & m) { return tboolx<4>(_mm_xor_ps(m.data, _mm_castsi128_ps(_mm_set1_epi32(-1)))); }
+	GLM_FUNC_QUALIFIER bool any(tboolx<4> const & m) { return _mm_movemask_ps(m.data) != 0; }
+	GLM_FUNC_QUALIFIER bool all(tboolx<4> const & m) { return _mm_movemask_ps(m.data) == 0xF; }
+	GLM_FUNC_QUALIFIER unsigned int laneMask(tboolx<4> const & m) { return static_cast<unsigned int>(_mm_movemask_ps(m.data)); }
+
+namespace detail
+{
+	// Three loads of [x0 y0 z0 x1] [y1 z1 x2 y2] [z2 x3 y3 z3], with each component gathered from them in
+	// two shuffles.
+	GLM_FUNC_QUALIFIER void load_aos3(float const * p, tfloatx<4> & x, tfloatx<4> & y, tfloatx<4> & z)
+	{
+		glm_vec4 const a = _mm_loadu_ps(p + 0);
+		glm_vec4 const b = _mm_loadu_ps(p + 4);
+		glm_vec4 const c = _mm_loadu_ps(p + 8);
+
+		glm_vec4 const x01 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 0, 0));
+		glm_vec4 const x23 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+		glm_vec4 const y01 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+		glm_vec4 const y23 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+		glm_vec4 const z01 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+		glm_vec4 const z23 = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0));
+
+		x.data = _mm_shuffle_ps(x01, x23, _MM_SHUFFLE(2, 0, 2, 0));
+		y.data = _mm_shuffle_ps(y01, y23, _MM_SHUFFLE(2, 0, 2, 0));
+		z.data = _mm_shuffle_ps(z01, z23, _MM_SHUFFLE(2, 0, 2, 0));
+	}
+
+	GLM_FUNC_QUALIFIER void store_aos3(float * p, tfloatx<4> const & x, tfloatx<4> const & y, tfloatx<4> const & z)
+	{
+		glm_vec4 const xy0 = _mm_shuffle_ps(x.data, y.data, _MM_SHUFFLE(0, 0, 0, 0));
+		glm_vec4 const zx0 = _mm_shuffle_ps(z.data, x.data, _MM_SHUFFLE(1, 1, 0, 0));
+		glm_vec4 const yz1 = _mm_shuffle_ps(y.data, z.data, _MM_SHUFFLE(1, 1, 1, 1));
+		glm_vec4 const xy2 = _mm_shuffle_ps(x.data, y.data, _MM_SHUFFLE(2, 2, 2, 2));
+		glm_vec4 const zx2 = _mm_shuffle_ps(z.data, x.data, _MM_SHUFFLE(3, 3, 2, 2));
+		glm_vec4 const yz3 = _mm_shuffle_ps(y.data, z.data, _MM_SHUFFLE(3, 3, 3, 3));
+
+		_mm_storeu_ps(p + 0, _mm_shuffle_ps(xy0, zx0, _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(p + 4, _mm_shuffle_ps(yz1, xy2, _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(p + 8, _mm_shuffle_ps(zx2, yz3, _MM_SHUFFLE(2, 0, 2, 0)));
+	}
+
+	GLM_FUNC_QUALIFIER void load_aos4(float const * p, tfloatx<4> & x, tfloatx<4> & y, tfloatx<4> & z, tfloatx<4> & w, std::size_t stride)
+	{
+		x.data = _mm_loadu_ps(p);
+		y.data = _mm_loadu_ps(p + stride);
+		z.data = _mm_loadu_ps(p + stride * 2);
+		w.data = _mm_loadu_ps(p + stride * 3);
+		_MM_TRANSPOSE4_PS(x.data, y.data, z.data, w.data);
+	}
+
+	GLM_FUNC_QUALIFIER void store_aos4(float * p, tfloatx<4> const & x, tfloatx<4> const & y, tfloatx<4> const & z, tfloatx<4> const & w, std::size_t stride)
+	{
+		glm_vec4 v0 = x.data, v1 = y.data, v2 = z.data, v3 = w.data;
+		_MM_TRANSPOSE4_PS(v0, v1, v2, v3);
+		_mm_storeu_ps(p, v0);
+		_mm_storeu_ps(p + stride, v1);
+		_mm_storeu_ps(p + stride * 2, v2);
+		_mm_storeu_ps(p + stride * 3, v3);
+	}
+}//namespace detail
+
+#	if GLM_ARCH & GLM_ARCH_AVX_BIT
+
+	// -- 8 lanes: AVX --
+
+#	if !GLM_HAS_DEFAULTED_FUNCTIONS || !defined(GLM_FORCE_NO_CTOR_INIT)
+		GLM_FUNC_QUALIFIER tfloatx<8>::tfloatx()
+#			ifndef GLM_FORCE_NO_CTOR_INIT
+				: data(_mm256_setzero_ps())
+#			endif
+		{}
+
+		GLM_FUNC_QUALIFIER tboolx<8>::tboolx()
+#			ifndef GLM_FORCE_NO_CTOR_INIT
+				: data(_mm256_setzero_ps())
+#			endif
+		{}
+#	endif
+
+	GLM_FUNC_QUALIFIER tfloatx<8>::tfloatx(float s) : data(_mm256_set1_ps(s)) {}
+	GLM_FUNC_QUALIFIER tfloatx<8>::tfloatx(__m256 v) : data(v) {}
+	GLM_FUNC_QUALIFIER tfloatx<8>::tfloatx(tfloatx<4> const & lo, tfloatx<4> const & hi) : data(_mm256_insertf128_ps(_mm256_castps128_ps256(lo.data), hi.data, 1)) {}
+	GLM_FUNC_QUALIFIER tfloatx<8> tfloatx<8>::load(float const * p) { return tfloatx<8>(_mm256_loadu_ps(p)); }
+	GLM_FUNC_QUALIFIER void tfloatx<8>::store(float * p) const { _mm256_storeu_ps(p, data); }
+	GLM_FUNC_QUALIFIER tboolx<8>::tboolx(__m256 v) : data(v) {}
+
+	GLM_FUNC_QUALIFIER tfloatx<8> operator-(tfloatx<8> const & a) { return tfloatx<8>(_mm256_xor_ps(a.data, _mm256_set1_ps(-0.0f))); }
+	GLM_FUNC_QUALIFIER tfloatx<8> operator+(tfloatx<8> const & a, tfloatx<8> const & b) { return tfloatx<8>(_mm256_add_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<8> operator-(tfloatx<8> const & a, tfloatx<8> const & b) { return tfloatx<8>(_mm256_sub_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<8> operator*(tfloatx<8> const & a, tfloatx<8> const & b) { return tfloatx<8>(_mm256_mul_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<8> operator/(tfloatx<8> const & a, tfloatx<8> const & b) { return tfloatx<8>(_mm256_div_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<8> fma(tfloatx<8> const & a, tfloatx<8> const & b, tfloatx<8> const & c) { return tfloatx<8>(glm_ymm_fma(a.data, b.data, c.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<8> min(tfloatx<8> const & a, tfloatx<8> const & b) { return tfloatx<8>(_mm256_min_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<8> max(tfloatx<8> const & a, tfloatx<8> const & b) { return tfloatx<8>(_mm256_max_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<8> abs(tfloatx<8> const & a) { return tfloatx<8>(_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<8> sqrt(tfloatx<8> const & a) { return tfloatx<8>(_mm256_sqrt_ps(a.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<8> inversesqrt(tfloatx<8> const & a) { return tfloatx<8>(_mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(a.data))); }
+
+	GLM_FUNC_QUALIFIER tboolx<8> lessThan(tfloatx<8> const & a, tfloatx<8> const & b) { return tboolx<8>(_mm256_cmp_ps(a.data, b.data, _CMP_LT_OQ)); }
+	GLM_FUNC_QUALIFIER tboolx<8> lessThanEqual(tfloatx<8> const & a, tfloatx<8> const & b) { return tboolx<8>(_mm256_cmp_ps(a.data, b.data, _CMP_LE_OQ)); }
+	GLM_FUNC_QUALIFIER tboolx<8> greaterThan(tfloatx<8> const & a, tfloatx<8> const & b) { return tboolx<8>(_mm256_cmp_ps(a.data, b.data, _CMP_GT_OQ)); }
+	GLM_FUNC_QUALIFIER tboolx<8> greaterThanEqual(tfloatx<8> const & a, tfloatx<8> const & b) { return tboolx<8>(_mm256_cmp_ps(a.data, b.data, _CMP_GE_OQ)); }
+	GLM_FUNC_QUALIFIER tboolx<8> equal(tfloatx<8> const & a, tfloatx<8> const & b) { return tboolx<8>(_mm256_cmp_ps(a.data, b.data, _CMP_EQ_OQ)); }
+	GLM_FUNC_QUALIFIER tboolx<8> notEqual(tfloatx<8> const & a, tfloatx<8> const & b) { return tboolx<8>(_mm256_cmp_ps(a.data, b.data, _CMP_NEQ_UQ)); }
+	GLM_FUNC_QUALIFIER tfloatx<8> select(tboolx<8> const & m, tfloatx<8> const & a, tfloatx<8> const & b) { return tfloatx<8>(_mm256_blendv_ps(b.data, a.data, m.data)); }
+
+	GLM_FUNC_QUALIFIER tboolx<8> operator&(tboolx<8> const & a, tboolx<8> const & b) { return tboolx<8>(_mm256_and_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tboolx<8> operator|(tboolx<8> const & a, tboolx<8> const & b) { return tboolx<8>(_mm256_or_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tboolx<8> not_(tboolx<8> const & m) { return tboolx<8>(_mm256_xor_ps(m.data, _mm256_castsi256_ps(_mm256_set1_epi32(-1)))); }
+	GLM_FUNC_QUALIFIER bool any(tboolx<8> const & m) { return _mm256_movemask_ps(m.data) != 0; }
+	GLM_FUNC_QUALIFIER bool all(tboolx<8> const & m) { return _mm256_movemask_ps(m.data) == 0xFF; }
+	GLM_FUNC_QUALIFIER unsigned int laneMask(tboolx<8> const & m) { return static_cast<unsigned int>(_mm256_movemask_ps(m.data)); }
+
+namespace detail
+{
+	GLM_FUNC_QUALIFIER tfloatx<4> lower_half(tfloatx<8> const & v) { return tfloatx<4>(_mm256_castps256_ps128(v.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<4> upper_half(tfloatx<8> const & v) { return tfloatx<4>(_mm256_extractf128_ps(v.data, 1)); }
+
+	// The 128-bit transposes do the shuffling, since AVX shuffles can't cross between the two halves.
+	GLM_FUNC_QUALIFIER void load_aos3(float const * p, tfloatx<8> & x, tfloatx<8> & y, tfloatx<8> & z)
+	{
+		tfloatx<4> x0, y0, z0, x1, y1, z1;
+		load_aos3(p, x0, y0, z0);
+		load_aos3(p + 12, x1, y1, z1);
+		x = tfloatx<8>(x0, x1);
+		y = tfloatx<8>(y0, y1);
+		z = tfloatx<8>(z0, z1);
+	}
+
+	GLM_FUNC_QUALIFIER void store_aos3(float * p, tfloatx<8> const & x, tfloatx<8> const & y, tfloatx<8> const & z)
+	{
+		store_aos3(p, lower_half(x), lower_half(y), lower_half(z));
+		store_aos3(p + 12, upper_half(x), upper_half(y), upper_half(z));
+	}
+
+	GLM_FUNC_QUALIFIER void load_aos4(float const * p, tfloatx<8> & x, tfloatx<8> & y, tfloatx<8> & z, tfloatx<8> & w, std::size_t stride)
+	{
+		tfloatx<4> x0, y0, z0, w0, x1, y1, z1, w1;
+		load_aos4(p, x0, y0, z0, w0, stride);
+		load_aos4(p + stride * 4, x1, y1, z1, w1, stride);
+		x = tfloatx<8>(x0, x1);
+		y = tfloatx<8>(y0, y1);
+		z = tfloatx<8>(z0, z1);
+		w = tfloatx<8>(w0, w1);
+	}
+
+	GLM_FUNC_QUALIFIER void store_aos4(float * p, tfloatx<8> const & x, tfloatx<8> const & y, tfloatx<8> const & z, tfloatx<8> const & w, std::size_t stride)
+	{
+		store_aos4(p, lower_half(x), lower_half(y), lower_half(z), lower_half(w), stride);
+		store_aos4(p + stride * 4, upper_half(x), upper_half(y), upper_half(z), upper_half(w), stride);
+	}
+}//namespace detail
+
+#	endif//GLM_ARCH & GLM_ARCH_AVX_BIT
+
+#	if GLM_ARCH & GLM_ARCH_AVX512_BIT
+
+	// -- 16 lanes: AVX-512 --
+
+#	if !GLM_HAS_DEFAULTED_FUNCTIONS || !defined(GLM_FORCE_NO_CTOR_INIT)
+		GLM_FUNC_QUALIFIER tfloatx<16>::tfloatx()
+#			ifndef GLM_FORCE_NO_CTOR_INIT
+				: data(_mm512_setzero_ps())
+#			endif
+		{}
+
+		GLM_FUNC_QUALIFIER tboolx<16>::tboolx()
+#			ifndef GLM_FORCE_NO_CTOR_INIT
+				: data(0)
+#			endif
+		{}
+#	endif
+
+	GLM_FUNC_QUALIFIER tfloatx<16>::tfloatx(float s) : data(_mm512_set1_ps(s)) {}
+	GLM_FUNC_QUALIFIER tfloatx<16>::tfloatx(__m512 v) : data(v) {}
+	GLM_FUNC_QUALIFIER tfloatx<16>::tfloatx(tfloatx<8> const & lo, tfloatx<8> const & hi)
+		: data(_mm512_castpd_ps(_mm512_insertf64x4(_mm512_castpd256_pd512(_mm256_castps_pd(lo.data)), _mm256_castps_pd(hi.data), 1)))
+	{}
+	GLM_FUNC_QUALIFIER tfloatx<16> tfloatx<16>::load(float const * p) { return tfloatx<16>(_mm512_loadu_ps(p)); }
+	GLM_FUNC_QUALIFIER void tfloatx<16>::store(float * p) const { _mm512_storeu_ps(p, data); }
+	GLM_FUNC_QUALIFIER tboolx<16>::tboolx(__mmask16 m) : data(m) {}
+
+	GLM_FUNC_QUALIFIER tfloatx<16> operator-(tfloatx<16> const & a) { return tfloatx<16>(_mm512_sub_ps(_mm512_setzero_ps(), a.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<16> operator+(tfloatx<16> const & a, tfloatx<16> const & b) { return tfloatx<16>(_mm512_add_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<16> operator-(tfloatx<16> const & a, tfloatx<16> const & b) { return tfloatx<16>(_mm512_sub_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<16> operator*(tfloatx<16> const & a, tfloatx<16> const & b) { return tfloatx<16>(_mm512_mul_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<16> operator/(tfloatx<16> const & a, tfloatx<16> const & b) { return tfloatx<16>(_mm512_div_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<16> fma(tfloatx<16> const & a, tfloatx<16> const & b, tfloatx<16> const & c) { return tfloatx<16>(_mm512_fmadd_ps(a.data, b.data, c.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<16> min(tfloatx<16> const & a, tfloatx<16> const & b) { return tfloatx<16>(_mm512_min_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<16> max(tfloatx<16> const & a, tfloatx<16> const & b) { return tfloatx<16>(_mm512_max_ps(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<16> abs(tfloatx<16> const & a) { return tfloatx<16>(_mm512_abs_ps(a.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<16> sqrt(tfloatx<16> const & a) { return tfloatx<16>(_mm512_sqrt_ps(a.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<16> inversesqrt(tfloatx<16> const & a) { return tfloatx<16>(_mm512_div_ps(_mm512_set1_ps(1.0f), _mm512_sqrt_ps(a.data))); }
+
+	GLM_FUNC_QUALIFIER tboolx<16> lessThan(tfloatx<16> const & a, tfloatx<16> const & b) { return tboolx<16>(_mm512_cmp_ps_mask(a.data, b.data, _CMP_LT_OQ)); }
+	GLM_FUNC_QUALIFIER tboolx<16> lessThanEqual(tfloatx<16> const & a, tfloatx<16> const & b) { return tboolx<16>(_mm512_cmp_ps_mask(a.data, b.data, _CMP_LE_OQ)); }
+	GLM_FUNC_QUALIFIER tboolx<16> greaterThan(tfloatx<16> const & a, tfloatx<16> const & b) { return tboolx<16>(_mm512_cmp_ps_mask(a.data, b.data, _CMP_GT_OQ)); }
+	GLM_FUNC_QUALIFIER tboolx<16> greaterThanEqual(tfloatx<16> const & a, tfloatx<16> const & b) { return tboolx<16>(_mm512_cmp_ps_mask(a.data, b.data, _CMP_GE_OQ)); }
+	GLM_FUNC_QUALIFIER tboolx<16> equal(tfloatx<16> const & a, tfloatx<16> const & b) { return tboolx<16>(_mm512_cmp_ps_mask(a.data, b.data, _CMP_EQ_OQ)); }
+	GLM_FUNC_QUALIFIER tboolx<16> notEqual(tfloatx<16> const & a, tfloatx<16> const & b) { return tboolx<16>(_mm512_cmp_ps_mask(a.data, b.data, _CMP_NEQ_UQ)); }
+	GLM_FUNC_QUALIFIER tfloatx<16> select(tboolx<16> const & m, tfloatx<16> const & a, tfloatx<16> const & b) { return tfloatx<16>(_mm512_mask_blend_ps(m.data, b.data, a.data)); }
+
+	GLM_FUNC_QUALIFIER tboolx<16> operator&(tboolx<16> const & a, tboolx<16> const & b) { return tboolx<16>(_mm512_kand(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tboolx<16> operator|(tboolx<16> const & a, tboolx<16> const & b) { return tboolx<16>(_mm512_kor(a.data, b.data)); }
+	GLM_FUNC_QUALIFIER tboolx<16> not_(tboolx<16> const & m) { return tboolx<16>(_mm512_knot(m.data)); }
+	GLM_FUNC_QUALIFIER bool any(tboolx<16> const & m) { return m.data != 0; }
+	GLM_FUNC_QUALIFIER bool all(tboolx<16> const & m) { return m.data == 0xFFFF; }
+	GLM_FUNC_QUALIFIER unsigned int laneMask(tboolx<16> const & m) { return static_cast<unsigned int>(m.data); }
+
+namespace detail
+{
+	GLM_FUNC_QUALIFIER tfloatx<8> lower_half(tfloatx<16> const & v) { return tfloatx<8>(_mm512_castps512_ps256(v.data)); }
+	GLM_FUNC_QUALIFIER tfloatx<8> upper_half(tfloatx<16> const & v) { return tfloatx<8>(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(v.data), 1))); }
+
+	GLM_FUNC_QUALIFIER void load_aos3(float const * p, tfloatx<16> & x, tfloatx<16> & y, tfloatx<16> & z)
+	{
+		tfloatx<8> x0, y0, z0, x1, y1, z1;
+		load_aos3(p, x0, y0, z0);
+		load_aos3(p + 24, x1, y1, z1);
+		x = tfloatx<16>(x0, x1);
+		y = tfloatx<16>(y0, y1);
+		z = tfloatx<16>(z0, z1);
+	}
+
+	GLM_FUNC_QUALIFIER void store_aos3(float * p, tfloatx<16> const & x, tfloatx<16> const & y, tfloatx<16> const & z)
+	{
+		store_aos3(p, lower_half(x), lower_half(y), lower_half(z));
+		store_aos3(p + 24, upper_half(x), upper_half(y), upper_half(z));
+	}
+
+	GLM_FUNC_QUALIFIER void load_aos4(float const * p, tfloatx<16> & x, tfloatx<16> & y, tfloatx<16> & z, tfloatx<16> & w, std::size_t stride)
+	{
+		tfloatx<8> x0, y0, z0, w0, x1, y1, z1, w1;
+		load_aos4(p, x0, y0, z0, w0, stride);
+		load_aos4(p + stride * 8, x1, y1, z1, w1, stride);
+		x = tfloatx<16>(x0, x1);
+		y = tfloatx<16>(y0, y1);
+		z = tfloatx<16>(z0, z1);
+		w = tfloatx<16>(w0, w1);
+	}
+
+	GLM_FUNC_QUALIFIER void store_aos4(float * p, tfloatx<16> const & x, tfloatx<16> const & y, tfloatx<16> const & z, tfloatx<16> const & w, std::size_t stride)
+	{
+		store_aos4(p, lower_half(x), lower_half(y), lower_half(z), lower_half(w), stride);
+		store_aos4(p + stride * 8, upper_half(x), upper_half(y), upper_half(z), upper_half(w), stride);
+	}
+}//namespace detail
+
+#	endif//GLM_ARCH & GLM_ARCH_AVX512_BIT
+#endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+	// -- Any other width: two halves --
+
+#	if !GLM_HAS_DEFAULTED_FUNCTIONS || !defined(GLM_FORCE_NO_CTOR_INIT)
+		template <length_t N>
+		GLM_FUNC_QUALIFIER tfloatx<N>::tfloatx()
+		{}
+
+		template <length_t N>
+		GLM_FUNC_QUALIFIER tboolx<N>::tboolx()
+		{}
+#	endif
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tfloatx<N>::tfloatx(float s) : lo(s), hi(s) {}
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tfloatx<N>::tfloatx(tfloatx<N / 2> const & lo, tfloatx<N / 2> const & hi) : lo(lo), hi(hi) {}
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tfloatx<N> tfloatx<N>::load(float const * p)
+	{
+		return tfloatx<N>(tfloatx<N / 2>::load(p), tfloatx<N / 2>::load(p + N / 2));
+	}
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER void tfloatx<N>::store(float * p) const
+	{
+		lo.store(p);
+		hi.store(p + N / 2);
+	}
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tboolx<N>::tboolx(tboolx<N / 2> const & lo, tboolx<N / 2> const & hi) : lo(lo), hi(hi) {}
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tfloatx<N> operator-(tfloatx<N> const & a) { return tfloatx<N>(-a.lo, -a.hi); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tfloatx<N> operator+(tfloatx<N> const & a, tfloatx<N> const & b) { return tfloatx<N>(a.lo + b.lo, a.hi + b.hi); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tfloatx<N> operator-(tfloatx<N> const & a, tfloatx<N> const & b) { return tfloatx<N>(a.lo - b.lo, a.hi - b.hi); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tfloatx<N> operator*(tfloatx<N> const & a, tfloatx<N> const & b) { return tfloatx<N>(a.lo * b.lo, a.hi * b.hi); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tfloatx<N> operator/(tfloatx<N> const & a, tfloatx<N> const & b) { return tfloatx<N>(a.lo / b.lo, a.hi / b.hi); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tfloatx<N> fma(tfloatx<N> const & a, tfloatx<N> const & b, tfloatx<N> const & c) { return tfloatx<N>(fma(a.lo, b.lo, c.lo), fma(a.hi, b.hi, c.hi)); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tfloatx<N> min(tfloatx<N> const & a, tfloatx<N> const & b) { return tfloatx<N>(min(a.lo, b.lo), min(a.hi, b.hi)); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tfloatx<N> max(tfloatx<N> const & a, tfloatx<N> const & b) { return tfloatx<N>(max(a.lo, b.lo), max(a.hi, b.hi)); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tfloatx<N> abs(tfloatx<N> const & a) { return tfloatx<N>(abs(a.lo), abs(a.hi)); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tfloatx<N> sqrt(tfloatx<N> const & a) { return tfloatx<N>(sqrt(a.lo), sqrt(a.hi)); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tfloatx<N> inversesqrt(tfloatx<N> const & a) { return tfloatx<N>(inversesqrt(a.lo), inversesqrt(a.hi)); }
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tboolx<N> lessThan(tfloatx<N> const & a, tfloatx<N> const & b) { return tboolx<N>(lessThan(a.lo, b.lo), lessThan(a.hi, b.hi)); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tboolx<N> lessThanEqual(tfloatx<N> const & a, tfloatx<N> const & b) { return tboolx<N>(lessThanEqual(a.lo, b.lo), lessThanEqual(a.hi, b.hi)); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tboolx<N> greaterThan(tfloatx<N> const & a, tfloatx<N> const & b) { return tboolx<N>(greaterThan(a.lo, b.lo), greaterThan(a.hi, b.hi)); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tboolx<N> greaterThanEqual(tfloatx<N> const & a, tfloatx<N> const & b) { return tboolx<N>(greaterThanEqual(a.lo, b.lo), greaterThanEqual(a.hi, b.hi)); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tboolx<N> equal(tfloatx<N> const & a, tfloatx<N> const & b) { return tboolx<N>(equal(a.lo, b.lo), equal(a.hi, b.hi)); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tboolx<N> notEqual(tfloatx<N> const & a, tfloatx<N> const & b) { return tboolx<N>(notEqual(a.lo, b.lo), notEqual(a.hi, b.hi)); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tfloatx<N> select(tboolx<N> const & m, tfloatx<N> const & a, tfloatx<N> const & b) { return tfloatx<N>(select(m.lo, a.lo, b.lo), select(m.hi, a.hi, b.hi)); }
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tboolx<N> operator&(tboolx<N> const & a, tboolx<N> const & b) { return tboolx<N>(a.lo & b.lo, a.hi & b.hi); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tboolx<N> operator|(tboolx<N> const & a, tboolx<N> const & b) { return tboolx<N>(a.lo | b.lo, a.hi | b.hi); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tboolx<N> not_(tboolx<N> const & m) { return tboolx<N>(not_(m.lo), not_(m.hi)); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER bool any(tboolx<N> const & m) { return any(m.lo) || any(m.hi); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER bool all(tboolx<N> const & m) { return all(m.lo) && all(m.hi); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER unsigned int laneMask(tboolx<N> const & m) { return laneMask(m.lo) | (laneMask(m.hi) << (N / 2)); }
+
+namespace detail
+{
+	template <length_t N>
+	GLM_FUNC_QUALIFIER void load_aos3(float const * p, tfloatx<N> & x, tfloatx<N> & y, tfloatx<N> & z)
+	{
+		load_aos3(p, x.lo, y.lo, z.lo);
+		load_aos3(p + 3 * (N / 2), x.hi, y.hi, z.hi);
+	}
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER void store_aos3(float * p, tfloatx<N> const & x, tfloatx<N> const & y, tfloatx<N> const & z)
+	{
+		store_aos3(p, x.lo, y.lo, z.lo);
+		store_aos3(p + 3 * (N / 2), x.hi, y.hi, z.hi);
+	}
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER void load_aos4(float const * p, tfloatx<N> & x, tfloatx<N> & y, tfloatx<N> & z, tfloatx<N> & w, std::size_t stride)
+	{
+		load_aos4(p, x.lo, y.lo, z.lo, w.lo, stride);
+		load_aos4(p + stride * (N / 2), x.hi, y.hi, z.hi, w.hi, stride);
+	}
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER void store_aos4(float * p, tfloatx<N> const & x, tfloatx<N> const & y, tfloatx<N> const & z, tfloatx<N> const & w, std::size_t stride)
+	{
+		store_aos4(p, x.lo, y.lo, z.lo, w.lo, stride);
+		store_aos4(p + stride * (N / 2), x.hi, y.hi, z.hi, w.hi, stride);
+	}
+}//namespace detail
+
+	// -- tvec3x --
+
+#	if !GLM_HAS_DEFAULTED_FUNCTIONS || !defined(GLM_FORCE_NO_CTOR_INIT)
+		template <length_t N>
+		GLM_FUNC_QUALIFIER tvec3x<N>::tvec3x()
+		{}
+#	endif
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec3x<N>::tvec3x(tfloatx<N> const & s) : x(s), y(s), z(s) {}
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec3x<N>::tvec3x(tfloatx<N> const & x, tfloatx<N> const & y, tfloatx<N> const & z) : x(x), y(y), z(z) {}
+
+	template <length_t N>
+	template <precision P>
+	GLM_FUNC_QUALIFIER tvec3x<N>::tvec3x(tvec3<float, P> const & v) : x(v.x), y(v.y), z(v.z) {}
+
+	template <length_t N>
+	template <precision P>
+	GLM_FUNC_QUALIFIER tvec3x<N> tvec3x<N>::load(tvec3<float, P> const * In)
+	{
+		tvec3x<N> Result;
+		detail::load_aos3(&In[0][0], Result.x, Result.y, Result.z);
+		return Result;
+	}
+
+	template <length_t N>
+	template <precision P>
+	GLM_FUNC_QUALIFIER void tvec3x<N>::store(tvec3<float, P> * Out) const
+	{
+		detail::store_aos3(&Out[0][0], x, y, z);
+	}
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec3x<N> tvec3x<N>::load(float const * x, float const * y, float const * z)
+	{
+		return tvec3x<N>(tfloatx<N>::load(x), tfloatx<N>::load(y), tfloatx<N>::load(z));
+	}
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER void tvec3x<N>::store(float * x, float * y, float * z) const
+	{
+		this->x.store(x);
+		this->y.store(y);
+		this->z.store(z);
+	}
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec3x<N> operator-(tvec3x<N> const & a) { return tvec3x<N>(-a.x, -a.y, -a.z); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec3x<N> operator+(tvec3x<N> const & a, tvec3x<N> const & b) { return tvec3x<N>(a.x + b.x, a.y + b.y, a.z + b.z); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec3x<N> operator-(tvec3x<N> const & a, tvec3x<N> const & b) { return tvec3x<N>(a.x - b.x, a.y - b.y, a.z - b.z); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec3x<N> operator*(tvec3x<N> const & a, tvec3x<N> const & b) { return tvec3x<N>(a.x * b.x, a.y * b.y, a.z * b.z); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec3x<N> operator*(tvec3x<N> const & a, tfloatx<N> const & s) { return tvec3x<N>(a.x * s, a.y * s, a.z * s); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec3x<N> operator*(tfloatx<N> const & s, tvec3x<N> const & a) { return tvec3x<N>(s * a.x, s * a.y, s * a.z); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec3x<N> operator/(tvec3x<N> const & a, tvec3x<N> const & b) { return tvec3x<N>(a.x / b.x, a.y / b.y, a.z / b.z); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec3x<N> operator/(tvec3x<N> const & a, tfloatx<N> const & s) { return tvec3x<N>(a.x / s, a.y / s, a.z / s); }
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tfloatx<N> dot(tvec3x<N> const & a, tvec3x<N> const & b)
+	{
+		return fma(a.z, b.z, fma(a.y, b.y, a.x * b.x));
+	}
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec3x<N> cross(tvec3x<N> const & a, tvec3x<N> const & b)
+	{
+		return tvec3x<N>(
+			a.y * b.z - b.y * a.z,
+			a.z * b.x - b.z * a.x,
+			a.x * b.y - b.x * a.y);
+	}
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tfloatx<N> length(tvec3x<N> const & a)
+	{
+		return sqrt(dot(a, a));
+	}
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec3x<N> normalize(tvec3x<N> const & a)
+	{
+		return a * inversesqrt(dot(a, a));
+	}
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec3x<N> min(tvec3x<N> const & a, tvec3x<N> const & b) { return tvec3x<N>(min(a.x, b.x), min(a.y, b.y), min(a.z, b.z)); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec3x<N> max(tvec3x<N> const & a, tvec3x<N> const & b) { return tvec3x<N>(max(a.x, b.x), max(a.y, b.y), max(a.z, b.z)); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec3x<N> fma(tvec3x<N> const & a, tvec3x<N> const & b, tvec3x<N> const & c) { return tvec3x<N>(fma(a.x, b.x, c.x), fma(a.y, b.y, c.y), fma(a.z, b.z, c.z)); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec3x<N> select(tboolx<N> const & m, tvec3x<N> const & a, tvec3x<N> const & b) { return tvec3x<N>(select(m, a.x, b.x), select(m, a.y, b.y), select(m, a.z, b.z)); }
+
+	// -- tvec4x --
+
+#	if !GLM_HAS_DEFAULTED_FUNCTIONS || !defined(GLM_FORCE_NO_CTOR_INIT)
+		template <length_t N>
+		GLM_FUNC_QUALIFIER tvec4x<N>::tvec4x()
+		{}
+#	endif
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec4x<N>::tvec4x(tfloatx<N> const & s) : x(s), y(s), z(s), w(s) {}
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec4x<N>::tvec4x(tfloatx<N> const & x, tfloatx<N> const & y, tfloatx<N> const & z, tfloatx<N> const & w) : x(x), y(y), z(z), w(w) {}
+
+	template <length_t N>
+	template <precision P>
+	GLM_FUNC_QUALIFIER tvec4x<N>::tvec4x(tvec4<float, P> const & v) : x(v.x), y(v.y), z(v.z), w(v.w) {}
+
+	template <length_t N>
+	template <precision P>
+	GLM_FUNC_QUALIFIER tvec4x<N> tvec4x<N>::load(tvec4<float, P> const * In)
+	{
+		tvec4x<N> Result;
+		detail::load_aos4(&In[0][0], Result.x, Result.y, Result.z, Result.w, 4);
+		return Result;
+	}
+
+	template <length_t N>
+	template <precision P>
+	GLM_FUNC_QUALIFIER void tvec4x<N>::store(tvec4<float, P> * Out) const
+	{
+		detail::store_aos4(&Out[0][0], x, y, z, w, 4);
+	}
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec4x<N> tvec4x<N>::load(float const * x, float const * y, float const * z, float const * w)
+	{
+		return tvec4x<N>(tfloatx<N>::load(x), tfloatx<N>::load(y), tfloatx<N>::load(z), tfloatx<N>::load(w));
+	}
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER void tvec4x<N>::store(float * x, float * y, float * z, float * w) const
+	{
+		this->x.store(x);
+		this->y.store(y);
+		this->z.store(z);
+		this->w.store(w);
+	}
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec4x<N> operator-(tvec4x<N> const & a) { return tvec4x<N>(-a.x, -a.y, -a.z, -a.w); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec4x<N> operator+(tvec4x<N> const & a, tvec4x<N> const & b) { return tvec4x<N>(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec4x<N> operator-(tvec4x<N> const & a, tvec4x<N> const & b) { return tvec4x<N>(a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec4x<N> operator*(tvec4x<N> const & a, tvec4x<N> const & b) { return tvec4x<N>(a.x * b.x, a.y * b.y, a.z * b.z, a.w * b.w); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec4x<N> operator*(tvec4x<N> const & a, tfloatx<N> const & s) { return tvec4x<N>(a.x * s, a.y * s, a.z * s, a.w * s); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec4x<N> operator*(tfloatx<N> const & s, tvec4x<N> const & a) { return tvec4x<N>(s * a.x, s * a.y, s * a.z, s * a.w); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec4x<N> operator/(tvec4x<N> const & a, tvec4x<N> const & b) { return tvec4x<N>(a.x / b.x, a.y / b.y, a.z / b.z, a.w / b.w); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec4x<N> operator/(tvec4x<N> const & a, tfloatx<N> const & s) { return tvec4x<N>(a.x / s, a.y / s, a.z / s, a.w / s); }
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tfloatx<N> dot(tvec4x<N> const & a, tvec4x<N> const & b)
+	{
+		return fma(a.w, b.w, fma(a.z, b.z, fma(a.y, b.y, a.x * b.x)));
+	}
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tfloatx<N> length(tvec4x<N> const & a)
+	{
+		return sqrt(dot(a, a));
+	}
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec4x<N> normalize(tvec4x<N> const & a)
+	{
+		return a * inversesqrt(dot(a, a));
+	}
+
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec4x<N> min(tvec4x<N> const & a, tvec4x<N> const & b) { return tvec4x<N>(min(a.x, b.x), min(a.y, b.y), min(a.z, b.z), min(a.w, b.w)); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec4x<N> max(tvec4x<N> const & a, tvec4x<N> const & b) { return tvec4x<N>(max(a.x, b.x), max(a.y, b.y), max(a.z, b.z), max(a.w, b.w)); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec4x<N> fma(tvec4x<N> const & a, tvec4x<N> const & b, tvec4x<N> const & c) { return tvec4x<N>(fma(a.x, b.x, c.x), fma(a.y, b.y, c.y), fma(a.z, b.z, c.z), fma(a.w, b.w, c.w)); }
+	template <length_t N>
+	GLM_FUNC_QUALIFIER tvec4x<N> select(tboolx<N> const & m, tvec4x<N> const & a, tvec4x<N> const & b) { return tvec4x<N>(select(m, a.x, b.x), select(m, a.y, b.y), select(m, a.z, b.z), select(m, a.w, b.w)); }
+}//namespace glm
@@ -31,7 +31,7 @@ GLM_FUNC_QUALIFIER void glm_mat4_sub(glm_vec4 const in1[4], glm_vec4 const in2[4
 	out[3] = _mm_sub_ps(in1[3], in2[3]);
 }
 
-GLM_FUNC_QUALIFIER glm_vec4 glm_mat4_mul_vec4(glm_vec4 const m[4], glm_vec4 v)
+GLM_FUNC_QUALIFIER glm_vec4 glm_mat4_mul_vec4_sse2(glm_vec4 const m[4], glm_vec4 v)
 {
 	__m128 v0 = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
 	__m128 v1 = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
@@ -77,7 +77,7 @@ GLM_FUNC_QUALIFIER __m128 glm_vec4_mul_mat4(glm_vec4 v, glm_vec4 const m[4])
 	return f2;
 }
 
-GLM_FUNC_QUALIFIER void glm_mat4_mul(glm_vec4 const in1[4], glm_vec4 const in2[4], glm_vec4 out[4])
+GLM_FUNC_QUALIFIER void glm_mat4_mul_sse2(glm_vec4 const in1[4], glm_vec4 const in2[4], glm_vec4 out[4])
 {
 	{
 		__m128 e0 = _mm_shuffle_ps(in2[0], in2[0], _MM_SHUFFLE(0, 0, 0, 0));
@@ -506,7 +506,7 @@ GLM_FUNC_QUALIFIER glm_vec4 glm_mat4_determinant(glm_vec4 const m[4])
 	return glm_vec4_dot(m[0], DetCof);
 }
 
-GLM_FUNC_QUALIFIER void glm_mat4_inverse(glm_vec4 const in[4], glm_vec4 out[4])
+GLM_FUNC_QUALIFIER void glm_mat4_inverse_sse2(glm_vec4 const in[4], glm_vec4 out[4])
 {
 	__m128 Fac0;
 	{
@@ -1025,4 +1025,617 @@ GLM_FUNC_QUALIFIER void glm_mat4_outerProduct(__m128 const & c, __m128 const & r
 	out[3] = _mm_mul_ps(c, _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3)));
 }
 
+#if GLM_ARCH & GLM_ARCH_AVX_BIT
+
+// AVX2 processors all have FMA, but GCC and Clang only emit it when it's enabled separately (-mfma).
+#if (GLM_ARCH & GLM_ARCH_AVX2_BIT) && (defined(__FMA__) || (GLM_COMPILER & GLM_COMPILER_VC))
+#	define GLM_SIMD_FMA 1
+#else
+#	define GLM_SIMD_FMA 0
+#endif
+
+// a * b + c
+GLM_FUNC_QUALIFIER __m256 glm_ymm_fma(__m256 a, __m256 b, __m256 c)
+{
+#	if GLM_SIMD_FMA
+		return _mm256_fmadd_ps(a, b, c);
+#	else
+		return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#	endif
+}
+
+#undef GLM_SIMD_FMA
+
+// The same vec4 in both 128-bit lanes
+GLM_FUNC_QUALIFIER __m256 glm_ymm_dup(glm_vec4 v)
+{
+	return _mm256_insertf128_ps(_mm256_castps128_ps256(v), v, 1);
+}
+
+GLM_FUNC_QUALIFIER glm_vec4 glm_mat4_mul_vec4_avx(glm_vec4 const m[4], glm_vec4 v)
+{
+	// Two columns per register: lane 0 holds column 0 (or 2) scaled by v.x (or v.z), lane 1 column 1 (or 3)
+	// scaled by v.y (or v.w). The two lanes are summed at the end.
+	__m256 const m01 = _mm256_loadu_ps(reinterpret_cast<float const*>(&m[0]));
+	__m256 const m23 = _mm256_loadu_ps(reinterpret_cast<float const*>(&m[2]));
+
+	__m256 const vv = glm_ymm_dup(v);
+	__m256 const v01 = _mm256_permutevar_ps(vv, _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1));
+	__m256 const v23 = _mm256_permutevar_ps(vv, _mm256_setr_epi32(2, 2, 2, 2, 3, 3, 3, 3));
+
+	__m256 const sum = glm_ymm_fma(m23, v23, _mm256_mul_ps(m01, v01));
+	return _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+}
+
+GLM_FUNC_QUALIFIER void glm_mat4_mul_avx(glm_vec4 const in1[4], glm_vec4 const in2[4], glm_vec4 out[4])
+{
+	// Two columns of the result at once: each lane of b holds a column of in2, while the columns of in1
+	// are repeated in both lanes. In-lane shuffles then splat the right element of each in2 column.
+	__m256 const a0 = glm_ymm_dup(in1[0]);
+	__m256 const a1 = glm_ymm_dup(in1[1]);
+	__m256 const a2 = glm_ymm_dup(in1[2]);
+	__m256 const a3 = glm_ymm_dup(in1[3]);
+
+	__m256 const b01 = _mm256_loadu_ps(reinterpret_cast<float const*>(&in2[0]));
+	__m256 const b23 = _mm256_loadu_ps(reinterpret_cast<float const*>(&in2[2]));
+
+	__m256 r01 = _mm256_mul_ps(a0, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(0, 0, 0, 0)));
+	__m256 r23 = _mm256_mul_ps(a0, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(0, 0, 0, 0)));
+	r01 = glm_ymm_fma(a1, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(1, 1, 1, 1)), r01);
+	r23 = glm_ymm_fma(a1, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(1, 1, 1, 1)), r23);
+	r01 = glm_ymm_fma(a2, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(2, 2, 2, 2)), r01);
+	r23 = glm_ymm_fma(a2, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(2, 2, 2, 2)), r23);
+	r01 = glm_ymm_fma(a3, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(3, 3, 3, 3)), r01);
+	r23 = glm_ymm_fma(a3, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(3, 3, 3, 3)), r23);
+
+	_mm256_storeu_ps(reinterpret_cast<float*>(&out[0]), r01);
+	_mm256_storeu_ps(reinterpret_cast<float*>(&out[2]), r23);
+}
+
+#endif//GLM_ARCH & GLM_ARCH_AVX_BIT
+
+#if GLM_ARCH & GLM_ARCH_AVX512_BIT
+
+GLM_FUNC_QUALIFIER glm_vec4 glm_mat4_mul_vec4_avx512(glm_vec4 const m[4], glm_vec4 v)
+{
+	// The whole matrix in one register, each column scaled by its element of v, then the four lanes summed.
+	__m512 const mm = _mm512_loadu_ps(reinterpret_cast<float const*>(&m[0]));
+	__m512 const vv = _mm512_permutexvar_ps(_mm512_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3), _mm512_castps128_ps512(v));
+
+	__m512 const mul = _mm512_mul_ps(mm, vv);
+	__m256 const sum = _mm256_add_ps(_mm512_castps512_ps256(mul), _mm512_extractf32x8_ps(mul, 1));
+	return _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+}
+
+GLM_FUNC_QUALIFIER void glm_mat4_mul_avx512(glm_vec4 const in1[4], glm_vec4 const in2[4], glm_vec4 out[4])
+{
+	// All four columns of the result at once, with every column of in2 in its own lane.
+	__m512 const b = _mm512_loadu_ps(reinterpret_cast<float const*>(&in2[0]));
+
+	__m512 r = _mm512_mul_ps(_mm512_broadcast_f32x4(in1[0]), _mm512_permute_ps(b, _MM_SHUFFLE(0, 0, 0, 0)));
+	r = _mm512_fmadd_ps(_mm512_broadcast_f32x4(in1[1]), _mm512_permute_ps(b, _MM_SHUFFLE(1, 1, 1, 1)), r);
+	r = _mm512_fmadd_ps(_mm512_broadcast_f32x4(in1[2]), _mm512_permute_ps(b, _MM_SHUFFLE(2, 2, 2, 2)), r);
+	r = _mm512_fmadd_ps(_mm512_broadcast_f32x4(in1[3]), _mm512_permute_ps(b, _MM_SHUFFLE(3, 3, 3, 3)), r);
+
+	_mm512_storeu_ps(reinterpret_cast<float*>(&out[0]), r);
+}
+
+GLM_FUNC_QUALIFIER void glm_mat4_inverse_avx512(glm_vec4 const in[4], glm_vec4 out[4])
+{
+	// Same cofactor expansion as glm_mat4_inverse_sse2, computing all four columns in one register. With
+	// the whole matrix in a register, every swizzle is a single cross-lane permute of it; the indices
+	// below are column * 4 + row.
+	__m512 const m = _mm512_loadu_ps(reinterpret_cast<float const*>(&in[0]));
+
+	// Fac0 | Fac1 | Fac2 | Fac3
+	__m512 const FacA = _mm512_fmsub_ps(
+		_mm512_permutexvar_ps(_mm512_setr_epi32(10, 10, 6, 6, 9, 9, 5, 5, 9, 9, 5, 5, 8, 8, 4, 4), m),
+		_mm512_permutexvar_ps(_mm512_setr_epi32(15, 15, 15, 11, 15, 15, 15, 11, 14, 14, 14, 10, 15, 15, 15, 11), m),
+		_mm512_mul_ps(
+			_mm512_permutexvar_ps(_mm512_setr_epi32(14, 14, 14, 10, 13, 13, 13, 9, 13, 13, 13, 9, 12, 12, 12, 8), m),
+			_mm512_permutexvar_ps(_mm512_setr_epi32(11, 11, 7, 7, 11, 11, 7, 7, 10, 10, 6, 6, 11, 11, 7, 7), m)));
+
+	// Fac4 | Fac5 | Fac4 | Fac5
+	__m512 const FacB = _mm512_fmsub_ps(
+		_mm512_permutexvar_ps(_mm512_setr_epi32(8, 8, 4, 4, 8, 8, 4, 4, 8, 8, 4, 4, 8, 8, 4, 4), m),
+		_mm512_permutexvar_ps(_mm512_setr_epi32(14, 14, 14, 10, 13, 13, 13, 9, 14, 14, 14, 10, 13, 13, 13, 9), m),
+		_mm512_mul_ps(
+			_mm512_permutexvar_ps(_mm512_setr_epi32(12, 12, 12, 8, 12, 12, 12, 8, 12, 12, 12, 8, 12, 12, 12, 8), m),
+			_mm512_permutexvar_ps(_mm512_setr_epi32(10, 10, 6, 6, 9, 9, 5, 5, 10, 10, 6, 6, 9, 9, 5, 5), m)));
+
+	// Fac0 | Fac0 | Fac1 | Fac2, Fac1 | Fac3 | Fac3 | Fac4 and Fac2 | Fac4 | Fac5 | Fac5
+	__m512 const FacX = _mm512_permutex2var_ps(FacA, _mm512_setr_epi32(0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11), FacB);
+	__m512 const FacY = _mm512_permutex2var_ps(FacA, _mm512_setr_epi32(4, 5, 6, 7, 12, 13, 14, 15, 12, 13, 14, 15, 16, 17, 18, 19), FacB);
+	__m512 const FacZ = _mm512_permutex2var_ps(FacA, _mm512_setr_epi32(8, 9, 10, 11, 16, 17, 18, 19, 20, 21, 22, 23, 20, 21, 22, 23), FacB);
+
+	// Vec1 | Vec0 | Vec0 | Vec0, Vec2 | Vec2 | Vec1 | Vec1 and Vec3 | Vec3 | Vec3 | Vec2,
+	// where Vec[k] = (m[1][k], m[0][k], m[0][k], m[0][k])
+	__m512 const VecX = _mm512_permutexvar_ps(_mm512_setr_epi32(5, 1, 1, 1, 4, 0, 0, 0, 4, 0, 0, 0, 4, 0, 0, 0), m);
+	__m512 const VecY = _mm512_permutexvar_ps(_mm512_setr_epi32(6, 2, 2, 2, 6, 2, 2, 2, 5, 1, 1, 1, 5, 1, 1, 1), m);
+	__m512 const VecZ = _mm512_permutexvar_ps(_mm512_setr_epi32(7, 3, 3, 3, 7, 3, 3, 3, 7, 3, 3, 3, 6, 2, 2, 2), m);
+
+	// SignB, SignA, SignB, SignA
+	__m512 const Sign = _mm512_setr_ps(
+		 1.0f,-1.0f, 1.0f,-1.0f,
+		-1.0f, 1.0f,-1.0f, 1.0f,
+		 1.0f,-1.0f, 1.0f,-1.0f,
+		-1.0f, 1.0f,-1.0f, 1.0f);
+
+	__m512 Inv = _mm512_fnmadd_ps(VecY, FacY, _mm512_mul_ps(VecX, FacX));
+	Inv = _mm512_mul_ps(Sign, _mm512_fmadd_ps(VecZ, FacZ, Inv));
+
+	// (Inverse[0][0], Inverse[1][0], Inverse[2][0], Inverse[3][0])
+	__m128 const Row2 = _mm512_castps512_ps128(_mm512_permutexvar_ps(_mm512_setr_epi32(0, 4, 8, 12, 0, 4, 8, 12, 0, 4, 8, 12, 0, 4, 8, 12), Inv));
+
+	__m128 const Det0 = glm_vec4_dot(in[0], Row2);
+	__m512 const Rcp0 = _mm512_broadcast_f32x4(_mm_div_ps(_mm_set1_ps(1.0f), Det0));
+
+	_mm512_storeu_ps(reinterpret_cast<float*>(&out[0]), _mm512_mul_ps(Inv, Rcp0));
+}
+
+#endif//GLM_ARCH & GLM_ARCH_AVX512_BIT
+
+// The variants below are picked at compile time, from the widest this build allows that measured faster.
+GLM_FUNC_QUALIFIER glm_vec4 glm_mat4_mul_vec4(glm_vec4 const m[4], glm_vec4 v)
+{
+	// Summing the four lanes of the 512-bit product costs more than the wider multiply saves.
+#	if GLM_ARCH & GLM_ARCH_AVX_BIT
+		return glm_mat4_mul_vec4_avx(m, v);
+#	else
+		return glm_mat4_mul_vec4_sse2(m, v);
+#	endif
+}
+
+GLM_FUNC_QUALIFIER void glm_mat4_mul(glm_vec4 const in1[4], glm_vec4 const in2[4], glm_vec4 out[4])
+{
+#	if GLM_ARCH & GLM_ARCH_AVX512_BIT
+		glm_mat4_mul_avx512(in1, in2, out);
+#	elif GLM_ARCH & GLM_ARCH_AVX_BIT
+		glm_mat4_mul_avx(in1, in2, out);
+#	else
+		glm_mat4_mul_sse2(in1, in2, out);
+#	endif
+}
+
+GLM_FUNC_QUALIFIER void glm_mat4_inverse(glm_vec4 const in[4], glm_vec4 out[4])
+{
+	// The inverse is mostly shuffles, and AVX shuffles can't cross 128-bit lanes, so splitting it over
+	// 256-bit registers needs more of them than the SSE version does. Only a 512-bit permute is enough
+	// to gather each operand in one go.
+#	if GLM_ARCH & GLM_ARCH_AVX512_BIT
+		glm_mat4_inverse_avx512(in, out);
+#	else
+		glm_mat4_inverse_sse2(in, out);
+#	endif
+}
+
+// How far ahead of the current element the array kernels below prefetch, in bytes. Far enough to hide a
+// trip to memory at the rate these loops go through data, and close enough not to evict what's in use.
+#define GLM_SIMD_PREFETCH_DISTANCE 512
+
+GLM_FUNC_QUALIFIER void glm_prefetch(void const * p)
+{
+	_mm_prefetch(static_cast<char const *>(p) + GLM_SIMD_PREFETCH_DISTANCE, _MM_HINT_T0);
+}
+
+#undef GLM_SIMD_PREFETCH_DISTANCE
+
+// How many of count vec4s to handle one at a time so that in + i * 4 lands on an Alignment boundary. Arrays
+// that aren't even 16-byte aligned never get there, so they're left alone.
+GLM_FUNC_QUALIFIER std::size_t glm_align_head(float const * in, std::size_t count, std::size_t Alignment)
+{
+	std::size_t const Address = reinterpret_cast<std::size_t>(in);
+	if(Address & 15)
+		return 0;
+	std::size_t const Head = ((Alignment - (Address & (Alignment - 1))) & (Alignment - 1)) / 16;
+	return Head < count ? Head : count;
+}
+
+// out[i] = m * in[i] for count vec4s stored as 4 floats each. The arrays only need float alignment, and
+// in and out can be the same array.
+GLM_FUNC_QUALIFIER void glm_mat4_mul_vec4_array(glm_vec4 const m[4], float const * in, float * out, std::size_t count)
+{
+	std::size_t i = 0;
+
+#	if GLM_ARCH & GLM_ARCH_AVX512_BIT
+	{
+		// Four vec4s per register, with every lane multiplied by the same matrix.
+		__m512 const c0 = _mm512_broadcast_f32x4(m[0]);
+		__m512 const c1 = _mm512_broadcast_f32x4(m[1]);
+		__m512 const c2 = _mm512_broadcast_f32x4(m[2]);
+		__m512 const c3 = _mm512_broadcast_f32x4(m[3]);
+
+		for(std::size_t const Head = glm_align_head(in, count, 64); i < Head; ++i)
+			_mm_storeu_ps(out + i * 4, glm_mat4_mul_vec4(m, _mm_loadu_ps(in + i * 4)));
+
+		bool const Aligned = (reinterpret_cast<std::size_t>(in + i * 4) & 63) == 0;
+		for(; i + 4 <= count; i += 4)
+		{
+			glm_prefetch(in + i * 4);
+			__m512 const v = Aligned ? _mm512_load_ps(in + i * 4) : _mm512_loadu_ps(in + i * 4);
+			__m512 r = _mm512_mul_ps(c0, _mm512_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0)));
+			r = _mm512_fmadd_ps(c1, _mm512_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1)), r);
+			r = _mm512_fmadd_ps(c2, _mm512_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2)), r);
+			r = _mm512_fmadd_ps(c3, _mm512_permute_ps(v, _MM_SHUFFLE(3, 3, 3, 3)), r);
+			_mm512_storeu_ps(out + i * 4, r);
+		}
+	}
+#	elif GLM_ARCH & GLM_ARCH_AVX_BIT
+	{
+		// Two vec4s per register, two registers per loop so each loop covers a cache line.
+		__m256 const c0 = glm_ymm_dup(m[0]);
+		__m256 const c1 = glm_ymm_dup(m[1]);
+		__m256 const c2 = glm_ymm_dup(m[2]);
+		__m256 const c3 = glm_ymm_dup(m[3]);
+
+		for(std::size_t const Head = glm_align_head(in, count, 32); i < Head; ++i)
+			_mm_storeu_ps(out + i * 4, glm_mat4_mul_vec4(m, _mm_loadu_ps(in + i * 4)));
+
+		bool const Aligned = (reinterpret_cast<std::size_t>(in + i * 4) & 31) == 0;
+		for(; i + 4 <= count; i += 4)
+		{
+			glm_prefetch(in + i * 4);
+			__m256 const v0 = Aligned ? _mm256_load_ps(in + i * 4) : _mm256_loadu_ps(in + i * 4);
+			__m256 const v1 = Aligned ? _mm256_load_ps(in + i * 4 + 8) : _mm256_loadu_ps(in + i * 4 + 8);
+			__m256 r0 = _mm256_mul_ps(c0, _mm256_shuffle_ps(v0, v0, _MM_SHUFFLE(0, 0, 0, 0)));
+			__m256 r1 = _mm256_mul_ps(c0, _mm256_shuffle_ps(v1, v1, _MM_SHUFFLE(0, 0, 0, 0)));
+			r0 = glm_ymm_fma(c1, _mm256_shuffle_ps(v0, v0, _MM_SHUFFLE(1, 1, 1, 1)), r0);
+			r1 = glm_ymm_fma(c1, _mm256_shuffle_ps(v1, v1, _MM_SHUFFLE(1, 1, 1, 1)), r1);
+			r0 = glm_ymm_fma(c2, _mm256_shuffle_ps(v0, v0, _MM_SHUFFLE(2, 2, 2, 2)), r0);
+			r1 = glm_ymm_fma(c2, _mm256_shuffle_ps(v1, v1, _MM_SHUFFLE(2, 2, 2, 2)), r1);
+			r0 = glm_ymm_fma(c3, _mm256_shuffle_ps(v0, v0, _MM_SHUFFLE(3, 3, 3, 3)), r0);
+			r1 = glm_ymm_fma(c3, _mm256_shuffle_ps(v1, v1, _MM_SHUFFLE(3, 3, 3, 3)), r1);
+			_mm256_storeu_ps(out + i * 4, r0);
+			_mm256_storeu_ps(out + i * 4 + 8, r1);
+		}
+	}
+#	else
+	{
+		bool const Aligned = (reinterpret_cast<std::size_t>(in) & 15) == 0;
+		for(; i + 4 <= count; i += 4)
+		{
+			glm_prefetch(in + i * 4);
+			for(std::size_t j = 0; j < 4; ++j)
+			{
+				float const * v = in + (i + j) * 4;
+				_mm_storeu_ps(out + (i + j) * 4, glm_mat4_mul_vec4_sse2(m, Aligned ? _mm_load_ps(v) : _mm_loadu_ps(v)));
+			}
+		}
+	}
+#	endif
+
+	for(; i < count; ++i)
+		_mm_storeu_ps(out + i * 4, glm_mat4_mul_vec4(m, _mm_loadu_ps(in + i * 4)));
+}
+
+// out[i] = in1[i] * in2[i] for count column-major mat4s stored as 16 floats each. The arrays only need
+// float alignment, and out can be either input.
+GLM_FUNC_QUALIFIER void glm_mat4_mul_array(float const * in1, float const * in2, float * out, std::size_t count)
+{
+	// Every matrix is a whole number of wide registers, so if the first one is aligned they all are.
+#	if GLM_ARCH & GLM_ARCH_AVX512_BIT
+		bool const Aligned = (reinterpret_cast<std::size_t>(in2) & 63) == 0;
+#	elif GLM_ARCH & GLM_ARCH_AVX_BIT
+		bool const Aligned = (reinterpret_cast<std::size_t>(in2) & 31) == 0;
+#	endif
+
+	for(std::size_t i = 0; i < count; ++i)
+	{
+		float const * a = in1 + i * 16;
+		float const * b = in2 + i * 16;
+		glm_prefetch(a);
+		glm_prefetch(b);
+
+#		if GLM_ARCH & GLM_ARCH_AVX512_BIT
+			__m512 const b0123 = Aligned ? _mm512_load_ps(b) : _mm512_loadu_ps(b);
+			__m512 r = _mm512_mul_ps(_mm512_broadcast_f32x4(_mm_loadu_ps(a + 0)), _mm512_permute_ps(b0123, _MM_SHUFFLE(0, 0, 0, 0)));
+			r = _mm512_fmadd_ps(_mm512_broadcast_f32x4(_mm_loadu_ps(a + 4)), _mm512_permute_ps(b0123, _MM_SHUFFLE(1, 1, 1, 1)), r);
+			r = _mm512_fmadd_ps(_mm512_broadcast_f32x4(_mm_loadu_ps(a + 8)), _mm512_permute_ps(b0123, _MM_SHUFFLE(2, 2, 2, 2)), r);
+			r = _mm512_fmadd_ps(_mm512_broadcast_f32x4(_mm_loadu_ps(a + 12)), _mm512_permute_ps(b0123, _MM_SHUFFLE(3, 3, 3, 3)), r);
+			_mm512_storeu_ps(out + i * 16, r);
+#		elif GLM_ARCH & GLM_ARCH_AVX_BIT
+			__m256 const a0 = _mm256_broadcast_ps(reinterpret_cast<__m128 const *>(a + 0));
+			__m256 const a1 = _mm256_broadcast_ps(reinterpret_cast<__m128 const *>(a + 4));
+			__m256 const a2 = _mm256_broadcast_ps(reinterpret_cast<__m128 const *>(a + 8));
+			__m256 const a3 = _mm256_broadcast_ps(reinterpret_cast<__m128 const *>(a + 12));
+			__m256 const b01 = Aligned ? _mm256_load_ps(b) : _mm256_loadu_ps(b);
+			__m256 const b23 = Aligned ? _mm256_load_ps(b + 8) : _mm256_loadu_ps(b + 8);
+			__m256 r01 = _mm256_mul_ps(a0, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(0, 0, 0, 0)));
+			__m256 r23 = _mm256_mul_ps(a0, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(0, 0, 0, 0)));
+			r01 = glm_ymm_fma(a1, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(1, 1, 1, 1)), r01);
+			r23 = glm_ymm_fma(a1, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(1, 1, 1, 1)), r23);
+			r01 = glm_ymm_fma(a2, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(2, 2, 2, 2)), r01);
+			r23 = glm_ymm_fma(a2, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(2, 2, 2, 2)), r23);
+			r01 = glm_ymm_fma(a3, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(3, 3, 3, 3)), r01);
+			r23 = glm_ymm_fma(a3, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(3, 3, 3, 3)), r23);
+			_mm256_storeu_ps(out + i * 16, r01);
+			_mm256_storeu_ps(out + i * 16 + 8, r23);
+#		else
+			glm_vec4 A[4], B[4], C[4];
+			for(int k = 0; k < 4; ++k)
+			{
+				A[k] = _mm_loadu_ps(a + k * 4);
+				B[k] = _mm_loadu_ps(b + k * 4);
+			}
+			glm_mat4_mul_sse2(A, B, C);
+			for(int k = 0; k < 4; ++k)
+				_mm_storeu_ps(out + i * 16 + k * 4, C[k]);
+#		endif
+	}
+}
+
+// The inverse transpose of the upper 3x3, which is what normals are transformed by. Its columns are the
+// cross products of each pair of the input's columns over the determinant, and come out with w = 0.
+GLM_FUNC_QUALIFIER void glm_mat4_normal_sse2(glm_vec4 const in[4], glm_vec4 out[3])
+{
+	glm_vec4 const bc = glm_vec4_cross(in[1], in[2]);
+	glm_vec4 const ca = glm_vec4_cross(in[2], in[0]);
+	glm_vec4 const ab = glm_vec4_cross(in[0], in[1]);
+	glm_vec4 const rcp = _mm_div_ps(_mm_set1_ps(1.0f), glm_vec4_dot(in[0], bc));
+	out[0] = _mm_mul_ps(bc, rcp);
+	out[1] = _mm_mul_ps(ca, rcp);
+	out[2] = _mm_mul_ps(ab, rcp);
+}
+
+// The inverse of a matrix whose last row is (0, 0, 0, 1), which is all that's left of the last row
+// whatever it was. The upper 3x3 is the transpose of the normal matrix, and the translation is minus
+// that applied to the original translation.
+GLM_FUNC_QUALIFIER void glm_mat4_affine_inverse_sse2(glm_vec4 const in[4], glm_vec4 out[4])
+{
+	glm_vec4 n[3];
+	glm_mat4_normal_sse2(in, n);
+
+	glm_vec4 const t0 = _mm_unpacklo_ps(n[0], n[1]);
+	glm_vec4 const t1 = _mm_unpacklo_ps(n[2], _mm_setzero_ps());
+	glm_vec4 const t2 = _mm_unpackhi_ps(n[0], n[1]);
+	glm_vec4 const t3 = _mm_unpackhi_ps(n[2], _mm_setzero_ps());
+	glm_vec4 const c0 = _mm_movelh_ps(t0, t1);
+	glm_vec4 const c1 = _mm_movehl_ps(t1, t0);
+	glm_vec4 const c2 = _mm_movelh_ps(t2, t3);
+
+	glm_vec4 const t = in[3];
+	glm_vec4 r = _mm_mul_ps(c0, _mm_shuffle_ps(t, t, _MM_SHUFFLE(0, 0, 0, 0)));
+	r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1))));
+	r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 2, 2, 2))));
+
+	out[0] = c0;
+	out[1] = c1;
+	out[2] = c2;
+	out[3] = _mm_sub_ps(_mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f), r);
+}
+
+// The wide versions below work on several matrices at once, one per 128-bit lane, so the SSE2 kernels
+// above carry over with in-lane shuffles. Columns are gathered from each matrix by transposing 128-bit
+// blocks on the way in and out.
+
+#if GLM_ARCH & GLM_ARCH_AVX_BIT
+
+GLM_FUNC_QUALIFIER __m256 glm_ymm_cross(__m256 v1, __m256 v2)
+{
+	__m256 const mul0 = _mm256_mul_ps(_mm256_permute_ps(v1, _MM_SHUFFLE(3, 0, 2, 1)), _mm256_permute_ps(v2, _MM_SHUFFLE(3, 1, 0, 2)));
+	__m256 const mul1 = _mm256_mul_ps(_mm256_permute_ps(v1, _MM_SHUFFLE(3, 1, 0, 2)), _mm256_permute_ps(v2, _MM_SHUFFLE(3, 0, 2, 1)));
+	return _mm256_sub_ps(mul0, mul1);
+}
+
+// c[i] is column i of two matrices
+GLM_FUNC_QUALIFIER void glm_mat4_normal_x2_avx(__m256 const c[3], __m256 out[3])
+{
+	__m256 const bc = glm_ymm_cross(c[1], c[2]);
+	__m256 const ca = glm_ymm_cross(c[2], c[0]);
+	__m256 const ab = glm_ymm_cross(c[0], c[1]);
+	__m256 const rcp = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_dp_ps(c[0], bc, 0xff));
+	out[0] = _mm256_mul_ps(bc, rcp);
+	out[1] = _mm256_mul_ps(ca, rcp);
+	out[2] = _mm256_mul_ps(ab, rcp);
+}
+
+GLM_FUNC_QUALIFIER void glm_mat4_affine_inverse_x2_avx(__m256 const c[4], __m256 out[4])
+{
+	__m256 n[3];
+	glm_mat4_normal_x2_avx(c, n);
+
+	__m256 const zero = _mm256_setzero_ps();
+	__m256 const t0 = _mm256_unpacklo_ps(n[0], n[1]);
+	__m256 const t1 = _mm256_unpacklo_ps(n[2], zero);
+	__m256 const t2 = _mm256_unpackhi_ps(n[0], n[1]);
+	__m256 const t3 = _mm256_unpackhi_ps(n[2], zero);
+	out[0] = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+	out[1] = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+	out[2] = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+
+	__m256 const t = c[3];
+	__m256 r = _mm256_mul_ps(out[0], _mm256_permute_ps(t, _MM_SHUFFLE(0, 0, 0, 0)));
+	r = glm_ymm_fma(out[1], _mm256_permute_ps(t, _MM_SHUFFLE(1, 1, 1, 1)), r);
+	r = glm_ymm_fma(out[2], _mm256_permute_ps(t, _MM_SHUFFLE(2, 2, 2, 2)), r);
+	out[3] = _mm256_sub_ps(_mm256_set_ps(1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f), r);
+}
+
+#endif//GLM_ARCH & GLM_ARCH_AVX_BIT
+
+#if GLM_ARCH & GLM_ARCH_AVX512_BIT
+
+GLM_FUNC_QUALIFIER __m512 glm_zmm_cross(__m512 v1, __m512 v2)
+{
+	__m512 const mul1 = _mm512_mul_ps(_mm512_permute_ps(v1, _MM_SHUFFLE(3, 1, 0, 2)), _mm512_permute_ps(v2, _MM_SHUFFLE(3, 0, 2, 1)));
+	return _mm512_fmsub_ps(_mm512_permute_ps(v1, _MM_SHUFFLE(3, 0, 2, 1)), _mm512_permute_ps(v2, _MM_SHUFFLE(3, 1, 0, 2)), mul1);
+}
+
+// Swaps 128-bit blocks so that block j of out[i] is block i of in[j]: four matrices become four
+// registers of columns, and back again.
+GLM_FUNC_QUALIFIER void glm_zmm_transpose_blocks(__m512 const in[4], __m512 out[4])
+{
+	__m512 const t0 = _mm512_shuffle_f32x4(in[0], in[1], _MM_SHUFFLE(1, 0, 1, 0));
+	__m512 const t1 = _mm512_shuffle_f32x4(in[0], in[1], _MM_SHUFFLE(3, 2, 3, 2));
+	__m512 const t2 = _mm512_shuffle_f32x4(in[2], in[3], _MM_SHUFFLE(1, 0, 1, 0));
+	__m512 const t3 = _mm512_shuffle_f32x4(in[2], in[3], _MM_SHUFFLE(3, 2, 3, 2));
+	out[0] = _mm512_shuffle_f32x4(t0, t2, _MM_SHUFFLE(2, 0, 2, 0));
+	out[1] = _mm512_shuffle_f32x4(t0, t2, _MM_SHUFFLE(3, 1, 3, 1));
+	out[2] = _mm512_shuffle_f32x4(t1, t3, _MM_SHUFFLE(2, 0, 2, 0));
+	out[3] = _mm512_shuffle_f32x4(t1, t3, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+// c[i] is column i of four matrices
+GLM_FUNC_QUALIFIER void glm_mat4_normal_x4_avx512(__m512 const c[3], __m512 out[3])
+{
+	__m512 const bc = glm_zmm_cross(c[1], c[2]);
+	__m512 const ca = glm_zmm_cross(c[2], c[0]);
+	__m512 const ab = glm_zmm_cross(c[0], c[1]);
+
+	// There's no 512-bit dp, so the determinant is summed within each block by hand.
+	__m512 det = _mm512_mul_ps(c[0], bc);
+	det = _mm512_add_ps(det, _mm512_permute_ps(det, _MM_SHUFFLE(2, 3, 0, 1)));
+	det = _mm512_add_ps(det, _mm512_permute_ps(det, _MM_SHUFFLE(1, 0, 3, 2)));
+
+	__m512 const rcp = _mm512_div_ps(_mm512_set1_ps(1.0f), det);
+	out[0] = _mm512_mul_ps(bc, rcp);
+	out[1] = _mm512_mul_ps(ca, rcp);
+	out[2] = _mm512_mul_ps(ab, rcp);
+}
+
+GLM_FUNC_QUALIFIER void glm_mat4_affine_inverse_x4_avx512(__m512 const c[4], __m512 out[4])
+{
+	__m512 n[3];
+	glm_mat4_normal_x4_avx512(c, n);
+
+	__m512 const zero = _mm512_setzero_ps();
+	__m512 const t0 = _mm512_unpacklo_ps(n[0], n[1]);
+	__m512 const t1 = _mm512_unpacklo_ps(n[2], zero);
+	__m512 const t2 = _mm512_unpackhi_ps(n[0], n[1]);
+	__m512 const t3 = _mm512_unpackhi_ps(n[2], zero);
+	out[0] = _mm512_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+	out[1] = _mm512_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+	out[2] = _mm512_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+
+	__m512 const t = c[3];
+	__m512 r = _mm512_mul_ps(out[0], _mm512_permute_ps(t, _MM_SHUFFLE(0, 0, 0, 0)));
+	r = _mm512_fmadd_ps(out[1], _mm512_permute_ps(t, _MM_SHUFFLE(1, 1, 1, 1)), r);
+	r = _mm512_fmadd_ps(out[2], _mm512_permute_ps(t, _MM_SHUFFLE(2, 2, 2, 2)), r);
+	out[3] = _mm512_sub_ps(_mm512_broadcast_f32x4(_mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f)), r);
+}
+
+#endif//GLM_ARCH & GLM_ARCH_AVX512_BIT
+
+// out[i] = affine inverse of in[i] for count mat4s stored as 16 floats each. The arrays only need float
+// alignment, and in and out can be the same array.
+GLM_FUNC_QUALIFIER void glm_mat4_affine_inverse_array(float const * in, float * out, std::size_t count)
+{
+	std::size_t i = 0;
+
+#	if GLM_ARCH & GLM_ARCH_AVX512_BIT
+		for(; i + 4 <= count; i += 4)
+		{
+			float const * m = in + i * 16;
+			glm_prefetch(m);
+			glm_prefetch(m + 32);
+
+			__m512 const Matrices[4] = {_mm512_loadu_ps(m), _mm512_loadu_ps(m + 16), _mm512_loadu_ps(m + 32), _mm512_loadu_ps(m + 48)};
+			__m512 Columns[4], Inverse[4], Result[4];
+			glm_zmm_transpose_blocks(Matrices, Columns);
+			glm_mat4_affine_inverse_x4_avx512(Columns, Inverse);
+			glm_zmm_transpose_blocks(Inverse, Result);
+
+			for(std::size_t k = 0; k < 4; ++k)
+				_mm512_storeu_ps(out + (i + k) * 16, Result[k]);
+		}
+#	elif GLM_ARCH & GLM_ARCH_AVX_BIT
+		for(; i + 2 <= count; i += 2)
+		{
+			float const * m = in + i * 16;
+			glm_prefetch(m);
+
+			__m256 const a01 = _mm256_loadu_ps(m);
+			__m256 const a23 = _mm256_loadu_ps(m + 8);
+			__m256 const b01 = _mm256_loadu_ps(m + 16);
+			__m256 const b23 = _mm256_loadu_ps(m + 24);
+			__m256 const Columns[4] = {
+				_mm256_permute2f128_ps(a01, b01, 0x20),
+				_mm256_permute2f128_ps(a01, b01, 0x31),
+				_mm256_permute2f128_ps(a23, b23, 0x20),
+				_mm256_permute2f128_ps(a23, b23, 0x31)};
+
+			__m256 Inverse[4];
+			glm_mat4_affine_inverse_x2_avx(Columns, Inverse);
+
+			_mm256_storeu_ps(out + i * 16, _mm256_permute2f128_ps(Inverse[0], Inverse[1], 0x20));
+			_mm256_storeu_ps(out + i * 16 + 8, _mm256_permute2f128_ps(Inverse[2], Inverse[3], 0x20));
+			_mm256_storeu_ps(out + i * 16 + 16, _mm256_permute2f128_ps(Inverse[0], Inverse[1], 0x31));
+			_mm256_storeu_ps(out + i * 16 + 24, _mm256_permute2f128_ps(Inverse[2], Inverse[3], 0x31));
+		}
+#	endif
+
+	for(; i < count; ++i)
+	{
+		float const * m = in + i * 16;
+		glm_prefetch(m);
+
+		glm_vec4 const Matrix[4] = {_mm_loadu_ps(m), _mm_loadu_ps(m + 4), _mm_loadu_ps(m + 8), _mm_loadu_ps(m + 12)};
+		glm_vec4 Inverse[4];
+		glm_mat4_affine_inverse_sse2(Matrix, Inverse);
+		for(std::size_t k = 0; k < 4; ++k)
+			_mm_storeu_ps(out + i * 16 + k * 4, Inverse[k]);
+	}
+}
+
+// out[i] = inverse transpose of the upper 3x3 of in[i], for count mat4s stored as 16 floats each. Each
+// result is three columns of 4 floats with w = 0 (a mat3x4, laid out like a std140 mat3). The arrays
+// only need float alignment, and can't overlap.
+GLM_FUNC_QUALIFIER void glm_mat4_normal_array(float const * in, float * out, std::size_t count)
+{
+	std::size_t i = 0;
+
+#	if GLM_ARCH & GLM_ARCH_AVX512_BIT
+		for(; i + 4 <= count; i += 4)
+		{
+			float const * m = in + i * 16;
+			glm_prefetch(m);
+			glm_prefetch(m + 32);
+
+			__m512 const Matrices[4] = {_mm512_loadu_ps(m), _mm512_loadu_ps(m + 16), _mm512_loadu_ps(m + 32), _mm512_loadu_ps(m + 48)};
+			__m512 Columns[4], Normal[4], Result[4];
+			glm_zmm_transpose_blocks(Matrices, Columns);
+			glm_mat4_normal_x4_avx512(Columns, Normal);
+			Normal[3] = _mm512_setzero_ps();
+			glm_zmm_transpose_blocks(Normal, Result);
+
+			// Only the first three blocks of each are a result.
+			for(std::size_t k = 0; k < 4; ++k)
+				_mm512_mask_storeu_ps(out + (i + k) * 12, 0x0FFF, Result[k]);
+		}
+#	elif GLM_ARCH & GLM_ARCH_AVX_BIT
+		for(; i + 2 <= count; i += 2)
+		{
+			float const * m = in + i * 16;
+			glm_prefetch(m);
+
+			__m256 const a01 = _mm256_loadu_ps(m);
+			__m256 const a2 = _mm256_castps128_ps256(_mm_loadu_ps(m + 8));
+			__m256 const b01 = _mm256_loadu_ps(m + 16);
+			__m256 const Columns[3] = {
+				_mm256_permute2f128_ps(a01, b01, 0x20),
+				_mm256_permute2f128_ps(a01, b01, 0x31),
+				_mm256_insertf128_ps(a2, _mm_loadu_ps(m + 24), 1)};
+
+			__m256 Normal[3];
+			glm_mat4_normal_x2_avx(Columns, Normal);
+
+			_mm256_storeu_ps(out + i * 12, _mm256_permute2f128_ps(Normal[0], Normal[1], 0x20));
+			_mm_storeu_ps(out + i * 12 + 8, _mm256_castps256_ps128(Normal[2]));
+			_mm256_storeu_ps(out + i * 12 + 12, _mm256_permute2f128_ps(Normal[0], Normal[1], 0x31));
+			_mm_storeu_ps(out + i * 12 + 20, _mm256_extractf128_ps(Normal[2], 1));
+		}
+#	endif
+
+	for(; i < count; ++i)
+	{
+		float const * m = in + i * 16;
+		glm_prefetch(m);
+
+		glm_vec4 const Matrix[4] = {_mm_loadu_ps(m), _mm_loadu_ps(m + 4), _mm_loadu_ps(m + 8), _mm_loadu_ps(m + 12)};
+		glm_vec4 Normal[3];
+		glm_mat4_normal_sse2(Matrix, Normal);
+		for(std::size_t k = 0; k < 3; ++k)
+			_mm_storeu_ps(out + i * 12 + k * 4, Normal[k]);
+	}
+}
+
 #endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
@@ -0,0 +1,242 @@
+#include <glm/glm.hpp>
+#include <glm/simd/matrix.h>
+#include <glm/gtc/epsilon.hpp>
+#include <cstdio>
+#include <ctime>
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+// Every variant in glm/simd/matrix.h that this build can run is checked against the pure implementation
+// on the default (packed) types, which never takes a SIMD path. The products only use small integers and
+// halves, so they're exact whatever order the kernels add things up in.
+
+namespace
+{
+	void load(glm::mat4 const & m, glm_vec4 out[4])
+	{
+		for(glm::length_t i = 0; i < 4; ++i)
+			out[i] = _mm_loadu_ps(&m[i][0]);
+	}
+
+	glm::mat4 store(glm_vec4 const in[4])
+	{
+		glm::mat4 m;
+		for(glm::length_t i = 0; i < 4; ++i)
+			_mm_storeu_ps(&m[i][0], in[i]);
+		return m;
+	}
+
+	glm::vec4 store(glm_vec4 const & in)
+	{
+		glm::vec4 v;
+		_mm_storeu_ps(&v[0], in);
+		return v;
+	}
+
+	typedef void (*mat4_mul_func)(glm_vec4 const in1[4], glm_vec4 const in2[4], glm_vec4 out[4]);
+	typedef glm_vec4 (*mat4_mul_vec4_func)(glm_vec4 const m[4], glm_vec4 v);
+	typedef void (*mat4_inverse_func)(glm_vec4 const in[4], glm_vec4 out[4]);
+}//namespace
+
+namespace mul_
+{
+	int test(mat4_mul_func Func, char const * Name)
+	{
+		int Error = 0;
+
+		glm::mat4 const P(
+			2.f, 0.f, 1.f, 0.f,
+			-1.f, 3.f, 0.f, 1.f,
+			0.f, 1.f, 1.f, -2.f,
+			4.f, 0.f, 0.5f, 1.f);
+		glm::mat4 const Q(
+			1.f, -1.f, 0.f, 2.f,
+			0.f, 2.f, 1.f, 0.f,
+			3.f, 0.f, -0.5f, 1.f,
+			1.f, 1.f, 0.f, 1.f);
+
+		{
+			glm_vec4 A[4], B[4], C[4];
+			load(P, A);
+			load(Q, B);
+			Func(A, B, C);
+			Error += store(C) == P * Q ? 0 : 1;
+		}
+
+		{
+			glm_vec4 A[4], B[4], C[4];
+			load(Q, A);
+			load(P, B);
+			Func(A, B, C);
+			Error += store(C) == Q * P ? 0 : 1;
+		}
+
+		{
+			glm_vec4 A[4], B[4], C[4];
+			load(P, A);
+			load(glm::mat4(1), B);
+			Func(A, B, C);
+			Error += store(C) == P ? 0 : 1;
+		}
+
+		if(Error)
+			std::printf("glm_mat4_mul_%s failed\n", Name);
+		return Error;
+	}
+}//namespace mul_
+
+namespace mul_vec4
+{
+	int test(mat4_mul_vec4_func Func, char const * Name)
+	{
+		int Error = 0;
+
+		glm::mat4 const m(
+			1.f, 2.f, 3.f, 4.f,
+			-1.f, 0.5f, 2.f, 0.f,
+			0.f, 3.f, -2.f, 1.f,
+			5.f, -4.f, 1.f, 2.f);
+
+		glm_vec4 A[4];
+		load(m, A);
+		for(int i = 0; i < 8; ++i)
+		{
+			glm::vec4 const v(static_cast<float>(i) - 3.0f, 0.5f, -2.0f, 1.0f);
+			glm::vec4 const Result = store(Func(A, _mm_loadu_ps(&v[0])));
+			Error += glm::all(glm::equal(Result, m * v)) ? 0 : 1;
+		}
+
+		if(Error)
+			std::printf("glm_mat4_mul_vec4_%s failed\n", Name);
+		return Error;
+	}
+}//namespace mul_vec4
+
+namespace inverse_
+{
+	int test(mat4_inverse_func Func, char const * Name)
+	{
+		int Error = 0;
+
+		// An affine transform, then one with a projective bottom row so the whole inverse gets exercised.
+		glm::mat4 const Affine(
+			0.f, 2.f, 0.f, 0.f,
+			-1.f, 0.f, 0.f, 0.f,
+			0.f, 0.f, 4.f, 0.f,
+			3.f, -2.f, 1.f, 1.f);
+		glm::mat4 const Projective(
+			2.f, 1.f, 0.f, 0.25f,
+			0.f, 3.f, 1.f, 0.f,
+			1.f, 0.f, 2.f, -0.5f,
+			0.f, 1.f, 1.f, 1.f);
+
+		{
+			glm_vec4 A[4], B[4];
+			load(Affine, A);
+			Func(A, B);
+
+			glm::mat4 const Inverse = store(B);
+			glm::mat4 const Expected = glm::inverse(Affine);
+			glm::mat4 const Identity = Inverse * Affine;
+			for(glm::length_t i = 0; i < 4; ++i)
+			{
+				Error += glm::all(glm::epsilonEqual(Inverse[i], Expected[i], 0.0001f)) ? 0 : 1;
+				Error += glm::all(glm::epsilonEqual(Identity[i], glm::mat4(1)[i], 0.0001f)) ? 0 : 1;
+			}
+		}
+
+		{
+			glm_vec4 A[4], B[4];
+			load(Projective, A);
+			Func(A, B);
+
+			glm::mat4 const Inverse = store(B);
+			glm::mat4 const Expected = glm::inverse(Projective);
+			glm::mat4 const Identity = Inverse * Projective;
+			for(glm::length_t i = 0; i < 4; ++i)
+			{
+				Error += glm::all(glm::epsilonEqual(Inverse[i], Expected[i], 0.0001f)) ? 0 : 1;
+				Error += glm::all(glm::epsilonEqual(Identity[i], glm::mat4(1)[i], 0.0001f)) ? 0 : 1;
+			}
+		}
+
+		if(Error)
+			std::printf("glm_mat4_inverse_%s failed\n", Name);
+		return Error;
+	}
+}//namespace inverse_
+
+namespace perf
+{
+	int test(mat4_mul_func Func, char const * Name, std::size_t Samples)
+	{
+		glm::mat4 const Transform(
+			1.f, 0.f, 0.f, 0.f,
+			0.f, 0.5f, 0.f, 0.f,
+			0.f, 0.f, 2.f, 0.f,
+			1.f, 2.f, 3.f, 1.f);
+		glm_vec4 A[4], B[4], C[4];
+		load(Transform, A);
+		load(glm::mat4(1), B);
+		glm_vec4 Sum = _mm_setzero_ps();
+
+		std::clock_t const StartTime = std::clock();
+		for(std::size_t i = 0; i < Samples; ++i)
+		{
+			Func(A, B, C);
+			B[3] = _mm_add_ps(B[3], _mm_set1_ps(0.001f));
+			Sum = _mm_add_ps(Sum, C[3]);
+		}
+		std::clock_t const EndTime = std::clock();
+
+		std::printf("glm_mat4_mul_%s: %d clocks (%f)\n", Name, static_cast<int>(EndTime - StartTime), store(Sum).x);
+		return 0;
+	}
+}//namespace perf
+
+int main()
+{
+	int Error = 0;
+
+	Error += mul_::test(glm_mat4_mul_sse2, "sse2");
+	Error += mul_vec4::test(glm_mat4_mul_vec4_sse2, "sse2");
+	Error += inverse_::test(glm_mat4_inverse_sse2, "sse2");
+
+#	if GLM_ARCH & GLM_ARCH_AVX_BIT
+		Error += mul_::test(glm_mat4_mul_avx, "avx");
+		Error += mul_vec4::test(glm_mat4_mul_vec4_avx, "avx");
+#	endif
+
+#	if GLM_ARCH & GLM_ARCH_AVX512_BIT
+		Error += mul_::test(glm_mat4_mul_avx512, "avx512");
+		Error += mul_vec4::test(glm_mat4_mul_vec4_avx512, "avx512");
+		Error += inverse_::test(glm_mat4_inverse_avx512, "avx512");
+#	endif
+
+	// Whichever variant the build picked
+	Error += mul_::test(glm_mat4_mul, "default");
+	Error += mul_vec4::test(glm_mat4_mul_vec4, "default");
+	Error += inverse_::test(glm_mat4_inverse, "default");
+
+#	ifdef NDEBUG
+		std::size_t const Samples = 10000000;
+		Error += perf::test(glm_mat4_mul_sse2, "sse2", Samples);
+#		if GLM_ARCH & GLM_ARCH_AVX_BIT
+			Error += perf::test(glm_mat4_mul_avx, "avx", Samples);
+#		endif
+#		if GLM_ARCH & GLM_ARCH_AVX512_BIT
+			Error += perf::test(glm_mat4_mul_avx512, "avx512", Samples);
+#		endif
+#	endif//NDEBUG
+
+	return Error;
+}
+
+#else
+
+int main()
+{
+	return 0;
+}
+
+#endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
@@ -1,5 +1,8 @@
 #include <glm/gtc/matrix_inverse.hpp>
 #include <glm/gtc/epsilon.hpp>
+#include <cstdio>
+#include <ctime>
+#include <vector>
 
 int test_affine()
 {
@@ -41,11 +44,157 @@ int test_affine()
 	return Error;
 }
 
+int test_affine_array()
+{
+	int Error = 0;
+
+	// A quarter turn with a non-uniform scale and a translation, and a 3-4-5 rotation with junk in its
+	// bottom row that the affine functions have to ignore.
+	glm::mat4 const Affine(
+		0.f, 2.f, 0.f, 0.f,
+		-0.5f, 0.f, 0.f, 0.f,
+		0.f, 0.f, 4.f, 0.f,
+		3.f, -1.f, 2.f, 1.f);
+	glm::mat4 const Junk(
+		0.6f, 0.8f, 0.f, 0.25f,
+		-0.8f, 0.6f, 0.f, 7.f,
+		0.f, 0.f, 1.f, -1.f,
+		1.f, 2.f, 3.f, 5.f);
+
+	// Every count up to a few wide loops, from every float offset, and in place
+	std::vector<glm::mat4> Storage(20);
+	for(std::size_t Offset = 0; Offset < 16; Offset += 5)
+	for(std::size_t Count = 0; Count <= 18; ++Count)
+	{
+		glm::mat4 * In = reinterpret_cast<glm::mat4 *>(&Storage[0][0][0] + Offset);
+		for(std::size_t i = 0; i < Count; ++i)
+		{
+			In[i] = i % 2 ? Junk : Affine;
+			In[i][3] += glm::vec4(static_cast<float>(i), 0.f, -static_cast<float>(i), 0.f);
+		}
+
+		std::vector<glm::mat4> Out(Count + 1, glm::mat4(42.0f));
+		glm::affineInverse(In, &Out[0], Count);
+		for(std::size_t i = 0; i < Count; ++i)
+		{
+			glm::mat4 const Expected = glm::affineInverse(In[i]);
+			glm::mat4 const Identity = Out[i] * In[i];
+			for(glm::length_t j = 0; j < 4; ++j)
+			{
+				Error += glm::all(glm::epsilonEqual(Out[i][j], Expected[j], 0.0001f)) ? 0 : 1;
+				if(i % 2 == 0)
+					Error += glm::all(glm::epsilonEqual(Identity[j], glm::mat4(1)[j], 0.0001f)) ? 0 : 1;
+			}
+		}
+		Error += Out[Count] == glm::mat4(42.0f) ? 0 : 1;
+
+		glm::affineInverse(In, In, Count);
+		for(std::size_t i = 0; i < Count; ++i)
+			Error += In[i] == Out[i] ? 0 : 1;
+	}
+
+	glm::dmat4 const Scale(
+		4.0, 0.0, 0.0, 0.0,
+		0.0, 0.5, 0.0, 0.0,
+		0.0, 0.0, 2.0, 0.0,
+		-1.0, 8.0, 0.25, 1.0);
+	std::vector<glm::dmat4> In(5, Scale), Out(5);
+	for(std::size_t i = 0; i < In.size(); ++i)
+		In[i][static_cast<glm::length_t>(i % 3)][static_cast<glm::length_t>(i % 3)] *= static_cast<double>(i + 1);
+	glm::affineInverse(&In[0], &Out[0], In.size());
+	for(std::size_t i = 0; i < In.size(); ++i)
+		Error += Out[i] == glm::affineInverse(In[i]) ? 0 : 1;
+
+	return Error;
+}
+
+int test_inverseTranspose_array()
+{
+	int Error = 0;
+
+	// A shear, so the inverse transpose differs from the matrix itself
+	glm::mat4 const Shear(
+		1.f, 0.f, 0.f, 0.f,
+		0.5f, 2.f, 0.f, 0.f,
+		-1.f, 0.f, 0.25f, 0.f,
+		4.f, 4.f, 4.f, 1.f);
+
+	std::vector<glm::mat4> Storage(20);
+	for(std::size_t Offset = 0; Offset < 16; Offset += 5)
+	for(std::size_t Count = 0; Count <= 18; ++Count)
+	{
+		glm::mat4 * In = reinterpret_cast<glm::mat4 *>(&Storage[0][0][0] + Offset);
+		for(std::size_t i = 0; i < Count; ++i)
+		{
+			In[i] = Shear;
+			In[i][0][0] += static_cast<float>(i);
+		}
+
+		std::vector<glm::mat3x4> Out(Count + 1, glm::mat3x4(42.0f));
+		glm::inverseTranspose(In, &Out[0], Count);
+		for(std::size_t i = 0; i < Count; ++i)
+		{
+			glm::mat3 const Expected = glm::inverseTranspose(glm::mat3(In[i]));
+			for(glm::length_t j = 0; j < 3; ++j)
+				Error += glm::all(glm::epsilonEqual(Out[i][j], glm::vec4(Expected[j], 0.0f), 0.0001f)) ? 0 : 1;
+		}
+		for(glm::length_t j = 0; j < 3; ++j)
+			Error += glm::all(glm::equal(Out[Count][j], glm::mat3x4(42.0f)[j])) ? 0 : 1;
+	}
+
+	glm::dmat4 const Rotation(
+		0.0, 0.0, 1.0, 0.0,
+		0.0, 1.0, 0.0, 0.0,
+		-1.0, 0.0, 0.0, 0.0,
+		2.0, 0.0, 0.0, 1.0);
+	std::vector<glm::dmat4> In(5, Rotation);
+	std::vector<glm::dmat3x4> Out(5);
+	for(std::size_t i = 0; i < In.size(); ++i)
+		In[i][1][1] = static_cast<double>(i + 1);
+	glm::inverseTranspose(&In[0], &Out[0], In.size());
+	for(std::size_t i = 0; i < In.size(); ++i)
+		Error += glm::dmat3(Out[i]) == glm::inverseTranspose(glm::dmat3(In[i])) ? 0 : 1;
+
+	return Error;
+}
+
+int perf_affine_array(std::size_t Count, std::size_t Passes)
+{
+	glm::mat4 const Transform(
+		0.f, 0.f, -3.f, 0.f,
+		1.5f, 0.f, 0.f, 0.f,
+		0.f, 0.5f, 0.f, 0.f,
+		10.f, 20.f, 30.f, 1.f);
+	std::vector<glm::mat4> In(Count, Transform), Out(Count);
+	for(std::size_t i = 0; i < Count; ++i)
+		In[i][3].x = static_cast<float>(i);
+
+	std::clock_t const InverseStart = std::clock();
+	for(std::size_t p = 0; p < Passes; ++p)
+	for(std::size_t i = 0; i < Count; ++i)
+		Out[i] = glm::inverse(In[i]);
+	std::clock_t const InverseEnd = std::clock();
+
+	std::clock_t const AffineStart = std::clock();
+	for(std::size_t p = 0; p < Passes; ++p)
+		glm::affineInverse(&In[0], &Out[0], Count);
+	std::clock_t const AffineEnd = std::clock();
+
+	std::printf("inverse: %d clocks, batched affineInverse: %d clocks (%f)\n", static_cast<int>(InverseEnd - InverseStart), static_cast<int>(AffineEnd - AffineStart), Out[Count / 2][3].x);
+	return 0;
+}
+
 int main()
 {
 	int Error = 0;
 
 	Error += test_affine();
+	Error += test_affine_array();
+	Error += test_inverseTranspose_array();
+
+#	ifdef NDEBUG
+		Error += perf_affine_array(4096, 500);
+#	endif
 
 	return Error;
 }
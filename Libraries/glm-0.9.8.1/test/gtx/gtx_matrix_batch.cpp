@@ -0,0 +1,215 @@
+#include <glm/gtx/matrix_batch.hpp>
+#include <cstdio>
+#include <ctime>
+#include <vector>
+
+// The inputs are all small integers and halves, so every product and sum is exact in float. The batched
+// kernels can then be compared exactly with the scalar operators, whatever order they add things up in.
+
+namespace mul_vec4
+{
+	// Every count up to a few wide loops, starting at every float offset within a cache line, so the
+	// aligned, peeled and tail parts of each kernel all get used.
+	int test()
+	{
+		int Error = 0;
+
+		glm::mat4 const m(
+			1.f, 2.f, 3.f, 4.f,
+			-1.f, 0.5f, 2.f, 0.f,
+			0.f, 3.f, -2.f, 1.f,
+			5.f, -4.f, 1.f, 2.f);
+		std::vector<glm::vec4> Storage(64 + 16);
+		for(std::size_t Offset = 0; Offset < 16; ++Offset)
+		for(std::size_t Count = 0; Count <= 64; Count += (Count < 20 ? 1 : 11))
+		{
+			// Shifting by a float at a time means most of these aren't even vec4-aligned.
+			glm::vec4 * In = reinterpret_cast<glm::vec4 *>(&Storage[0][0] + Offset);
+			for(std::size_t i = 0; i < Count; ++i)
+				In[i] = glm::vec4(static_cast<float>(i), static_cast<float>(i % 5) - 2.f, 1.f, -0.5f * static_cast<float>(i));
+
+			std::vector<glm::vec4> Out(Count + 1, glm::vec4(42.0f));
+			glm::batchMul(m, In, &Out[0], Count);
+			for(std::size_t i = 0; i < Count; ++i)
+				Error += glm::all(glm::equal(Out[i], m * In[i])) ? 0 : 1;
+			Error += glm::all(glm::equal(Out[Count], glm::vec4(42.0f))) ? 0 : 1;
+
+			// In place
+			glm::batchMul(m, In, In, Count);
+			for(std::size_t i = 0; i < Count; ++i)
+				Error += glm::all(glm::equal(In[i], Out[i])) ? 0 : 1;
+		}
+
+		return Error;
+	}
+
+	int test_dvec4()
+	{
+		int Error = 0;
+
+		glm::dmat4 const m(
+			0.5, 0.0, -1.0, 2.0,
+			3.0, 1.0, 0.0, 0.0,
+			-2.0, 4.0, 1.5, 1.0,
+			0.0, 1.0, 2.0, 1.0);
+		std::vector<glm::dvec4> In, Out(9);
+		for(std::size_t i = 0; i < 9; ++i)
+			In.push_back(glm::dvec4(static_cast<double>(i), 2.0 - static_cast<double>(i), 0.25 * static_cast<double>(i), 1.0));
+
+		glm::batchMul(m, &In[0], &Out[0], In.size());
+		for(std::size_t i = 0; i < In.size(); ++i)
+			Error += glm::all(glm::equal(Out[i], m * In[i])) ? 0 : 1;
+
+		return Error;
+	}
+}//namespace mul_vec4
+
+namespace mul_
+{
+	int test()
+	{
+		int Error = 0;
+
+		glm::mat4 const P(
+			2.f, 0.f, 1.f, 0.f,
+			-1.f, 3.f, 0.f, 1.f,
+			0.f, 1.f, 1.f, -2.f,
+			4.f, 0.f, 0.5f, 1.f);
+		glm::mat4 const Q(
+			1.f, -1.f, 0.f, 2.f,
+			0.f, 2.f, 1.f, 0.f,
+			3.f, 0.f, -0.5f, 1.f,
+			1.f, 1.f, 0.f, 1.f);
+
+		std::vector<glm::mat4> Storage(2 * 33 + 1);
+		std::vector<glm::mat4> OriginalB(33);
+		for(std::size_t Offset = 0; Offset < 16; Offset += 3)
+		for(std::size_t Count = 0; Count <= 33; Count += (Count < 9 ? 1 : 8))
+		{
+			glm::mat4 * A = reinterpret_cast<glm::mat4 *>(&Storage[0][0][0] + Offset);
+			glm::mat4 * B = A + Count;
+			for(std::size_t i = 0; i < Count; ++i)
+			{
+				A[i] = P + glm::mat4(static_cast<float>(i % 7));
+				B[i] = OriginalB[i] = Q * static_cast<float>(1 + i % 4);
+			}
+
+			std::vector<glm::mat4> Out(Count + 1, glm::mat4(42.0f));
+			glm::batchMul(A, B, &Out[0], Count);
+			for(std::size_t i = 0; i < Count; ++i)
+				Error += Out[i] == A[i] * B[i] ? 0 : 1;
+			Error += Out[Count] == glm::mat4(42.0f) ? 0 : 1;
+
+			// In place, over either operand
+			glm::batchMul(A, B, B, Count);
+			for(std::size_t i = 0; i < Count; ++i)
+				Error += B[i] == Out[i] ? 0 : 1;
+			for(std::size_t i = 0; i < Count; ++i)
+				B[i] = OriginalB[i];
+			glm::batchMul(A, B, A, Count);
+			for(std::size_t i = 0; i < Count; ++i)
+				Error += A[i] == Out[i] ? 0 : 1;
+		}
+
+		return Error;
+	}
+}//namespace mul_
+
+#if GLM_HAS_CXX11_STL
+namespace parallel
+{
+	int test()
+	{
+		int Error = 0;
+
+		// Enough for every thread to get a share, and not a multiple of anything, so the chunks split in
+		// the middle of the wide loops.
+		std::size_t const Count = 65536 * 4 + 13;
+		glm::mat4 const m(
+			0.f, 1.f, 0.f, 0.f,
+			-1.f, 0.f, 0.f, 0.f,
+			0.f, 0.f, 2.f, 0.f,
+			3.f, -2.f, 1.f, 1.f);
+		std::vector<glm::vec4> In(Count), Out(Count), Expected(Count);
+		for(std::size_t i = 0; i < Count; ++i)
+			In[i] = glm::vec4(static_cast<float>(i % 13), static_cast<float>(i % 17) * 0.5f, -1.f, 1.f);
+
+		glm::batchMul(m, &In[0], &Expected[0], Count);
+		glm::batchMulParallel(m, &In[0], &Out[0], Count, 4);
+		for(std::size_t i = 0; i < Count; ++i)
+			Error += glm::all(glm::equal(Out[i], Expected[i])) ? 0 : 1;
+
+		glm::mat4 const Shear(
+			1.f, 0.f, 0.f, 0.f,
+			0.5f, 1.f, 0.f, 0.f,
+			0.f, -1.f, 1.f, 0.f,
+			0.f, 0.f, 0.f, 1.f);
+		std::size_t const MatrixCount = 16384 * 4 + 5;
+		std::vector<glm::mat4> A(MatrixCount), B(MatrixCount), C(MatrixCount), D(MatrixCount);
+		for(std::size_t i = 0; i < MatrixCount; ++i)
+		{
+			A[i] = Shear * static_cast<float>(i % 9);
+			B[i] = m + glm::mat4(static_cast<float>(i % 3));
+		}
+
+		glm::batchMul(&A[0], &B[0], &C[0], MatrixCount);
+		glm::batchMulParallel(&A[0], &B[0], &D[0], MatrixCount, 4);
+		for(std::size_t i = 0; i < MatrixCount; ++i)
+			Error += C[i] == D[i] ? 0 : 1;
+
+		// Too small to split, and empty
+		glm::batchMulParallel(m, &In[0], &Out[0], 5);
+		glm::batchMulParallel(m, &In[0], &Out[0], 0);
+
+		return Error;
+	}
+}//namespace parallel
+#endif//GLM_HAS_CXX11_STL
+
+namespace perf
+{
+	int test(std::size_t Count, std::size_t Passes)
+	{
+		glm::mat4 const m(
+			0.8f, 0.1f, 0.f, 0.f,
+			-0.1f, 0.8f, 0.2f, 0.f,
+			0.f, -0.2f, 0.9f, 0.f,
+			1.f, 2.f, 3.f, 1.f);
+		std::vector<glm::vec4> In(Count), Out(Count);
+		for(std::size_t i = 0; i < Count; ++i)
+			In[i] = glm::vec4(static_cast<float>(i & 255), static_cast<float>(i >> 8), 0.5f, 1.f);
+
+		std::clock_t const LoopStart = std::clock();
+		for(std::size_t p = 0; p < Passes; ++p)
+		for(std::size_t i = 0; i < Count; ++i)
+			Out[i] = m * In[i];
+		std::clock_t const LoopEnd = std::clock();
+
+		std::clock_t const BatchStart = std::clock();
+		for(std::size_t p = 0; p < Passes; ++p)
+			glm::batchMul(m, &In[0], &Out[0], Count);
+		std::clock_t const BatchEnd = std::clock();
+
+		std::printf("mat4 * vec4, loop: %d clocks, batchMul: %d clocks (%f)\n", static_cast<int>(LoopEnd - LoopStart), static_cast<int>(BatchEnd - BatchStart), Out[Count / 2].x);
+		return 0;
+	}
+}//namespace perf
+
+int main()
+{
+	int Error = 0;
+
+	Error += mul_vec4::test();
+	Error += mul_vec4::test_dvec4();
+	Error += mul_::test();
+
+#	if GLM_HAS_CXX11_STL
+		Error += parallel::test();
+#	endif
+
+#	ifdef NDEBUG
+		Error += perf::test(1 << 16, 200);
+#	endif
+
+	return Error;
+}
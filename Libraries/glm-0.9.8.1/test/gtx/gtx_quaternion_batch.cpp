@@ -0,0 +1,295 @@
+#include <glm/gtx/quaternion_batch.hpp>
+#include <glm/gtc/epsilon.hpp>
+#include <cstdio>
+#include <ctime>
+#include <vector>
+
+// Every kernel is checked against the gtc/quaternion functions it stands in for, over counts that leave
+// a partial block at the end for every lane width.
+
+namespace
+{
+	template <typename T>
+	glm::tquat<T, glm::defaultp> shortest_nlerp(glm::tquat<T, glm::defaultp> const & a, glm::tquat<T, glm::defaultp> const & b, T t)
+	{
+		glm::tquat<T, glm::defaultp> const Far = glm::dot(a, b) < T(0) ? -b : b;
+		return glm::normalize(glm::lerp(a, Far, t));
+	}
+}//namespace
+
+// The inputs repeat every seven, so the pattern never lines up with a lane width.
+
+namespace mul
+{
+	template <typename T>
+	int test(std::size_t Count)
+	{
+		typedef glm::tquat<T, glm::defaultp> quat_type;
+
+		int Error = 0;
+
+		quat_type const Left[] = {
+			quat_type(1, 0, 0, 0), quat_type(0.5, 0.5, 0.5, 0.5), quat_type(0.6, 0.8, 0, 0), quat_type(0, 0, 0.6, 0.8),
+			quat_type(0.36, 0.48, 0.64, 0.48), quat_type(0.5, -0.5, 0.5, -0.5), quat_type(2, -1, 0.5, 3)};
+		quat_type const Right[] = {
+			quat_type(0, 1, 0, 0), quat_type(-0.5, -0.5, -0.5, -0.5), quat_type(0.8, 0, 0.6, 0), quat_type(0.36, -0.48, 0.64, -0.48),
+			quat_type(1, 0, 0, 0), quat_type(0, 0, -1, 0), quat_type(0.5, 0.25, -1, 2)};
+
+		std::vector<quat_type> A(Count), B(Count), Out(Count);
+		for(std::size_t i = 0; i < Count; ++i)
+		{
+			A[i] = Left[i % 7];
+			B[i] = Right[(i * 3 + 1) % 7];
+		}
+
+		glm::batchMul(&A[0], &B[0], &Out[0], Count);
+		for(std::size_t i = 0; i < Count; ++i)
+			Error += glm::all(glm::epsilonEqual(Out[i], A[i] * B[i], static_cast<T>(1e-6))) ? 0 : 1;
+
+		// In place, over an odd offset into the array.
+		if(Count > 1)
+			glm::batchMul(&A[1], &B[1], &A[1], Count - 1);
+		for(std::size_t i = 1; i < Count; ++i)
+			Error += glm::all(glm::epsilonEqual(A[i], Out[i], static_cast<T>(1e-6))) ? 0 : 1;
+
+		return Error;
+	}
+}//namespace mul
+
+namespace normalize
+{
+	int test(std::size_t Count)
+	{
+		int Error = 0;
+
+		glm::quat const Values[] = {
+			glm::quat(2, 0, 0, 0), glm::quat(1, 1, 1, 1), glm::quat(0.3f, 0.4f, 0, 0), glm::quat(0, 0, -3, 4),
+			glm::quat(0.5f, -1, 2, 0.25f), glm::quat(10, 0, 0, -10), glm::quat(0.01f, 0.02f, 0.02f, 0.04f)};
+
+		std::vector<glm::quat> In(Count), Out(Count);
+		for(std::size_t i = 0; i < Count; ++i)
+			In[i] = Values[i % 7];
+
+		glm::batchNormalize(&In[0], &Out[0], Count);
+		for(std::size_t i = 0; i < Count; ++i)
+			Error += glm::all(glm::epsilonEqual(Out[i], glm::normalize(In[i]), 1e-6f)) ? 0 : 1;
+
+		return Error;
+	}
+}//namespace normalize
+
+namespace nlerp
+{
+	template <typename T>
+	int test(std::size_t Count)
+	{
+		typedef glm::tquat<T, glm::defaultp> quat_type;
+
+		int Error = 0;
+
+		// Some pairs are on opposite sides of the sphere, so the shorter way round has to be taken.
+		quat_type const From[] = {
+			quat_type(1, 0, 0, 0), quat_type(0.5, 0.5, 0.5, 0.5), quat_type(0.6, 0.8, 0, 0), quat_type(0, 0, 0.6, 0.8),
+			quat_type(0.36, 0.48, 0.64, 0.48), quat_type(0.5, -0.5, 0.5, -0.5), quat_type(0.8, 0, 0.6, 0)};
+		quat_type const To[] = {
+			quat_type(0.6, 0, 0.8, 0), quat_type(-0.5, -0.5, -0.5, -0.5), quat_type(-0.36, 0.48, -0.64, 0.48), quat_type(0, 1, 0, 0),
+			quat_type(-0.6, 0, 0, 0.8), quat_type(0.5, 0.5, 0.5, 0.5), quat_type(-0.8, 0, 0, 0.6)};
+
+		std::vector<quat_type> A(Count), B(Count), Out(Count);
+		for(std::size_t i = 0; i < Count; ++i)
+		{
+			A[i] = From[i % 7];
+			B[i] = To[i % 7];
+		}
+
+		for(int Step = 0; Step <= 4; ++Step)
+		{
+			T const t = static_cast<T>(Step) / T(4);
+			glm::batchNlerp(&A[0], &B[0], t, &Out[0], Count);
+			for(std::size_t i = 0; i < Count; ++i)
+				Error += glm::all(glm::epsilonEqual(Out[i], shortest_nlerp(A[i], B[i], t), static_cast<T>(1e-6))) ? 0 : 1;
+		}
+
+		return Error;
+	}
+}//namespace nlerp
+
+namespace slerp
+{
+	template <typename T>
+	int test(std::size_t Count)
+	{
+		typedef glm::tquat<T, glm::defaultp> quat_type;
+
+		int Error = 0;
+
+		// Pairs cover the far side of the sphere, half turns and quaternions close enough for slerp to
+		// fall back to a linear mix.
+		quat_type const From[] = {
+			quat_type(1, 0, 0, 0), quat_type(0.5, 0.5, 0.5, 0.5), quat_type(0.6, 0.8, 0, 0), quat_type(0, 0, 0.6, 0.8),
+			quat_type(0.36, 0.48, 0.64, 0.48), quat_type(0.5, -0.5, 0.5, -0.5), quat_type(0.8, 0, 0.6, 0)};
+		quat_type const To[] = {
+			quat_type(0, 1, 0, 0), quat_type(-0.5, -0.5, -0.5, -0.5), quat_type(0.6, 0.8, 0, 0.0001), quat_type(0.36, -0.48, 0.64, -0.48),
+			quat_type(-0.6, 0, 0, 0.8), quat_type(0.5, 0.5, 0.5, 0.5), quat_type(-0.8, 0, 0, 0.6)};
+
+		std::vector<quat_type> A(Count), B(Count), Out(Count);
+		for(std::size_t i = 0; i < Count; ++i)
+		{
+			A[i] = From[i % 7];
+			B[i] = To[i % 7];
+		}
+
+		for(int Step = 0; Step <= 8; ++Step)
+		{
+			T const t = static_cast<T>(Step) / T(8);
+			glm::batchSlerp(&A[0], &B[0], t, &Out[0], Count);
+			for(std::size_t i = 0; i < Count; ++i)
+				Error += glm::all(glm::epsilonEqual(Out[i], glm::slerp(A[i], B[i], t), static_cast<T>(1e-5))) ? 0 : 1;
+		}
+
+		return Error;
+	}
+
+	int test_fast(std::size_t Count)
+	{
+		int Error = 0;
+
+		glm::quat const From[] = {
+			glm::quat(1, 0, 0, 0), glm::quat(0.5f, 0.5f, 0.5f, 0.5f), glm::quat(0.6f, 0.8f, 0, 0), glm::quat(0, 0, 0.6f, 0.8f),
+			glm::quat(0.36f, 0.48f, 0.64f, 0.48f), glm::quat(0.5f, -0.5f, 0.5f, -0.5f), glm::quat(0.8f, 0, 0.6f, 0)};
+		glm::quat const To[] = {
+			glm::quat(0, 1, 0, 0), glm::quat(-0.5f, -0.5f, -0.5f, -0.5f), glm::quat(0.6f, 0.8f, 0, 0.0001f), glm::quat(0.36f, -0.48f, 0.64f, -0.48f),
+			glm::quat(-0.6f, 0, 0, 0.8f), glm::quat(0.5f, 0.5f, 0.5f, 0.5f), glm::quat(-0.8f, 0, 0, 0.6f)};
+
+		std::vector<glm::quat> A(Count), B(Count), Out(Count);
+		std::vector<glm::dquat> DoubleA(Count), DoubleB(Count), DoubleOut(Count);
+		for(std::size_t i = 0; i < Count; ++i)
+		{
+			A[i] = From[i % 7];
+			B[i] = To[i % 7];
+			DoubleA[i] = glm::dquat(A[i]);
+			DoubleB[i] = glm::dquat(B[i]);
+		}
+
+		float MaxError = 0.0f;
+		for(int Step = 0; Step <= 16; ++Step)
+		{
+			float const t = static_cast<float>(Step) / 16.0f;
+			glm::batchFastSlerp(&A[0], &B[0], t, &Out[0], Count);
+			glm::batchFastSlerp(&DoubleA[0], &DoubleB[0], static_cast<double>(t), &DoubleOut[0], Count);
+			for(std::size_t i = 0; i < Count; ++i)
+			{
+				glm::quat const Exact = glm::slerp(A[i], B[i], t);
+				float const Distance = glm::length(glm::vec4(Out[i].x, Out[i].y, Out[i].z, Out[i].w) - glm::vec4(Exact.x, Exact.y, Exact.z, Exact.w));
+				MaxError = glm::max(MaxError, Distance);
+				Error += Distance < 2e-3f ? 0 : 1;
+				Error += glm::all(glm::epsilonEqual(Out[i], glm::quat(DoubleOut[i]), 1e-5f)) ? 0 : 1;
+			}
+		}
+
+		std::printf("batchFastSlerp largest distance from slerp: %g\n", MaxError);
+		return Error;
+	}
+}//namespace slerp
+
+namespace mat3x4_cast
+{
+	template <typename T>
+	int test(std::size_t Count)
+	{
+		typedef glm::tquat<T, glm::defaultp> quat_type;
+
+		int Error = 0;
+
+		quat_type const Values[] = {
+			quat_type(1, 0, 0, 0), quat_type(0.5, 0.5, 0.5, 0.5), quat_type(0.6, 0.8, 0, 0), quat_type(0, 0, 0.6, 0.8),
+			quat_type(0.36, 0.48, 0.64, 0.48), quat_type(0.5, -0.5, 0.5, -0.5), quat_type(-0.8, 0, 0, 0.6)};
+
+		std::vector<quat_type> In(Count);
+		std::vector<glm::tmat3x4<T, glm::defaultp> > Out(Count + 1, glm::tmat3x4<T, glm::defaultp>(T(7)));
+		for(std::size_t i = 0; i < Count; ++i)
+			In[i] = Values[i % 7];
+
+		glm::batchMat3x4Cast(&In[0], &Out[0], Count);
+		for(std::size_t i = 0; i < Count; ++i)
+		{
+			glm::tmat3x3<T, glm::defaultp> const Expected = glm::mat3_cast(In[i]);
+			for(glm::length_t c = 0; c < 3; ++c)
+			{
+				Error += glm::all(glm::epsilonEqual(glm::tvec3<T, glm::defaultp>(Out[i][c]), Expected[c], static_cast<T>(1e-6))) ? 0 : 1;
+				Error += Out[i][c].w == T(0) ? 0 : 1;
+			}
+		}
+
+		// Nothing is written past the end.
+		Error += Out[Count] == glm::tmat3x4<T, glm::defaultp>(T(7)) ? 0 : 1;
+
+		return Error;
+	}
+}//namespace mat3x4_cast
+
+namespace perf
+{
+	int test(std::size_t Count, std::size_t Passes)
+	{
+		glm::quat const From[] = {
+			glm::quat(1, 0, 0, 0), glm::quat(0.5f, 0.5f, 0.5f, 0.5f), glm::quat(0.6f, 0.8f, 0, 0), glm::quat(0, 0, 0.6f, 0.8f),
+			glm::quat(0.36f, 0.48f, 0.64f, 0.48f), glm::quat(0.5f, -0.5f, 0.5f, -0.5f), glm::quat(0.8f, 0, 0.6f, 0)};
+		glm::quat const To[] = {
+			glm::quat(0.6f, 0, 0.8f, 0), glm::quat(0.5f, -0.5f, -0.5f, 0.5f), glm::quat(0, 0.6f, 0.8f, 0), glm::quat(0.36f, -0.48f, 0.64f, -0.48f),
+			glm::quat(0.6f, 0, 0, 0.8f), glm::quat(0.8f, 0.6f, 0, 0), glm::quat(0, 0.8f, 0, 0.6f)};
+
+		std::vector<glm::quat> A(Count), B(Count), Out(Count);
+		for(std::size_t i = 0; i < Count; ++i)
+		{
+			A[i] = From[i % 7];
+			B[i] = To[(i * 3 + 1) % 7];
+		}
+
+		std::clock_t const ScalarStart = std::clock();
+		for(std::size_t p = 0; p < Passes; ++p)
+		for(std::size_t i = 0; i < Count; ++i)
+			Out[i] = glm::slerp(A[i], B[i], 0.3f);
+		std::clock_t const ScalarEnd = std::clock();
+
+		std::clock_t const BatchStart = std::clock();
+		for(std::size_t p = 0; p < Passes; ++p)
+			glm::batchSlerp(&A[0], &B[0], 0.3f, &Out[0], Count);
+		std::clock_t const BatchEnd = std::clock();
+
+		std::clock_t const FastStart = std::clock();
+		for(std::size_t p = 0; p < Passes; ++p)
+			glm::batchFastSlerp(&A[0], &B[0], 0.3f, &Out[0], Count);
+		std::clock_t const FastEnd = std::clock();
+
+		std::printf("slerp: %d clocks, batchSlerp: %d clocks, batchFastSlerp: %d clocks (%f)\n",
+			static_cast<int>(ScalarEnd - ScalarStart), static_cast<int>(BatchEnd - BatchStart), static_cast<int>(FastEnd - FastStart), Out[Count / 2].w);
+		return 0;
+	}
+}//namespace perf
+
+int main()
+{
+	int Error = 0;
+
+	std::size_t const Counts[] = {1, 3, 17, 33, 1000};
+	for(std::size_t i = 0; i < sizeof(Counts) / sizeof(Counts[0]); ++i)
+	{
+		Error += mul::test<float>(Counts[i]);
+		Error += mul::test<double>(Counts[i]);
+		Error += normalize::test(Counts[i]);
+		Error += nlerp::test<float>(Counts[i]);
+		Error += nlerp::test<double>(Counts[i]);
+		Error += slerp::test<float>(Counts[i]);
+		Error += slerp::test<double>(Counts[i]);
+		Error += slerp::test_fast(Counts[i]);
+		Error += mat3x4_cast::test<float>(Counts[i]);
+		Error += mat3x4_cast::test<double>(Counts[i]);
+	}
+
+#	ifdef NDEBUG
+		Error += perf::test(4096, 500);
+#	endif
+
+	return Error;
+}
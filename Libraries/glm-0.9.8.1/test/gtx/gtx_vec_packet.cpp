@@ -0,0 +1,289 @@
+#include <glm/gtx/vec_packet.hpp>
+#include <glm/gtc/epsilon.hpp>
+#include <cstdio>
+#include <vector>
+
+// Each packet operation is checked lane by lane against the scalar function it stands in for.
+
+namespace
+{
+	template <glm::length_t N>
+	std::vector<float> lanes(glm::tfloatx<N> const & v)
+	{
+		std::vector<float> Result(N);
+		v.store(&Result[0]);
+		return Result;
+	}
+
+	template <glm::length_t N>
+	std::vector<glm::vec3> lanes(glm::tvec3x<N> const & v)
+	{
+		std::vector<glm::vec3> Result(N);
+		v.store(&Result[0]);
+		return Result;
+	}
+
+	template <glm::length_t N>
+	std::vector<glm::vec4> lanes(glm::tvec4x<N> const & v)
+	{
+		std::vector<glm::vec4> Result(N);
+		v.store(&Result[0]);
+		return Result;
+	}
+}//namespace
+
+namespace load_store
+{
+	// From every float offset, so none of the loads can rely on alignment.
+	template <glm::length_t N>
+	int test()
+	{
+		int Error = 0;
+
+		// Every lane gets its own values, so a lane ending up in the wrong place shows.
+		std::vector<glm::vec3> Expected3(N);
+		std::vector<glm::vec4> Expected4(N);
+		for(std::size_t i = 0; i < N; ++i)
+		{
+			float const f = static_cast<float>(i);
+			Expected3[i] = glm::vec3(f, -0.5f * f, 100.0f + f);
+			Expected4[i] = glm::vec4(-f, 2.0f * f, 0.25f * f, 50.0f - f);
+		}
+
+		std::vector<float> Storage(N * 4 * 2 + 4);
+		for(std::size_t Offset = 0; Offset < 4; ++Offset)
+		{
+			glm::vec3 * In3 = reinterpret_cast<glm::vec3 *>(&Storage[Offset]);
+			for(std::size_t i = 0; i < N; ++i)
+				In3[i] = Expected3[i];
+			glm::tvec3x<N> const a = glm::tvec3x<N>::load(In3);
+			std::vector<glm::vec3> Out3(N + 1, glm::vec3(42.0f));
+			a.store(&Out3[0]);
+			for(std::size_t i = 0; i < N; ++i)
+				Error += glm::all(glm::equal(Out3[i], Expected3[i])) ? 0 : 1;
+			Error += glm::all(glm::equal(Out3[N], glm::vec3(42.0f))) ? 0 : 1;
+
+			std::vector<float> const X = lanes(a.x), Y = lanes(a.y), Z = lanes(a.z);
+			for(std::size_t i = 0; i < N; ++i)
+				Error += glm::all(glm::equal(glm::vec3(X[i], Y[i], Z[i]), Expected3[i])) ? 0 : 1;
+
+			glm::vec4 * In4 = reinterpret_cast<glm::vec4 *>(&Storage[Offset]);
+			for(std::size_t i = 0; i < N; ++i)
+				In4[i] = Expected4[i];
+			glm::tvec4x<N> const b = glm::tvec4x<N>::load(In4);
+			std::vector<glm::vec4> Out4(N);
+			b.store(&Out4[0]);
+			for(std::size_t i = 0; i < N; ++i)
+				Error += glm::all(glm::equal(Out4[i], Expected4[i])) ? 0 : 1;
+		}
+
+		// Structure of arrays
+		std::vector<float> X(N), Y(N), Z(N);
+		for(std::size_t i = 0; i < N; ++i)
+		{
+			X[i] = static_cast<float>(i);
+			Y[i] = static_cast<float>(i) * 2.0f;
+			Z[i] = static_cast<float>(i) * 3.0f;
+		}
+		glm::tvec3x<N> const c = glm::tvec3x<N>::load(&X[0], &Y[0], &Z[0]);
+		std::vector<glm::vec3> const Out = lanes(c);
+		for(std::size_t i = 0; i < N; ++i)
+			Error += glm::all(glm::equal(Out[i], glm::vec3(X[i], Y[i], Z[i]))) ? 0 : 1;
+		std::vector<float> X2(N), Y2(N), Z2(N);
+		c.store(&X2[0], &Y2[0], &Z2[0]);
+		Error += X2 == X && Y2 == Y && Z2 == Z ? 0 : 1;
+
+		// Broadcast
+		std::vector<glm::vec3> const Same = lanes(glm::tvec3x<N>(glm::vec3(1, 2, 3)));
+		for(std::size_t i = 0; i < N; ++i)
+			Error += glm::all(glm::equal(Same[i], glm::vec3(1, 2, 3))) ? 0 : 1;
+
+		return Error;
+	}
+}//namespace load_store
+
+namespace vec3_
+{
+	template <glm::length_t N>
+	int test()
+	{
+		int Error = 0;
+
+		// No component is zero, even after the offset, so dividing by any of them is fine.
+		glm::vec3 const Values[] = {
+			glm::vec3(-3.0f, 2.0f, -1.5f), glm::vec3(-2.5f, 1.75f, 2.0f),
+			glm::vec3(1.0f, -0.5f, 3.0f), glm::vec3(0.5f, 4.0f, -4.0f),
+			glm::vec3(2.0f, -1.25f, 5.0f), glm::vec3(-0.75f, 3.0f, 6.0f),
+			glm::vec3(4.0f, 0.25f, -7.0f), glm::vec3(1.5f, -2.0f, 8.0f)};
+
+		// The offset keeps lanes past the eighth from repeating the first eight.
+		std::vector<glm::vec3> A(N), B(N), C(N);
+		for(std::size_t i = 0; i < N; ++i)
+		{
+			glm::vec3 const Offset(static_cast<float>(i / 8));
+			A[i] = Values[i % 8] + Offset;
+			B[i] = Values[(i * 7 + 3) % 8] + Offset;
+			C[i] = Values[(i * 5 + 1) % 8] + Offset;
+		}
+		glm::tvec3x<N> const a = glm::tvec3x<N>::load(&A[0]);
+		glm::tvec3x<N> const b = glm::tvec3x<N>::load(&B[0]);
+		glm::tvec3x<N> const c = glm::tvec3x<N>::load(&C[0]);
+
+		std::vector<float> const Dot = lanes(glm::dot(a, b)), Length = lanes(glm::length(a));
+		std::vector<glm::vec3> const Add = lanes(a + b), Sub = lanes(a - b), Mul = lanes(a * b), Div = lanes(a / b);
+		std::vector<glm::vec3> const Scale = lanes(a * c.x), ScaleLeft = lanes(c.x * a), Neg = lanes(-a);
+		std::vector<glm::vec3> const Cross = lanes(glm::cross(a, b)), Normalize = lanes(glm::normalize(a));
+		std::vector<glm::vec3> const Min = lanes(glm::min(a, b)), Max = lanes(glm::max(a, b)), Fma = lanes(glm::fma(a, b, c));
+		for(std::size_t i = 0; i < N; ++i)
+		{
+			Error += glm::epsilonEqual(Dot[i], glm::dot(A[i], B[i]), 0.0001f) ? 0 : 1;
+			Error += glm::epsilonEqual(Length[i], glm::length(A[i]), 0.0001f) ? 0 : 1;
+			Error += glm::all(glm::epsilonEqual(Add[i], A[i] + B[i], 0.0001f)) ? 0 : 1;
+			Error += glm::all(glm::epsilonEqual(Sub[i], A[i] - B[i], 0.0001f)) ? 0 : 1;
+			Error += glm::all(glm::epsilonEqual(Mul[i], A[i] * B[i], 0.0001f)) ? 0 : 1;
+			Error += glm::all(glm::epsilonEqual(Div[i], A[i] / B[i], 0.0001f)) ? 0 : 1;
+			Error += glm::all(glm::epsilonEqual(Scale[i], A[i] * C[i].x, 0.0001f)) ? 0 : 1;
+			Error += glm::all(glm::epsilonEqual(ScaleLeft[i], A[i] * C[i].x, 0.0001f)) ? 0 : 1;
+			Error += glm::all(glm::epsilonEqual(Neg[i], -A[i], 0.0001f)) ? 0 : 1;
+			Error += glm::all(glm::epsilonEqual(Cross[i], glm::cross(A[i], B[i]), 0.0001f)) ? 0 : 1;
+			Error += glm::all(glm::epsilonEqual(Normalize[i], glm::normalize(A[i]), 0.0001f)) ? 0 : 1;
+			Error += glm::all(glm::epsilonEqual(Min[i], glm::min(A[i], B[i]), 0.0001f)) ? 0 : 1;
+			Error += glm::all(glm::epsilonEqual(Max[i], glm::max(A[i], B[i]), 0.0001f)) ? 0 : 1;
+			Error += glm::all(glm::epsilonEqual(Fma[i], A[i] * B[i] + C[i], 0.0001f)) ? 0 : 1;
+		}
+
+		return Error;
+	}
+}//namespace vec3_
+
+namespace vec4_
+{
+	template <glm::length_t N>
+	int test()
+	{
+		int Error = 0;
+
+		// The y components are never zero, even after the offset, since they get divided by.
+		glm::vec4 const Values[] = {
+			glm::vec4(-3.0f, 2.0f, -1.5f, -2.5f), glm::vec4(-2.5f, 1.75f, 2.0f, -1.5f),
+			glm::vec4(1.0f, -0.5f, 3.0f, -0.5f), glm::vec4(0.5f, 4.0f, -4.0f, 0.5f),
+			glm::vec4(2.0f, -1.25f, 5.0f, 1.5f), glm::vec4(-0.75f, 3.0f, 6.0f, -2.5f),
+			glm::vec4(4.0f, 0.25f, -7.0f, -1.5f), glm::vec4(1.5f, -2.0f, 8.0f, -0.5f)};
+
+		// The offset keeps lanes past the eighth from repeating the first eight.
+		std::vector<glm::vec4> A(N), B(N), C(N);
+		for(std::size_t i = 0; i < N; ++i)
+		{
+			glm::vec4 const Offset(static_cast<float>(i / 8));
+			A[i] = Values[i % 8] + Offset;
+			B[i] = Values[(i * 7 + 3) % 8] + Offset;
+			C[i] = Values[(i * 5 + 1) % 8] + Offset;
+		}
+		glm::tvec4x<N> const a = glm::tvec4x<N>::load(&A[0]);
+		glm::tvec4x<N> const b = glm::tvec4x<N>::load(&B[0]);
+		glm::tvec4x<N> const c = glm::tvec4x<N>::load(&C[0]);
+
+		std::vector<float> const Dot = lanes(glm::dot(a, b)), Length = lanes(glm::length(a));
+		std::vector<glm::vec4> const Add = lanes(a + b), Div = lanes(a / c.y), Normalize = lanes(glm::normalize(a));
+		std::vector<glm::vec4> const Min = lanes(glm::min(a, b)), Max = lanes(glm::max(a, b)), Fma = lanes(glm::fma(a, b, c));
+		for(std::size_t i = 0; i < N; ++i)
+		{
+			Error += glm::epsilonEqual(Dot[i], glm::dot(A[i], B[i]), 0.0001f) ? 0 : 1;
+			Error += glm::epsilonEqual(Length[i], glm::length(A[i]), 0.0001f) ? 0 : 1;
+			Error += glm::all(glm::epsilonEqual(Add[i], A[i] + B[i], 0.0001f)) ? 0 : 1;
+			Error += glm::all(glm::epsilonEqual(Div[i], A[i] / C[i].y, 0.0001f)) ? 0 : 1;
+			Error += glm::all(glm::epsilonEqual(Normalize[i], glm::normalize(A[i]), 0.0001f)) ? 0 : 1;
+			Error += glm::all(glm::epsilonEqual(Min[i], glm::min(A[i], B[i]), 0.0001f)) ? 0 : 1;
+			Error += glm::all(glm::epsilonEqual(Max[i], glm::max(A[i], B[i]), 0.0001f)) ? 0 : 1;
+			Error += glm::all(glm::epsilonEqual(Fma[i], A[i] * B[i] + C[i], 0.0001f)) ? 0 : 1;
+		}
+
+		return Error;
+	}
+}//namespace vec4_
+
+namespace mask
+{
+	template <glm::length_t N>
+	int test()
+	{
+		int Error = 0;
+
+		std::vector<float> A(N), B(N);
+		for(std::size_t i = 0; i < N; ++i)
+		{
+			A[i] = static_cast<float>(i % 4);
+			B[i] = static_cast<float>((i + 2) % 3);
+		}
+		glm::tfloatx<N> const a = glm::tfloatx<N>::load(&A[0]);
+		glm::tfloatx<N> const b = glm::tfloatx<N>::load(&B[0]);
+
+		unsigned int Less = 0, LessEqual = 0, Greater = 0, GreaterEqual = 0, Equal = 0, NotEqual = 0;
+		for(std::size_t i = 0; i < N; ++i)
+		{
+			Less |= (A[i] < B[i] ? 1u : 0u) << i;
+			LessEqual |= (A[i] <= B[i] ? 1u : 0u) << i;
+			Greater |= (A[i] > B[i] ? 1u : 0u) << i;
+			GreaterEqual |= (A[i] >= B[i] ? 1u : 0u) << i;
+			Equal |= (A[i] == B[i] ? 1u : 0u) << i;
+			NotEqual |= (A[i] != B[i] ? 1u : 0u) << i;
+		}
+
+		Error += glm::laneMask(glm::lessThan(a, b)) == Less ? 0 : 1;
+		Error += glm::laneMask(glm::lessThanEqual(a, b)) == LessEqual ? 0 : 1;
+		Error += glm::laneMask(glm::greaterThan(a, b)) == Greater ? 0 : 1;
+		Error += glm::laneMask(glm::greaterThanEqual(a, b)) == GreaterEqual ? 0 : 1;
+		Error += glm::laneMask(glm::equal(a, b)) == Equal ? 0 : 1;
+		Error += glm::laneMask(glm::notEqual(a, b)) == NotEqual ? 0 : 1;
+		Error += glm::laneMask(glm::lessThan(a, b) & glm::greaterThan(a, b)) == 0 ? 0 : 1;
+		Error += glm::laneMask(glm::lessThan(a, b) | glm::equal(a, b)) == LessEqual ? 0 : 1;
+		Error += glm::laneMask(glm::not_(glm::equal(a, b))) == NotEqual ? 0 : 1;
+
+		Error += glm::any(glm::lessThan(a, b)) ? 0 : 1;
+		Error += !glm::all(glm::lessThan(a, b)) ? 0 : 1;
+		Error += glm::all(glm::equal(a, a)) ? 0 : 1;
+		Error += !glm::any(glm::notEqual(a, a)) ? 0 : 1;
+
+		std::vector<float> const Select = lanes(glm::select(glm::lessThan(a, b), a, b)), Min = lanes(glm::min(a, b));
+		std::vector<float> const Abs = lanes(glm::abs(a - b)), Sqrt = lanes(glm::sqrt(a));
+		for(std::size_t i = 0; i < N; ++i)
+		{
+			Error += glm::epsilonEqual(Select[i], A[i] < B[i] ? A[i] : B[i], 0.0001f) ? 0 : 1;
+			Error += glm::epsilonEqual(Min[i], A[i] < B[i] ? A[i] : B[i], 0.0001f) ? 0 : 1;
+			Error += glm::epsilonEqual(Abs[i], glm::abs(A[i] - B[i]), 0.0001f) ? 0 : 1;
+			Error += glm::epsilonEqual(Sqrt[i], glm::sqrt(A[i]), 0.0001f) ? 0 : 1;
+		}
+
+		// Picking whole vectors by lane
+		glm::tvec3x<N> const Ones(glm::vec3(1.0f)), Twos(glm::vec3(2.0f));
+		std::vector<glm::vec3> const Picked = lanes(glm::select(glm::lessThan(a, b), Ones, Twos));
+		for(std::size_t i = 0; i < N; ++i)
+			Error += glm::all(glm::equal(Picked[i], glm::vec3(A[i] < B[i] ? 1.0f : 2.0f))) ? 0 : 1;
+
+		return Error;
+	}
+}//namespace mask
+
+int main()
+{
+	int Error = 0;
+
+	Error += load_store::test<4>();
+	Error += load_store::test<8>();
+	Error += load_store::test<16>();
+	Error += vec3_::test<4>();
+	Error += vec3_::test<8>();
+	Error += vec3_::test<16>();
+	Error += vec4_::test<4>();
+	Error += vec4_::test<8>();
+	Error += vec4_::test<16>();
+	Error += mask::test<4>();
+	Error += mask::test<8>();
+	Error += mask::test<16>();
+
+	// Widths that are always made of halves
+	Error += vec3_::test<2>();
+	Error += mask::test<32>();
+
+	return Error;
+}
@@ -0,0 +1,175 @@
+#include "Benchmark.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#include <Psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+namespace Biendeo::VulkanGame {
+	namespace {
+		// Makes text safe to put between quotes in the report. Device names come from the driver, so
+		// they could hold anything.
+		std::string EscapeJSON(const std::string& text) {
+			std::string escaped;
+			escaped.reserve(text.size());
+			for (char c : text) {
+				switch (c) {
+					case '"': escaped += "\\\""; break;
+					case '\\': escaped += "\\\\"; break;
+					case '\b': escaped += "\\b"; break;
+					case '\f': escaped += "\\f"; break;
+					case '\n': escaped += "\\n"; break;
+					case '\r': escaped += "\\r"; break;
+					case '\t': escaped += "\\t"; break;
+					default:
+						if (static_cast<unsigned char>(c) < 0x20) {
+							char code[8];
+							std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned>(static_cast<unsigned char>(c)));
+							escaped += code;
+						} else {
+							escaped += c;
+						}
+						break;
+				}
+			}
+			return escaped;
+		}
+	}
+
+	Benchmark::Benchmark(uint64_t frames, const std::string& reportPath) {
+		this->frames = frames;
+		this->reportPath = reportPath;
+		this->timeToFirstFrame = 0.0;
+
+		// Reserving up front keeps the recording from allocating in the middle of the run.
+		timings.reserve(static_cast<size_t>(frames));
+	}
+
+	void Benchmark::Record(const FrameTiming& timing) {
+		timings.push_back(timing);
+	}
+
+	void Benchmark::RecordGpu(uint64_t frame, double gpu) {
+		// GPU times arrive a few frames late, so the frame is near the back.
+		for (size_t i = timings.size(); i > 0 && timings.size() - i < 8; --i) {
+			if (timings[i - 1].frame == frame) {
+				timings[i - 1].gpu = gpu;
+				return;
+			}
+		}
+	}
+
+	bool Benchmark::Complete() {
+		return timings.size() >= frames;
+	}
+
+	void Benchmark::RecordScaling(unsigned threads, double recordTime) {
+		scaling.push_back({ threads, recordTime });
+	}
+
+	void Benchmark::RecordStartup(const std::vector<StartupPhase>& phases, double timeToFirstFrame) {
+		this->startupPhases = phases;
+		this->timeToFirstFrame = timeToFirstFrame;
+	}
+
+	uint64_t Benchmark::Frames() {
+		return frames;
+	}
+
+	bool Benchmark::WriteReport(double startupTime, double elapsedTime, double hitchThreshold, const std::string& deviceName, const std::string& pipelineCacheState) {
+		std::ofstream file(reportPath);
+		if (!file) {
+			return false;
+		}
+
+		FrameSummary summary = FrameStatistics::Summarise(timings, hitchThreshold);
+
+		file << "{\n";
+		file << "\t\"frames\": " << timings.size() << ",\n";
+		file << "\t\"startupMs\": " << startupTime * 1000.0 << ",\n";
+		file << "\t\"timeToFirstFrameMs\": " << timeToFirstFrame * 1000.0 << ",\n";
+		file << "\t\"pipelineCache\": \"" << EscapeJSON(pipelineCacheState) << "\",\n";
+		file << "\t\"elapsedMs\": " << elapsedTime * 1000.0 << ",\n";
+		file << "\t\"averageFPS\": " << (elapsedTime > 0.0 ? timings.size() / elapsedTime : 0.0) << ",\n";
+		file << "\t\"hitches\": " << summary.hitches << ",\n";
+		file << "\t\"gpuMeasuredFrames\": " << summary.gpuMeasured << ",\n";
+		file << "\t\"gpuBoundFrames\": " << summary.gpuBound << ",\n";
+		file << "\t\"peakMemoryBytes\": " << PeakMemory() << ",\n";
+		file << "\t\"device\": \"" << EscapeJSON(deviceName) << "\",\n";
+		file << "\t\"build\": { \"configuration\": \"" << EscapeJSON(BuildConfiguration()) << "\", \"compiler\": \"" << EscapeJSON(Compiler()) << "\" },\n";
+		if (!startupPhases.empty()) {
+			file << "\t\"startupPhases\": [\n";
+			for (size_t i = 0; i < startupPhases.size(); ++i) {
+				file << "\t\t{ \"name\": \"" << EscapeJSON(startupPhases[i].name) << "\", \"startMs\": " << startupPhases[i].start * 1000.0 << ", \"durationMs\": " << startupPhases[i].duration * 1000.0 << ", \"thread\": " << startupPhases[i].thread << " }" << (i + 1 < startupPhases.size() ? "," : "") << "\n";
+			}
+			file << "\t],\n";
+		}
+		if (!scaling.empty()) {
+			// Speedup is against the single-threaded run, so perfect scaling would match the thread count.
+			file << "\t\"recordScaling\": [\n";
+			for (size_t i = 0; i < scaling.size(); ++i) {
+				double speedup = scaling[i].recordTime > 0.0 ? scaling[0].recordTime / scaling[i].recordTime : 0.0;
+				file << "\t\t{ \"threads\": " << scaling[i].threads << ", \"recordMs\": " << scaling[i].recordTime * 1000.0 << ", \"speedup\": " << speedup << " }" << (i + 1 < scaling.size() ? "," : "") << "\n";
+			}
+			file << "\t],\n";
+		}
+		FrameStatistics::WritePhasesJSON(file, summary);
+		file << "}\n";
+		return file.good();
+	}
+
+	uint64_t Benchmark::PeakMemory() {
+		#ifdef _WIN32
+		PROCESS_MEMORY_COUNTERS counters;
+		if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+			return counters.PeakWorkingSetSize;
+		}
+		return 0ull;
+		#else
+		// Linux reports the peak resident set in kilobytes.
+		rusage usage;
+		if (getrusage(RUSAGE_SELF, &usage) == 0) {
+			return static_cast<uint64_t>(usage.ru_maxrss) * 1024ull;
+		}
+		return 0ull;
+		#endif
+	}
+
+	std::string Benchmark::BuildConfiguration() {
+		std::string configuration;
+		#ifdef NDEBUG
+		configuration = "Release";
+		#else
+		configuration = "Debug";
+		#endif
+
+		#if defined(_WIN64) || defined(__x86_64__)
+		configuration += " x64";
+		#else
+		configuration += " x86";
+		#endif
+		return configuration;
+	}
+
+	std::string Benchmark::Compiler() {
+		std::ostringstream compiler;
+		#if defined(_MSC_VER)
+		compiler << "MSVC " << _MSC_VER;
+		#elif defined(__clang__)
+		compiler << "Clang " << __clang_major__ << "." << __clang_minor__;
+		#elif defined(__GNUC__)
+		compiler << "GCC " << __GNUC__ << "." << __GNUC_MINOR__;
+		#else
+		compiler << "Unknown";
+		#endif
+		return compiler.str();
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "FrameStatistics.h"
+#include "StartupProfile.h"
+
+namespace Biendeo::VulkanGame {
+	// Collects every frame of a fixed-length run and writes a machine-readable report at the end, so
+	// builds can be compared by diffing numbers instead of watching the console.
+	class Benchmark {
+		public:
+		Benchmark(uint64_t frames, const std::string& reportPath);
+
+		void Record(const FrameTiming& timing);
+		void RecordGpu(uint64_t frame, double gpu);
+		bool Complete();
+
+		// How long recording one frame's draw list took when split across this many threads.
+		void RecordScaling(unsigned threads, double recordTime);
+
+		// Where startup's time went, and how long it was until the first frame went out.
+		void RecordStartup(const std::vector<StartupPhase>& phases, double timeToFirstFrame);
+
+		uint64_t Frames();
+
+		bool WriteReport(double startupTime, double elapsedTime, double hitchThreshold, const std::string& deviceName, const std::string& pipelineCacheState);
+
+		static uint64_t PeakMemory();
+		static std::string BuildConfiguration();
+		static std::string Compiler();
+
+		private:
+		uint64_t frames;
+		std::string reportPath;
+		std::vector<FrameTiming> timings;
+
+		struct ScalingSample {
+			unsigned threads;
+			double recordTime;
+		};
+		std::vector<ScalingSample> scaling;
+
+		std::vector<StartupPhase> startupPhases;
+		double timeToFirstFrame;
+	};
+}
@@ -0,0 +1,304 @@
+#include "DescriptorHeap.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace Biendeo::VulkanGame {
+	namespace {
+		const uint32_t TextureBinding = 0;
+		const uint32_t BufferBinding = 1;
+
+		// The rest of what we need from VK_EXT_descriptor_indexing and
+		// VK_KHR_get_physical_device_properties2, since the headers don't have them either. The values
+		// are the ones the spec gives them.
+		const VkStructureType PhysicalDeviceFeatures2Type = static_cast<VkStructureType>(1000059000);
+		const VkStructureType BindingFlagsCreateInfoType = static_cast<VkStructureType>(1000161000);
+		const VkStructureType DescriptorIndexingFeaturesType = static_cast<VkStructureType>(1000161001);
+
+		const VkFlags BindingUpdateAfterBind = 0x1;
+		const VkFlags BindingUpdateUnusedWhilePending = 0x2;
+		const VkFlags BindingPartiallyBound = 0x4;
+		const VkFlags LayoutUpdateAfterBindPool = 0x2;
+		const VkFlags PoolUpdateAfterBind = 0x2;
+
+		struct PhysicalDeviceFeatures2 {
+			VkStructureType sType;
+			void* pNext;
+			VkPhysicalDeviceFeatures features;
+		};
+
+		struct DescriptorSetLayoutBindingFlagsCreateInfo {
+			VkStructureType sType;
+			const void* pNext;
+			uint32_t bindingCount;
+			const VkFlags* pBindingFlags;
+		};
+
+		typedef void (VKAPI_PTR *GetPhysicalDeviceFeatures2)(VkPhysicalDevice physicalDevice, PhysicalDeviceFeatures2* features);
+	}
+
+	const char* const DescriptorHeap::InstanceExtension = "VK_KHR_get_physical_device_properties2";
+	const char* const DescriptorHeap::DeviceExtension = "VK_EXT_descriptor_indexing";
+
+	bool DescriptorHeap::Supported(vk::Instance instance, vk::PhysicalDevice physicalDevice) {
+		bool extensionFound = false;
+		for (vk::ExtensionProperties& extension : physicalDevice.enumerateDeviceExtensionProperties()) {
+			if (std::strcmp(extension.extensionName, DeviceExtension) == 0) {
+				extensionFound = true;
+				break;
+			}
+		}
+		if (!extensionFound) {
+			return false;
+		}
+
+		// Having the extension doesn't mean having every part of it, so the features have to be asked for.
+		GetPhysicalDeviceFeatures2 getFeatures2 = reinterpret_cast<GetPhysicalDeviceFeatures2>(instance.getProcAddr("vkGetPhysicalDeviceFeatures2KHR"));
+		if (getFeatures2 == nullptr) {
+			return false;
+		}
+
+		DescriptorIndexingFeatures indexing = DescriptorIndexingFeatures();
+		indexing.sType = DescriptorIndexingFeaturesType;
+		PhysicalDeviceFeatures2 features = PhysicalDeviceFeatures2();
+		features.sType = PhysicalDeviceFeatures2Type;
+		features.pNext = &indexing;
+		getFeatures2(static_cast<VkPhysicalDevice>(physicalDevice), &features);
+
+		return indexing.shaderSampledImageArrayNonUniformIndexing && indexing.shaderStorageBufferArrayNonUniformIndexing && indexing.descriptorBindingSampledImageUpdateAfterBind && indexing.descriptorBindingStorageBufferUpdateAfterBind && indexing.descriptorBindingUpdateUnusedWhilePending && indexing.descriptorBindingPartiallyBound && indexing.runtimeDescriptorArray;
+	}
+
+	DescriptorIndexingFeatures DescriptorHeap::RequiredFeatures() {
+		DescriptorIndexingFeatures indexing = DescriptorIndexingFeatures();
+		indexing.sType = DescriptorIndexingFeaturesType;
+		indexing.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+		indexing.shaderStorageBufferArrayNonUniformIndexing = VK_TRUE;
+		indexing.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+		indexing.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+		indexing.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+		indexing.descriptorBindingPartiallyBound = VK_TRUE;
+		indexing.runtimeDescriptorArray = VK_TRUE;
+		return indexing;
+	}
+
+	DescriptorHeap::DescriptorHeap(vk::Device device, bool bindless, uint32_t framesInFlight) {
+		this->device = device;
+		this->bindless = bindless;
+		this->framesInFlight = framesInFlight;
+
+		// An update-after-bind set counts against its own limits, and any device with the features we
+		// ask for has to allow at least 500000 of each, so the whole heap always fits.
+		this->textureCapacity = bindless ? MaxTextures : 1;
+		this->bufferCapacity = bindless ? MaxBuffers : 1;
+
+		vk::DescriptorSetLayoutBinding bindings[2] = {
+			vk::DescriptorSetLayoutBinding(TextureBinding, vk::DescriptorType::eCombinedImageSampler, textureCapacity, vk::ShaderStageFlagBits::eAll),
+			vk::DescriptorSetLayoutBinding(BufferBinding, vk::DescriptorType::eStorageBuffer, bufferCapacity, vk::ShaderStageFlagBits::eAll)
+		};
+		vk::DescriptorSetLayoutCreateInfo layoutInfo = vk::DescriptorSetLayoutCreateInfo();
+		layoutInfo.setBindingCount(2);
+		layoutInfo.setPBindings(bindings);
+
+		uint32_t setCount = bindless ? 1 : MaxMaterials;
+		vk::DescriptorPoolSize poolSizes[2] = {
+			vk::DescriptorPoolSize(vk::DescriptorType::eCombinedImageSampler, textureCapacity * setCount),
+			vk::DescriptorPoolSize(vk::DescriptorType::eStorageBuffer, bufferCapacity * setCount)
+		};
+		vk::DescriptorPoolCreateInfo poolInfo = vk::DescriptorPoolCreateInfo();
+		poolInfo.setMaxSets(setCount);
+		poolInfo.setPoolSizeCount(2);
+		poolInfo.setPPoolSizes(poolSizes);
+
+		// Update-after-bind lets us write new resources into the heap while frames using it are in
+		// flight, and partially bound means the empty slots don't need anything in them. The headers
+		// don't have names for these flags, so they go in as the raw bits.
+		const VkFlags bindingFlags[2] = {
+			BindingUpdateAfterBind | BindingUpdateUnusedWhilePending | BindingPartiallyBound,
+			BindingUpdateAfterBind | BindingUpdateUnusedWhilePending | BindingPartiallyBound
+		};
+		DescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo = DescriptorSetLayoutBindingFlagsCreateInfo();
+		bindingFlagsInfo.sType = BindingFlagsCreateInfoType;
+		bindingFlagsInfo.bindingCount = 2;
+		bindingFlagsInfo.pBindingFlags = bindingFlags;
+		if (bindless) {
+			layoutInfo.setFlags(vk::DescriptorSetLayoutCreateFlags(static_cast<vk::DescriptorSetLayoutCreateFlagBits>(LayoutUpdateAfterBindPool)));
+			layoutInfo.setPNext(&bindingFlagsInfo);
+			poolInfo.setFlags(vk::DescriptorPoolCreateFlags(static_cast<vk::DescriptorPoolCreateFlagBits>(PoolUpdateAfterBind)));
+		}
+
+		layout = device.createDescriptorSetLayout(layoutInfo);
+		pool = device.createDescriptorPool(poolInfo);
+
+		if (bindless) {
+			heapSet = device.allocateDescriptorSets(vk::DescriptorSetAllocateInfo(pool, 1, &layout))[0];
+		}
+
+		// Materials never move or change once made, so draws can read them without taking the lock.
+		materials.reserve(MaxMaterials);
+	}
+
+	DescriptorHeap::~DescriptorHeap() {
+		device.destroyDescriptorPool(pool);
+		device.destroyDescriptorSetLayout(layout);
+	}
+
+	uint32_t DescriptorHeap::AddTexture(vk::ImageView view, vk::Sampler sampler, vk::ImageLayout imageLayout) {
+		std::lock_guard<std::mutex> lock(mutex);
+		vk::DescriptorImageInfo info(sampler, view, imageLayout);
+
+		uint32_t index;
+		if (!freeTextures.empty()) {
+			index = freeTextures.back();
+			freeTextures.pop_back();
+			textures[index] = info;
+		} else {
+			// Without bindless the heap is just a list for materials to copy from, so it can grow freely.
+			if (bindless && textures.size() == textureCapacity) {
+				throw std::runtime_error("The descriptor heap is out of texture slots.");
+			}
+			index = static_cast<uint32_t>(textures.size());
+			textures.push_back(info);
+		}
+
+		if (bindless) {
+			WriteTexture(heapSet, index, info);
+		}
+		return index;
+	}
+
+	uint32_t DescriptorHeap::AddBuffer(vk::Buffer buffer, vk::DeviceSize offset, vk::DeviceSize range) {
+		std::lock_guard<std::mutex> lock(mutex);
+		vk::DescriptorBufferInfo info(buffer, offset, range);
+
+		uint32_t index;
+		if (!freeBuffers.empty()) {
+			index = freeBuffers.back();
+			freeBuffers.pop_back();
+			buffers[index] = info;
+		} else {
+			if (bindless && buffers.size() == bufferCapacity) {
+				throw std::runtime_error("The descriptor heap is out of buffer slots.");
+			}
+			index = static_cast<uint32_t>(buffers.size());
+			buffers.push_back(info);
+		}
+
+		if (bindless) {
+			WriteBuffer(heapSet, index, info);
+		}
+		return index;
+	}
+
+	void DescriptorHeap::RemoveTexture(uint32_t index) {
+		std::lock_guard<std::mutex> lock(mutex);
+		pendingFrees.push_back({ index, framesInFlight, true });
+	}
+
+	void DescriptorHeap::RemoveBuffer(uint32_t index) {
+		std::lock_guard<std::mutex> lock(mutex);
+		pendingFrees.push_back({ index, framesInFlight, false });
+	}
+
+	uint32_t DescriptorHeap::CreateMaterial(uint32_t texture, uint32_t buffer) {
+		std::lock_guard<std::mutex> lock(mutex);
+		if (materials.size() == MaxMaterials) {
+			throw std::runtime_error("Too many materials have been created.");
+		}
+
+		Material material;
+		material.texture = texture;
+		material.buffer = buffer;
+
+		// The fallback copies the material's resources into a set of its own, once, up front. A binding
+		// that's left empty must not be used by the shaders that draw with it.
+		if (!bindless) {
+			material.set = device.allocateDescriptorSets(vk::DescriptorSetAllocateInfo(pool, 1, &layout))[0];
+			if (texture != InvalidIndex) {
+				WriteTexture(material.set, 0, textures[texture]);
+			}
+			if (buffer != InvalidIndex) {
+				WriteBuffer(material.set, 0, buffers[buffer]);
+			}
+		}
+
+		materials.push_back(material);
+		return static_cast<uint32_t>(materials.size() - 1);
+	}
+
+	DrawIndices DescriptorHeap::Indices(uint32_t material) {
+		DrawIndices indices = DrawIndices();
+		indices.material = material;
+		if (bindless) {
+			indices.texture = materials[material].texture;
+			indices.buffer = materials[material].buffer;
+		}
+		return indices;
+	}
+
+	void DescriptorHeap::BeginFrame() {
+		std::lock_guard<std::mutex> lock(mutex);
+		for (size_t i = 0; i < pendingFrees.size();) {
+			if (--pendingFrees[i].framesLeft == 0) {
+				(pendingFrees[i].texture ? freeTextures : freeBuffers).push_back(pendingFrees[i].index);
+				pendingFrees[i] = pendingFrees.back();
+				pendingFrees.pop_back();
+			} else {
+				++i;
+			}
+		}
+	}
+
+	void DescriptorHeap::BindHeap(vk::CommandBuffer commandBuffer, vk::PipelineBindPoint bindPoint, vk::PipelineLayout pipelineLayout) {
+		if (bindless) {
+			commandBuffer.bindDescriptorSets(bindPoint, pipelineLayout, 0, heapSet, nullptr);
+		}
+	}
+
+	void DescriptorHeap::Push(vk::CommandBuffer commandBuffer, vk::PipelineBindPoint bindPoint, vk::PipelineLayout pipelineLayout, uint32_t material) {
+		DrawIndices indices = Indices(material);
+		if (!bindless) {
+			commandBuffer.bindDescriptorSets(bindPoint, pipelineLayout, 0, materials[material].set, nullptr);
+		}
+		commandBuffer.pushConstants(pipelineLayout, vk::ShaderStageFlagBits::eAll, 0, sizeof(indices), &indices);
+	}
+
+	vk::PipelineLayout DescriptorHeap::CreatePipelineLayout() {
+		vk::PushConstantRange pushConstants(vk::ShaderStageFlagBits::eAll, 0, sizeof(DrawIndices));
+		vk::PipelineLayoutCreateInfo layoutInfo = vk::PipelineLayoutCreateInfo();
+		layoutInfo.setSetLayoutCount(1);
+		layoutInfo.setPSetLayouts(&layout);
+		layoutInfo.setPushConstantRangeCount(1);
+		layoutInfo.setPPushConstantRanges(&pushConstants);
+		return device.createPipelineLayout(layoutInfo);
+	}
+
+	vk::DescriptorSetLayout DescriptorHeap::Layout() {
+		return layout;
+	}
+
+	bool DescriptorHeap::Bindless() {
+		return bindless;
+	}
+
+	void DescriptorHeap::WriteTexture(vk::DescriptorSet set, uint32_t element, const vk::DescriptorImageInfo& info) {
+		vk::WriteDescriptorSet write = vk::WriteDescriptorSet();
+		write.setDstSet(set);
+		write.setDstBinding(TextureBinding);
+		write.setDstArrayElement(element);
+		write.setDescriptorCount(1);
+		write.setDescriptorType(vk::DescriptorType::eCombinedImageSampler);
+		write.setPImageInfo(&info);
+		device.updateDescriptorSets(write, nullptr);
+	}
+
+	void DescriptorHeap::WriteBuffer(vk::DescriptorSet set, uint32_t element, const vk::DescriptorBufferInfo& info) {
+		vk::WriteDescriptorSet write = vk::WriteDescriptorSet();
+		write.setDstSet(set);
+		write.setDstBinding(BufferBinding);
+		write.setDstArrayElement(element);
+		write.setDescriptorCount(1);
+		write.setDescriptorType(vk::DescriptorType::eStorageBuffer);
+		write.setPBufferInfo(&info);
+		device.updateDescriptorSets(write, nullptr);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <vulkan/vulkan.hpp>
+
+namespace Biendeo::VulkanGame {
+	// What each draw pushes so its shaders can find their resources.
+	struct DrawIndices {
+		uint32_t texture;
+		uint32_t buffer;
+		uint32_t material;
+		uint32_t padding;
+	};
+
+	// VK_EXT_descriptor_indexing came out after the 1.0.30 headers we build against, so this is its
+	// VkPhysicalDeviceDescriptorIndexingFeaturesEXT written out by hand, member for member.
+	struct DescriptorIndexingFeatures {
+		VkStructureType sType;
+		void* pNext;
+		VkBool32 shaderInputAttachmentArrayDynamicIndexing;
+		VkBool32 shaderUniformTexelBufferArrayDynamicIndexing;
+		VkBool32 shaderStorageTexelBufferArrayDynamicIndexing;
+		VkBool32 shaderUniformBufferArrayNonUniformIndexing;
+		VkBool32 shaderSampledImageArrayNonUniformIndexing;
+		VkBool32 shaderStorageBufferArrayNonUniformIndexing;
+		VkBool32 shaderStorageImageArrayNonUniformIndexing;
+		VkBool32 shaderInputAttachmentArrayNonUniformIndexing;
+		VkBool32 shaderUniformTexelBufferArrayNonUniformIndexing;
+		VkBool32 shaderStorageTexelBufferArrayNonUniformIndexing;
+		VkBool32 descriptorBindingUniformBufferUpdateAfterBind;
+		VkBool32 descriptorBindingSampledImageUpdateAfterBind;
+		VkBool32 descriptorBindingStorageImageUpdateAfterBind;
+		VkBool32 descriptorBindingStorageBufferUpdateAfterBind;
+		VkBool32 descriptorBindingUniformTexelBufferUpdateAfterBind;
+		VkBool32 descriptorBindingStorageTexelBufferUpdateAfterBind;
+		VkBool32 descriptorBindingUpdateUnusedWhilePending;
+		VkBool32 descriptorBindingPartiallyBound;
+		VkBool32 descriptorBindingVariableDescriptorCount;
+		VkBool32 runtimeDescriptorArray;
+	};
+
+	// Every texture and buffer goes into one big descriptor set and is looked up by index, so draws
+	// never bind or update descriptors of their own. Devices without descriptor indexing get a small set
+	// per material instead. Those sets are laid out the same way, with arrays of one and indices of
+	// zero, so the same shaders work on both.
+	class DescriptorHeap {
+		public:
+		static const uint32_t MaxTextures = 4096;
+		static const uint32_t MaxBuffers = 1024;
+		static const uint32_t MaxMaterials = 1024;
+		static const uint32_t InvalidIndex = UINT32_MAX;
+
+		// The instance needs this one enabled to ask whether a device can do bindless at all, and the
+		// device needs the other one enabled to actually do it.
+		static const char* const InstanceExtension;
+		static const char* const DeviceExtension;
+
+		// Whether the device can do all of this bindless. Only ask if the instance extension is enabled.
+		static bool Supported(vk::Instance instance, vk::PhysicalDevice physicalDevice);
+
+		// What to chain into device creation when it's supported.
+		static DescriptorIndexingFeatures RequiredFeatures();
+
+		DescriptorHeap(vk::Device device, bool bindless, uint32_t framesInFlight);
+		~DescriptorHeap();
+
+		// An index stays the same for as long as its resource is in the heap.
+		uint32_t AddTexture(vk::ImageView view, vk::Sampler sampler, vk::ImageLayout layout = vk::ImageLayout::eShaderReadOnlyOptimal);
+		uint32_t AddBuffer(vk::Buffer buffer, vk::DeviceSize offset, vk::DeviceSize range);
+		void RemoveTexture(uint32_t index);
+		void RemoveBuffer(uint32_t index);
+
+		uint32_t CreateMaterial(uint32_t texture, uint32_t buffer);
+		DrawIndices Indices(uint32_t material);
+
+		// Removed indices are only handed out again once every frame that might have used them is done,
+		// so this has to be called once a frame.
+		void BeginFrame();
+
+		// Bind the heap once per command buffer, then push once per draw. Without bindless, the push is
+		// what binds the material's own set.
+		void BindHeap(vk::CommandBuffer commandBuffer, vk::PipelineBindPoint bindPoint, vk::PipelineLayout layout);
+		void Push(vk::CommandBuffer commandBuffer, vk::PipelineBindPoint bindPoint, vk::PipelineLayout layout, uint32_t material);
+
+		// A pipeline layout with the heap in set zero and room for the draw indices.
+		vk::PipelineLayout CreatePipelineLayout();
+
+		vk::DescriptorSetLayout Layout();
+		bool Bindless();
+
+		private:
+		struct Material {
+			uint32_t texture;
+			uint32_t buffer;
+			vk::DescriptorSet set;
+		};
+
+		struct PendingFree {
+			uint32_t index;
+			uint32_t framesLeft;
+			bool texture;
+		};
+
+		vk::Device device;
+		bool bindless;
+		uint32_t framesInFlight;
+		uint32_t textureCapacity;
+		uint32_t bufferCapacity;
+
+		vk::DescriptorSetLayout layout;
+		vk::DescriptorPool pool;
+		vk::DescriptorSet heapSet;
+
+		std::mutex mutex;
+		std::vector<vk::DescriptorImageInfo> textures;
+		std::vector<vk::DescriptorBufferInfo> buffers;
+		std::vector<uint32_t> freeTextures;
+		std::vector<uint32_t> freeBuffers;
+		std::vector<PendingFree> pendingFrees;
+		std::vector<Material> materials;
+
+		void WriteTexture(vk::DescriptorSet set, uint32_t element, const vk::DescriptorImageInfo& info);
+		void WriteBuffer(vk::DescriptorSet set, uint32_t element, const vk::DescriptorBufferInfo& info);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include "DeviceScore.h"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+#include "QueueFamilies.h"
+
+namespace Biendeo::VulkanGame {
+	namespace {
+		// Device type matters far more than anything else, so it's weighted to always win over the rest.
+		// Even an integrated GPU that reports a huge shared heap would need terabytes more than a
+		// discrete one to catch up.
+		int64_t TypeScore(vk::PhysicalDeviceType type) {
+			switch (type) {
+				case vk::PhysicalDeviceType::eDiscreteGpu: return 10000000;
+				case vk::PhysicalDeviceType::eIntegratedGpu: return 5000000;
+				case vk::PhysicalDeviceType::eVirtualGpu: return 2000000;
+				case vk::PhysicalDeviceType::eCpu: return 100000;
+				default: return 0;
+			}
+		}
+
+		const char* TypeName(vk::PhysicalDeviceType type) {
+			switch (type) {
+				case vk::PhysicalDeviceType::eDiscreteGpu: return "discrete GPU";
+				case vk::PhysicalDeviceType::eIntegratedGpu: return "integrated GPU";
+				case vk::PhysicalDeviceType::eVirtualGpu: return "virtual GPU";
+				case vk::PhysicalDeviceType::eCpu: return "software renderer";
+				default: return "unknown device type";
+			}
+		}
+	}
+
+	bool DeviceScore::Usable() {
+		return score >= 0;
+	}
+
+	DeviceScore DeviceScore::Evaluate(vk::PhysicalDevice physicalDevice, vk::SurfaceKHR surface, const std::vector<const char*>& requiredExtensions, const vk::PhysicalDeviceFeatures& requiredFeatures) {
+		DeviceScore result;
+		result.score = -1;
+
+		QueueFamilies families = QueueFamilies::Select(physicalDevice, surface);
+		if (!families.HasGraphics()) {
+			result.reason = surface ? "no graphics queue that can present" : "no graphics queue";
+			return result;
+		}
+
+		std::vector<vk::ExtensionProperties> extensions = physicalDevice.enumerateDeviceExtensionProperties();
+		for (const char* required : requiredExtensions) {
+			bool found = false;
+			for (vk::ExtensionProperties& extension : extensions) {
+				if (std::strcmp(extension.extensionName, required) == 0) {
+					found = true;
+					break;
+				}
+			}
+			if (!found) {
+				result.reason = std::string("missing ") + required;
+				return result;
+			}
+		}
+
+		// The features struct is nothing but a run of booleans, so it can be compared one by one.
+		vk::PhysicalDeviceFeatures features = physicalDevice.getFeatures();
+		const vk::Bool32* wanted = reinterpret_cast<const vk::Bool32*>(&requiredFeatures);
+		const vk::Bool32* supported = reinterpret_cast<const vk::Bool32*>(&features);
+		for (size_t i = 0; i < sizeof(vk::PhysicalDeviceFeatures) / sizeof(vk::Bool32); ++i) {
+			if (wanted[i] && !supported[i]) {
+				result.reason = "missing a required feature";
+				return result;
+			}
+		}
+
+		vk::PhysicalDeviceProperties properties = physicalDevice.getProperties();
+		vk::PhysicalDeviceMemoryProperties memory = physicalDevice.getMemoryProperties();
+		vk::DeviceSize deviceLocal = 0;
+		for (uint32_t i = 0; i < memory.memoryHeapCount; ++i) {
+			if (memory.memoryHeaps[i].flags & vk::MemoryHeapFlagBits::eDeviceLocal) {
+				deviceLocal = std::max(deviceLocal, memory.memoryHeaps[i].size);
+			}
+		}
+
+		// One point per MB of VRAM. Between two devices of the same type that's what usually decides it,
+		// since a couple of GB outweighs the queue bonuses below.
+		uint64_t deviceLocalMB = deviceLocal / (1024ull * 1024ull);
+		result.score = TypeScore(properties.deviceType) + static_cast<int64_t>(deviceLocalMB);
+
+		std::ostringstream reason;
+		reason << TypeName(properties.deviceType) << ", " << deviceLocalMB << "MB device-local";
+		if (families.HasAsyncCompute()) {
+			result.score += 2000;
+			reason << ", async compute";
+		}
+		if (families.HasDedicatedTransfer()) {
+			result.score += 1000;
+			reason << ", dedicated transfer";
+		}
+		result.reason = reason.str();
+
+		return result;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <vulkan/vulkan.hpp>
+
+namespace Biendeo::VulkanGame {
+	// How well a physical device suits the engine, so we don't just take whichever the driver lists first.
+	struct DeviceScore {
+		// Zero or more means the device can run the engine; higher is better.
+		int64_t score;
+
+		// A short human-readable account of what went into the score, or why the device can't be used.
+		std::string reason;
+
+		bool Usable();
+
+		// Pass a null surface when there's nothing to present to.
+		static DeviceScore Evaluate(vk::PhysicalDevice physicalDevice, vk::SurfaceKHR surface, const std::vector<const char*>& requiredExtensions, const vk::PhysicalDeviceFeatures& requiredFeatures);
+	};
+}
\ No newline at end of file
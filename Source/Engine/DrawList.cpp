@@ -0,0 +1,27 @@
+#include "DrawList.h"
+
+namespace Biendeo::VulkanGame {
+	void DrawList::Clear() {
+		// This keeps the capacity, so a steady scene stops allocating after the first frame.
+		items.clear();
+	}
+
+	void DrawList::Add(const DrawItem& item) {
+		items.push_back(item);
+	}
+
+	size_t DrawList::Size() {
+		return items.size();
+	}
+
+	const DrawItem& DrawList::operator[](size_t index) {
+		return items[index];
+	}
+
+	void DrawList::Partition(uint32_t count, uint32_t index, size_t& begin, size_t& end) {
+		size_t size = items.size() / count;
+		size_t remainder = items.size() % count;
+		begin = index * size + (index < remainder ? index : remainder);
+		end = begin + size + (index < remainder ? 1 : 0);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Biendeo::VulkanGame {
+	// Something to draw this frame. Positions are fractions of the render area, so the list doesn't care
+	// how big the window is.
+	struct DrawItem {
+		float x;
+		float y;
+		float width;
+		float height;
+		std::array<float, 4> colour;
+	};
+
+	// Everything the cull stage decided to draw, in the order it should be drawn.
+	class DrawList {
+		public:
+		void Clear();
+		void Add(const DrawItem& item);
+
+		size_t Size();
+		const DrawItem& operator[](size_t index);
+
+		// Splits the list into count contiguous ranges that differ in size by at most one. The same
+		// partition always gets the same range, whichever thread ends up recording it.
+		void Partition(uint32_t count, uint32_t index, size_t& begin, size_t& end);
+
+		private:
+		std::vector<DrawItem> items;
+	};
+}
\ No newline at end of file
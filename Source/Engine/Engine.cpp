@@ -1,11 +1,81 @@
 #include "Engine.h"
 
-#include <iostream>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <csignal>
+#include <limits>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
 namespace Biendeo::VulkanGame {
+	namespace {
+		// A compute shader that does nothing, written out as SPIR-V by hand since there's no shader
+		// compiler in the build yet. It's enough to put a real pipeline through the cache and the
+		// compile threads.
+		const uint32_t IdleComputeShader[] = {
+			0x07230203, 0x00010000, 0x00000000, 0x00000005, 0x00000000,
+			0x00020011, 0x00000001,                                     // OpCapability Shader
+			0x0003000E, 0x00000000, 0x00000001,                         // OpMemoryModel Logical GLSL450
+			0x0005000F, 0x00000005, 0x00000001, 0x6E69616D, 0x00000000, // OpEntryPoint GLCompute %1 "main"
+			0x00060010, 0x00000001, 0x00000011, 0x00000001, 0x00000001, 0x00000001, // OpExecutionMode %1 LocalSize 1 1 1
+			0x00020013, 0x00000002,                                     // %2 = OpTypeVoid
+			0x00030021, 0x00000003, 0x00000002,                         // %3 = OpTypeFunction %2
+			0x00050036, 0x00000002, 0x00000001, 0x00000000, 0x00000003, // %1 = OpFunction %2 None %3
+			0x000200F8, 0x00000004,                                     // %4 = OpLabel
+			0x000100FD,                                                 // OpReturn
+			0x00010038                                                  // OpFunctionEnd
+		};
+
+		struct FrameConstants {
+			float time;
+			float alpha;
+			uint32_t frame;
+			uint32_t drawCount;
+		};
+
+		// Per-frame constants never get near this; it's there for per-draw data as the scene grows.
+		const vk::DeviceSize UniformRegionSize = 1024ull * 1024ull;
+
+		// Headless runs have no window to close, so without /FRAMES or /BENCHMARK they stop after this many.
+		const uint64_t DefaultHeadlessFrames = 600ull;
+
+		// Set from a signal handler when the process is asked to stop, so the frame loop can finish the
+		// frame it's on and shut down properly.
+		volatile std::sig_atomic_t stopRequested = 0;
+
+		void RequestStop(int) {
+			stopRequested = 1;
+		}
+
+		// Reads a whole number argument into value. If the text isn't one, or it's outside [minimum,
+		// maximum], value keeps its default and a warning is kept for once the logger exists.
+		template <typename T>
+		bool ParseNumberArgument(const std::string& flag, const std::string& text, long long minimum, long long maximum, T& value, std::vector<std::string>& warnings) {
+			long long parsed = 0;
+			size_t used = 0;
+			try {
+				parsed = std::stoll(text, &used);
+			} catch (const std::invalid_argument&) {
+				used = 0;
+			} catch (const std::out_of_range&) {
+				used = 0;
+			}
+
+			if (used == 0 || used != text.size() || parsed < minimum || parsed > maximum) {
+				warnings.push_back(flag + " " + text + " isn't a whole number from " + std::to_string(minimum) + " to " + std::to_string(maximum) + ", so it's been ignored.");
+				return false;
+			}
+			value = static_cast<T>(parsed);
+			return true;
+		}
+	}
+
 	Engine::Engine(int argc, char* argv[]) {
+		this->constructionStart = FramePacer::Clock::now();
+		this->startup = new StartupProfile(constructionStart);
+
 		// Start off by turning the arguments into a vector.
 		std::vector<std::string> arguments(argc);
 		for (int i = 0; i < argc; ++i) {
@@ -13,198 +83,1159 @@ namespace Biendeo::VulkanGame {
 		}
 
 		// Set up the command-line variables.
-		this->verbose = true;
+		LogLevel logLevel = LogLevel::Debug;
+		this->tickRate = 60;
+		this->maxTicksPerFrame = 5;
+		this->pacing = PacingMode::Hybrid;
+		this->pacingExplicit = false;
+		this->statisticsPath = "";
+		this->headless = false;
+		this->frameLimit = 0ull;
+		this->width = 800;
+		this->height = 600;
+		this->window = nullptr;
+		this->vidmode = nullptr;
+		this->offscreenTarget = nullptr;
+		this->allocator = nullptr;
+		this->deviceOverride = -1;
+		this->pipelineCache = nullptr;
+		this->pipelineCachePath = "pipeline.cache";
+		this->coldPipelineCache = false;
+		this->pipelines = nullptr;
+		this->descriptors = nullptr;
+		this->uniforms = nullptr;
+		this->frameMaterial = DescriptorHeap::InvalidIndex;
+		this->physicalDeviceProperties2 = false;
+		this->bindless = false;
+		this->idlePipeline = PipelineManager::InvalidPipeline;
+		this->swapchain = nullptr;
+		this->renderGraph = nullptr;
+		this->backbuffer = RenderGraph::InvalidResource;
+		this->presentMode = vk::PresentModeKHR::eMailbox;
+		this->swapImageCount = 3;
+		this->currentImage = 0;
+		this->frameSkipped = false;
+		this->drawCount = 1024;
+		this->swapchainStale = false;
+		this->benchmark = nullptr;
+		this->simulationTime = 0.0;
+		this->previousSimulationTime = 0.0;
+		this->renderTime = 0.0;
+		this->updateEnd = 0.0;
+		unsigned threadCount = 0;
+		this->framesInFlight = 2;
+		this->frames = nullptr;
+		this->profiler = nullptr;
+		this->pipelineStatistics = false;
+		this->gpuTimingReady = false;
+		this->instanceReady = false;
+		this->pipelineCacheFile.found = false;
+		uint64_t benchmarkFrames = 0ull;
+		std::string reportPath = "benchmark.json";
+		std::vector<std::string> argumentWarnings;
 
-		for (const std::string& arg : arguments) {
-			// The /Q flag makes this program not print output.
+		for (size_t i = 0; i < arguments.size(); ++i) {
+			const std::string& arg = arguments[i];
+			// The /Q flag makes this program only print errors.
 			if (arg == "/Q") {
-				verbose = false;
+				logLevel = LogLevel::Error;
+			}
+			// The /TICKRATE flag sets how many times a second the simulation updates.
+			if (arg == "/TICKRATE" && i + 1 < arguments.size()) {
+				ParseNumberArgument(arg, arguments[++i], 1, std::numeric_limits<short>::max(), tickRate, argumentWarnings);
+			}
+			// The /MAXTICKS flag sets how many ticks a single frame can run to catch up.
+			if (arg == "/MAXTICKS" && i + 1 < arguments.size()) {
+				ParseNumberArgument(arg, arguments[++i], 1, std::numeric_limits<short>::max(), maxTicksPerFrame, argumentWarnings);
+			}
+			// The /PACING flag picks how we wait for the next frame (NONE, SLEEP, HYBRID or SPIN).
+			if (arg == "/PACING" && i + 1 < arguments.size()) {
+				// Only a real mode counts as asking for one, so a typo still gets the FIFO default.
+				const std::string& mode = arguments[++i];
+				if (FramePacer::ParseMode(mode, pacing)) {
+					pacingExplicit = true;
+				} else {
+					argumentWarnings.push_back(arg + " " + mode + " isn't NONE, SLEEP, HYBRID or SPIN, so it's been ignored.");
+				}
+			}
+			// The /PRESENTMODE flag picks how frames reach the screen (FIFO, FIFO_RELAXED, MAILBOX or IMMEDIATE).
+			if (arg == "/PRESENTMODE" && i + 1 < arguments.size()) {
+				const std::string& mode = arguments[++i];
+				if (!Swapchain::ParsePresentMode(mode, presentMode)) {
+					argumentWarnings.push_back(arg + " " + mode + " isn't FIFO, FIFO_RELAXED, MAILBOX or IMMEDIATE, so it's been ignored.");
+				}
 			}
+			// The /SWAPIMAGES flag sets how many images the swapchain asks for.
+			if (arg == "/SWAPIMAGES" && i + 1 < arguments.size()) {
+				ParseNumberArgument(arg, arguments[++i], 1, std::numeric_limits<uint32_t>::max(), swapImageCount, argumentWarnings);
+			}
+			// The /STATS flag writes frame timings to <path>.csv and <path>.json when the program closes.
+			if (arg == "/STATS" && i + 1 < arguments.size()) {
+				statisticsPath = arguments[++i];
+			}
+			// The /HEADLESS flag renders to an offscreen image without opening a window.
+			if (arg == "/HEADLESS") {
+				headless = true;
+			}
+			// The /FRAMES flag stops the run after that many frames.
+			if (arg == "/FRAMES" && i + 1 < arguments.size()) {
+				ParseNumberArgument(arg, arguments[++i], 1, std::numeric_limits<long long>::max(), frameLimit, argumentWarnings);
+			}
+			// The /BENCHMARK flag runs exactly that many frames as fast as possible, then writes a report.
+			if (arg == "/BENCHMARK" && i + 1 < arguments.size()) {
+				ParseNumberArgument(arg, arguments[++i], 1, std::numeric_limits<long long>::max(), benchmarkFrames, argumentWarnings);
+			}
+			// The /THREADS flag sets how many threads run jobs, including the main thread.
+			if (arg == "/THREADS" && i + 1 < arguments.size()) {
+				ParseNumberArgument(arg, arguments[++i], 0, std::numeric_limits<unsigned>::max(), threadCount, argumentWarnings);
+			}
+			// The /FRAMESINFLIGHT flag sets how many frames the CPU can get ahead of the GPU (1 to 3).
+			if (arg == "/FRAMESINFLIGHT" && i + 1 < arguments.size()) {
+				const uint32_t maxFramesInFlight = FrameRing::MaxFramesInFlight;
+				ParseNumberArgument(arg, arguments[++i], 1, maxFramesInFlight, framesInFlight, argumentWarnings);
+			}
+			// The /DRAWS flag sets how many tiles the scene draws each frame.
+			if (arg == "/DRAWS" && i + 1 < arguments.size()) {
+				ParseNumberArgument(arg, arguments[++i], 0, std::numeric_limits<uint32_t>::max(), drawCount, argumentWarnings);
+			}
+			// The /DEVICE flag picks a physical device by number instead of scoring them.
+			if (arg == "/DEVICE" && i + 1 < arguments.size()) {
+				ParseNumberArgument(arg, arguments[++i], 0, std::numeric_limits<int>::max(), deviceOverride, argumentWarnings);
+			}
+			// The /PIPELINECACHE flag sets where compiled pipelines are kept between runs.
+			if (arg == "/PIPELINECACHE" && i + 1 < arguments.size()) {
+				pipelineCachePath = arguments[++i];
+			}
+			// The /COLDCACHE flag ignores the pipeline cache on disk, to see how long startup takes without it.
+			if (arg == "/COLDCACHE") {
+				coldPipelineCache = true;
+			}
+			// The /REPORT flag sets where the benchmark report goes.
+			if (arg == "/REPORT" && i + 1 < arguments.size()) {
+				reportPath = arguments[++i];
+			}
+		}
+
+		// Everything gets printed through this so the frame loop never waits on the console.
+		logger = new Logger(logLevel);
+		for (const std::string& warning : argumentWarnings) {
+			logger->Warning("%s\n", warning.c_str());
+		}
+
+		{
+			StartupScope scope(startup, "job threads");
+			jobs = new JobSystem(threadCount);
 		}
+		logger->Info("Running jobs on %u threads.\n", jobs->ThreadCount());
 
-		// Then we set up our program.
-		if (!InitialiseGLFW()) {
-			abort();
+		// One partition per thread keeps everyone busy without splitting the list finer than it needs.
+		partitions.resize(jobs->ThreadCount());
+		for (uint32_t i = 0; i < partitions.size(); ++i) {
+			partitions[i].engine = this;
+			partitions[i].index = i;
+			partitions[i].count = static_cast<uint32_t>(partitions.size());
 		}
 
-		if (!CheckVulkanCompatability()) {
-			abort();
+		// Then we set up our program. Headless runs never touch GLFW, so they work without a display.
+		if (!headless) {
+			StartupScope scope(startup, "GLFW");
+			if (!InitialiseGLFW()) {
+				Abort();
+			}
+
+			if (!CheckVulkanCompatability()) {
+				Abort();
+			}
 		}
 
-		if (!InitialiseWindow()) {
-			abort();
+		// The instance and the pipeline cache file don't depend on each other or on the window, so they
+		// happen on other threads while this one makes the window (GLFW only lets the main thread do
+		// that). Everything meets back up at the surface, which needs both the instance and the window.
+		JobCounter loaded;
+		jobs->Run(&Engine::InstanceJob, this, &loaded);
+		if (!coldPipelineCache) {
+			jobs->Run(&Engine::ReadPipelineCacheJob, this, &loaded);
 		}
 
-		// This prevents GLFW from swapping buffers until it's finished.
-		glfwSwapInterval(1);
+		if (!headless) {
+			StartupScope scope(startup, "window");
+			if (!InitialiseWindow()) {
+				Abort();
+			}
+		}
+
+		jobs->Wait(loaded);
+		if (!instanceReady) {
+			Abort();
+		}
+
+		// The surface has to exist before the device, since the queue we pick has to be able to present to it.
+		if (!headless) {
+			StartupScope scope(startup, "surface");
+			if (!InitialiseSurface()) {
+				Abort();
+			}
+		}
+
+		{
+			StartupScope scope(startup, "device");
+			if (!InitialiseDevice()) {
+				Abort();
+			}
+
+			// Everything that needs device memory gets it through here rather than straight from the driver.
+			allocator = new GpuAllocator(physicalDevice, device);
+		}
+
+		{
+			StartupScope scope(startup, "pipeline cache");
+			pipelineCache = new PipelineCache(physicalDevice, device, pipelineCachePath, pipelineCacheFile);
+			pipelineCacheFile.data.clear();
+		}
+		if (pipelineCache->State() == PipelineCacheState::Rejected) {
+			logger->Warning("Ignored the pipeline cache at %s: %s.\n", pipelineCachePath.c_str(), pipelineCache->RejectReason().c_str());
+		}
+
+		// Pipelines need the heap's layout, so it's made before the ring. Removed resources wait out the
+		// longest ring there could be, since we don't know how long this one will be yet.
+		descriptors = new DescriptorHeap(device, bindless, FrameRing::MaxFramesInFlight);
+
+		// Pipelines we know we'll need start compiling now, so they're done by the time the rest of
+		// startup is.
+		pipelineLayout = descriptors->CreatePipelineLayout();
+		pipelines = new PipelineManager(device, pipelineCache->Handle());
+		std::vector<PipelineRequest> prewarm = {
+			{ "idle", &Engine::BuildIdlePipeline, this }
+		};
+		pipelines->Prewarm(prewarm);
+		idlePipeline = pipelines->Request("idle", &Engine::BuildIdlePipeline, this);
+
+		{
+			StartupScope scope(startup, "render targets");
+			if (headless) {
+				offscreenTarget = new OffscreenTarget(allocator, width, height);
+				logger->Info("Rendering headless to a %ux%u offscreen image.\n", width, height);
+				InitialiseRenderPass(offscreenTarget->Format());
+			} else {
+				if (!InitialiseSwapchain()) {
+					Abort();
+				}
+				InitialiseRenderPass(swapchain->Format());
+			}
+			InitialiseFramebuffers();
+		}
+
+		FramePacer::Clock::time_point frameResourcesStart = FramePacer::Clock::now();
+		frames = new FrameRing(allocator, queueFamilies.graphics, framesInFlight, jobs->ThreadCount());
+		logger->Info("Using %u frames in flight.\n", frames->FramesInFlight());
+
+		profiler = new GpuProfiler(physicalDevice, device, queueFamilies.graphics, frames->FramesInFlight(), pipelineStatistics);
+		if (!profiler->Enabled()) {
+			logger->Warning("The graphics queue can't write timestamps, so GPU times won't be measured.\n");
+		}
+		logger->Info("Pipeline statistics are %s.\n", profiler->StatisticsEnabled() ? "on" : "not supported");
+
+		renderGraph = new RenderGraph(allocator, queueFamilies, computeQueue, frames->FramesInFlight());
+		BuildRenderGraph();
+
+		uniforms = new UniformAllocator(allocator, physicalDevice, frames->FramesInFlight(), UniformRegionSize);
+		frameMaterial = descriptors->CreateMaterial(DescriptorHeap::InvalidIndex, descriptors->AddBuffer(uniforms->Buffer(), 0, VK_WHOLE_SIZE));
+		startup->Record("frame resources", frameResourcesStart, FramePacer::Clock::now());
 
 		// This establishes a framerate.
 		// TODO: Custom based on argument?
-		framerate = new Framerate(vidmode->refreshRate);
+		framerate = new Framerate(headless ? 60 : vidmode->refreshRate, tickRate);
+		framerate->MaxTicksPerFrame(maxTicksPerFrame);
+		// FIFO presents already block until the next vblank, so waiting on top of that only adds latency.
+		bool displayPaced = !headless && (swapchain->PresentMode() == vk::PresentModeKHR::eFifo || swapchain->PresentMode() == vk::PresentModeKHR::eFifoRelaxed);
+		framerate->Pacing(displayPaced && !pacingExplicit ? PacingMode::None : pacing);
+
+		// This is the end of the loading screen, so anything still compiling gets waited on here.
+		FramePacer::Clock::time_point prewarmWait = FramePacer::Clock::now();
+		pipelines->WaitIdle();
+		startup->Record("pipeline prewarm wait", prewarmWait, FramePacer::Clock::now());
+		logger->Info("Prewarmed pipelines after waiting %.3fms; idle took %.3fms to compile.\n", std::chrono::duration<double>(FramePacer::Clock::now() - prewarmWait).count() * 1000.0, pipelines->CompileTime(idlePipeline) * 1000.0);
+		if (pipelines->State(idlePipeline) == PipelineState::Failed) {
+			logger->Warning("The idle pipeline failed to compile.\n");
+		}
+
+		// Benchmarks don't wait for anything, and step the simulation exactly one tick per frame so
+		// every run does the same work.
+		if (benchmarkFrames > 0) {
+			benchmark = new Benchmark(benchmarkFrames, reportPath);
+			framerate->Pacing(PacingMode::None);
+			framerate->FixedFrameDelta(framerate->TickDelta());
+			logger->Info("Benchmarking %llu frames.\n", static_cast<unsigned long long>(benchmarkFrames));
+		} else if (headless && frameLimit == 0ull) {
+			frameLimit = DefaultHeadlessFrames;
+		}
+		if (frameLimit > 0ull) {
+			logger->Info("Stopping after %llu frames.\n", static_cast<unsigned long long>(frameLimit));
+		}
 	}
 
 	Engine::~Engine() {
+		if (benchmark != nullptr) {
+			delete benchmark;
+		}
+
+		delete jobs;
+
 		if (framerate != nullptr) {
+			if (!statisticsPath.empty()) {
+				WriteStatistics();
+			}
 			delete framerate;
 		}
 
-		instance.destroySurfaceKHR(surface);
+		device.waitIdle();
+
+		if (frames != nullptr) {
+			delete frames;
+		}
+
+		if (profiler != nullptr) {
+			delete profiler;
+		}
+
+		if (renderGraph != nullptr) {
+			delete renderGraph;
+		}
+
+		DestroyFramebuffers();
+		device.destroyRenderPass(renderPass);
+
+		if (descriptors != nullptr) {
+			delete descriptors;
+		}
+
+		if (uniforms != nullptr) {
+			delete uniforms;
+		}
+
+		// The compile threads have to stop before the cache they use can be saved.
+		if (pipelines != nullptr) {
+			delete pipelines;
+			device.destroyPipelineLayout(pipelineLayout);
+		}
+
+		if (pipelineCache != nullptr) {
+			if (!pipelineCache->Save()) {
+				logger->Warning("Couldn't save the pipeline cache to %s.\n", pipelineCachePath.c_str());
+			}
+			delete pipelineCache;
+		}
+
+		if (swapchain != nullptr) {
+			delete swapchain;
+		}
+
+		if (offscreenTarget != nullptr) {
+			delete offscreenTarget;
+		}
+
+		if (allocator != nullptr) {
+			GpuMemoryStatistics memory = allocator->Statistics();
+			if (memory.allocations > 0) {
+				logger->Warning("%llu GPU allocations were never freed.\n", static_cast<unsigned long long>(memory.allocations));
+			}
+			delete allocator;
+		}
+
+		device.destroy();
+
+		if (!headless) {
+			instance.destroySurfaceKHR(surface);
+		}
 		instance.destroy();
 
-		glfwDestroyWindow(window);
+		if (!headless) {
+			glfwDestroyWindow(window);
+
+			glfwTerminate();
+		}
 
-		glfwTerminate();
+		delete logger;
+		delete startup;
 	}
 
 	void Engine::Run() {
-		while (true) {
-			DrawBuffer();
+		double startupTime = startup->Elapsed();
+		double runStart = framerate->Now();
+		logger->Info("Started up in %.3fms with a %s pipeline cache.\n", startupTime * 1000.0, PipelineCache::StateName(pipelineCache->State()));
+		LogStartup(startupTime);
+
+		// Counted from the start of construction to when the first frame was handed to the display (or
+		// submitted, when headless).
+		double timeToFirstFrame = 0.0;
+
+		// Ctrl+C, or being told to stop some other way, ends the run like closing the window does, so the
+		// statistics and report still get written.
+		std::signal(SIGINT, RequestStop);
+		std::signal(SIGTERM, RequestStop);
+
+		while (headless || !glfwWindowShouldClose(window)) {
+			if (benchmark != nullptr && benchmark->Complete()) {
+				break;
+			}
+			if (frameLimit > 0ull && framerate->FrameCount() >= frameLimit) {
+				break;
+			}
+			if (stopRequested) {
+				logger->Info("Asked to stop after %llu frames.\n", static_cast<unsigned long long>(framerate->FrameCount()));
+				break;
+			}
+
+			FrameTiming timing;
+			timing.frame = framerate->FrameCount();
+			double frameStart = framerate->Now();
+
+			if (!headless) {
+				glfwPollEvents();
+			}
+
+			// Update, culling and recording are a chain of jobs, so their work can spread across every
+			// core as it grows. Recording fans out into one job per partition of the draw list, and the
+			// main thread helps out while it waits for the chain to finish.
+			JobCounter updated, culled, begun, recorded, submitted;
+			jobs->Run(&Engine::UpdateJob, this, &updated);
+			jobs->Run(&Engine::CullJob, this, &culled, &updated);
+			jobs->Run(&Engine::BeginFrameJob, this, &begun, &culled);
+			for (RecordPartition& partition : partitions) {
+				jobs->Run(&Engine::RecordPartitionJob, &partition, &recorded, &begun);
+			}
+			jobs->Run(&Engine::SubmitJob, this, &submitted, &recorded);
+			jobs->Wait(submitted);
+			double drawEnd = framerate->Now();
+
 			framerate->SleepToNextSwapBuffer();
-			glfwSwapBuffers(window);
-			std::cout << "Frame " << framerate->FrameCount() << "\n";
+			double sleepEnd = framerate->Now();
+
+			// With FIFO this is where we actually wait for the display, so it shows up as present time.
+			if (!headless && !frameSkipped) {
+				if (!swapchain->Present(graphicsQueue, currentImage, frames->Current().renderFinished)) {
+					swapchainStale = true;
+				}
+			}
+			double presentEnd = framerate->Now();
+
+			if (timeToFirstFrame == 0.0) {
+				timeToFirstFrame = startup->Elapsed();
+				logger->Info("First frame went out %.3fms after startup began.\n", timeToFirstFrame * 1000.0);
+			}
+
+			if (swapchainStale) {
+				RecreateSwapchain();
+			}
+
+			logger->Debug("Frame %llu\n", static_cast<unsigned long long>(framerate->FrameCount()));
+
+			timing.update = updateEnd - frameStart;
+			timing.draw = drawEnd - updateEnd;
+			timing.sleep = sleepEnd - drawEnd;
+			timing.present = presentEnd - sleepEnd;
+			timing.total = presentEnd - frameStart;
+			timing.gpu = 0.0;
+			framerate->Statistics().Record(timing);
+			if (benchmark != nullptr) {
+				benchmark->Record(timing);
+			}
+
+			// This is an earlier frame's GPU time, which only just came back.
+			if (gpuTimingReady) {
+				framerate->Statistics().RecordGpu(gpuTiming.frame, gpuTiming.total);
+				if (benchmark != nullptr) {
+					benchmark->RecordGpu(gpuTiming.frame, gpuTiming.total);
+				}
+			}
+
 			framerate->UpdateDrawTimes();
 			framerate->IncrementFrameCount();
 		}
+
+		if (benchmark != nullptr) {
+			double elapsedTime = framerate->Now() - runStart;
+			MeasureRecordingScaling();
+			benchmark->RecordStartup(startup->Phases(), timeToFirstFrame);
+			std::string deviceName = physicalDevice.getProperties().deviceName;
+			if (benchmark->WriteReport(startupTime, elapsedTime, framerate->Statistics().HitchThreshold(), deviceName, PipelineCache::StateName(pipelineCache->State()))) {
+				logger->Info("Benchmark finished in %.3fs.\n", elapsedTime);
+			} else {
+				logger->Error("Couldn't write the benchmark report.\n");
+			}
+		}
+	}
+
+	void Engine::WriteStatistics() {
+		FrameStatistics& statistics = framerate->Statistics();
+		if (!statistics.WriteCSV(statisticsPath + ".csv")) {
+			logger->Warning("Couldn't write frame timings to %s.csv\n", statisticsPath.c_str());
+		}
+		if (!statistics.WriteJSON(statisticsPath + ".json")) {
+			logger->Warning("Couldn't write frame summary to %s.json\n", statisticsPath.c_str());
+		}
+
+		GpuMemoryStatistics memory = allocator->Statistics();
+		logger->Info("GPU memory: %.2fMB used of %.2fMB reserved in %u blocks and %u dedicated allocations, %.1f%% fragmented\n", memory.used / 1048576.0, memory.reserved / 1048576.0, memory.blocks, memory.dedicatedAllocations, memory.fragmentation * 100.0);
+
+		logger->Info("Uniforms: at most %llu of %llu bytes used in a frame\n", static_cast<unsigned long long>(uniforms->HighWater()), static_cast<unsigned long long>(uniforms->RegionSize()));
+
+		FrameSummary summary = statistics.Summarise();
+		logger->Info("Frame time p50 %.3fms, p95 %.3fms, p99 %.3fms, max %.3fms\n", summary.total.p50 * 1000.0, summary.total.p95 * 1000.0, summary.total.p99 * 1000.0, summary.total.max * 1000.0);
+		logger->Info("Hitches: %llu of %llu frames\n", static_cast<unsigned long long>(summary.hitches), static_cast<unsigned long long>(statistics.RecordedFrames()));
+
+		// A frame is GPU-bound when the GPU took longer on it than the CPU spent updating and recording it.
+		if (summary.gpuMeasured > 0) {
+			logger->Info("GPU time p50 %.3fms, p95 %.3fms, p99 %.3fms, max %.3fms; %llu of %llu measured frames were GPU-bound\n", summary.gpu.p50 * 1000.0, summary.gpu.p95 * 1000.0, summary.gpu.p99 * 1000.0, summary.gpu.max * 1000.0, static_cast<unsigned long long>(summary.gpuBound), static_cast<unsigned long long>(summary.gpuMeasured));
+		}
+		for (GpuRegionTiming& region : profiler->RegionAverages()) {
+			logger->Info("GPU %s: %.3fms on average\n", region.name, region.time * 1000.0);
+		}
+		if (profiler->StatisticsEnabled() && profiler->CollectedFrames() > 0) {
+			for (uint32_t i = 0; i < GpuProfiler::StatisticCount; ++i) {
+				logger->Info("Last frame had %llu %s\n", static_cast<unsigned long long>(gpuTiming.statistics[i]), GpuProfiler::StatisticName(i));
+			}
+		}
 	}
 
 	bool Engine::InitialiseGLFW() {
 		if (!glfwInit()) {
-			if (verbose) std::cout << "GLFW couldn't initialize, something is wrong!\n";
+			logger->Error("GLFW couldn't initialize, something is wrong!\n");
 			return false;
 		} else {
-			if (verbose) {
-				std::cout << "Compiled on GLFW " << GLFW_VERSION_MAJOR << "." << GLFW_VERSION_MINOR << "." << GLFW_VERSION_REVISION << "\n";
-				int major, minor, revision;
-				glfwGetVersion(&major, &minor, &revision);
-				std::cout << "Currently running GLFW " << major << "." << minor << "." << revision << "\n";
-			}
+			logger->Info("Compiled on GLFW %d.%d.%d\n", GLFW_VERSION_MAJOR, GLFW_VERSION_MINOR, GLFW_VERSION_REVISION);
+			int major, minor, revision;
+			glfwGetVersion(&major, &minor, &revision);
+			logger->Info("Currently running GLFW %d.%d.%d\n", major, minor, revision);
 			return true;
 		}
 	}
 
 	bool Engine::CheckVulkanCompatability() {
 		if (!glfwVulkanSupported()) {
-			if (verbose) std::cout << "Vulkan is not supported.\n";
+			logger->Error("Vulkan is not supported.\n");
 			return false;
 		} else {
-			if (verbose) std::cout << "Vulkan is supported.\n";
+			logger->Info("Vulkan is supported.\n");
 			return true;
 		}
 	}
 
-	bool Engine::InitialiseWindow() {
-		// Then we get monitor and video properties.
-		monitor = glfwGetPrimaryMonitor();
-		vidmode = glfwGetVideoMode(monitor);
-		glfwWindowHint(GLFW_RED_BITS, vidmode->redBits);
-		glfwWindowHint(GLFW_GREEN_BITS, vidmode->greenBits);
-		glfwWindowHint(GLFW_BLUE_BITS, vidmode->blueBits);
-		glfwWindowHint(GLFW_REFRESH_RATE, vidmode->refreshRate);
-
-		const bool borderlessFullscreen = false;
-
-		const char* windowTitle = "HELLO WORLD!";
-
-		// This is the point when you call glfwWindowHint for features.
-		glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
-
+	bool Engine::InitialiseInstance() {
 		// Then we set up the Vulkan application information.
 		applicationInfo = vk::ApplicationInfo("HELLO WORLD!", 0U, "B-Power", 0U, 0U);
 
-		// Now for Vulkan integration into our GLFW window.
-		uint32_t count;
-		const char** extensionsPtr = glfwGetRequiredInstanceExtensions(&count);
-		std::vector<const char*> extensions(count);
+		// Now for Vulkan integration into our GLFW window. Headless runs don't need any extensions.
+		std::vector<const char*> extensions;
 
-		for (int i = 0; i < count; ++i) {
-			extensions[i] = extensionsPtr[i];
-		}
+		if (!headless) {
+			uint32_t count;
+			const char** extensionsPtr = glfwGetRequiredInstanceExtensions(&count);
 
-		extensions.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
+			for (uint32_t i = 0; i < count; ++i) {
+				extensions.push_back(extensionsPtr[i]);
+			}
+
+			extensions.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
+		}
 
-		PFN_vkCreateInstance pfnCreateInstance = (PFN_vkCreateInstance)glfwGetInstanceProcAddress(nullptr, "vkCreateInstance");
+		// This is how we find out whether a device can do bindless descriptors, so ask for it if it's there.
+		for (vk::ExtensionProperties& extension : vk::enumerateInstanceExtensionProperties()) {
+			if (std::string(extension.extensionName) == DescriptorHeap::InstanceExtension) {
+				extensions.push_back(DescriptorHeap::InstanceExtension);
+				physicalDeviceProperties2 = true;
+				break;
+			}
+		}
 
-		instanceInfo = vk::InstanceCreateInfo(vk::InstanceCreateFlags(), &applicationInfo, 0, nullptr, extensions.size(), extensions.data());
+		instanceInfo = vk::InstanceCreateInfo(vk::InstanceCreateFlags(), &applicationInfo, 0, nullptr, static_cast<uint32_t>(extensions.size()), extensions.data());
 
 		instance = vk::createInstance(instanceInfo);
 
-		std::vector<vk::PhysicalDevice> physicalDevices = instance.enumeratePhysicalDevices();
+		return true;
+	}
+
+	bool Engine::EnumerateDevices() {
+		physicalDevices = instance.enumeratePhysicalDevices();
 
 		if (physicalDevices.empty()) {
-			if (verbose) std::cout << "No physical devices for Vulkan to render on.\n";
+			logger->Error("No physical devices for Vulkan to render on.\n");
 			return false;
 		}
 
 		for (vk::PhysicalDevice& physicalDevice : physicalDevices) {
 			vk::PhysicalDeviceProperties properties = physicalDevice.getProperties();
-			if (verbose) {
-				std::cout << "Driver Version: " << properties.driverVersion << "\n";
-				std::cout << "Driver Name:    " << properties.deviceName << "\n";
-				std::cout << "Driver Type:    " << vk::to_string(properties.deviceType) << "\n";
-				std::cout << "API Version:    " << VK_VERSION_MAJOR(properties.apiVersion) << "." << VK_VERSION_MINOR(properties.apiVersion) << "." << VK_VERSION_PATCH(properties.apiVersion) << "\n";
-			}
+			logger->Info("Driver Version: %u\n", properties.driverVersion);
+			logger->Info("Driver Name:    %s\n", properties.deviceName);
+			logger->Info("Driver Type:    %s\n", vk::to_string(properties.deviceType).c_str());
+			logger->Info("API Version:    %u.%u.%u\n", VK_VERSION_MAJOR(properties.apiVersion), VK_VERSION_MINOR(properties.apiVersion), VK_VERSION_PATCH(properties.apiVersion));
 			std::vector<vk::QueueFamilyProperties> queueFamily = physicalDevice.getQueueFamilyProperties();
-			if (verbose) std::cout << "Queue count:    " << queueFamily.size() << "\n";
+			logger->Info("Queue count:    %u\n", static_cast<uint32_t>(queueFamily.size()));
 			int index = 0;
 			for (vk::QueueFamilyProperties& queueProperties : queueFamily) {
-				if (verbose) {
-					std::cout << "Queue " << index << "\n";
-					if (queueProperties.queueFlags & vk::QueueFlagBits::eGraphics) std::cout << "    Graphics\n";
-					if (queueProperties.queueFlags & vk::QueueFlagBits::eCompute) std::cout << "    Compute\n";
-					if (queueProperties.queueFlags & vk::QueueFlagBits::eTransfer) std::cout << "    Transfer\n";
-					if (queueProperties.queueFlags & vk::QueueFlagBits::eSparseBinding) std::cout << "    Sparse Binding\n";
-				}
+				logger->Info("Queue %d\n", index);
+				if (queueProperties.queueFlags & vk::QueueFlagBits::eGraphics) logger->Info("    Graphics\n");
+				if (queueProperties.queueFlags & vk::QueueFlagBits::eCompute) logger->Info("    Compute\n");
+				if (queueProperties.queueFlags & vk::QueueFlagBits::eTransfer) logger->Info("    Transfer\n");
+				if (queueProperties.queueFlags & vk::QueueFlagBits::eSparseBinding) logger->Info("    Sparse Binding\n");
 				++index;
 			}
 		}
 
-		physicalDevice = physicalDevices[0];
+		return true;
+	}
+
+	bool Engine::InitialiseDevice() {
+		std::vector<const char*> extensions;
+		if (!headless) {
+			extensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+		}
+
+		// Nothing we draw needs optional features yet; anything added here gets checked and enabled.
+		vk::PhysicalDeviceFeatures requiredFeatures = vk::PhysicalDeviceFeatures();
+
+		// Score every device and take the best, unless one was asked for by number.
+		std::vector<DeviceScore> scores;
+		uint32_t best = 0;
+		for (uint32_t i = 0; i < physicalDevices.size(); ++i) {
+			scores.push_back(DeviceScore::Evaluate(physicalDevices[i], headless ? vk::SurfaceKHR() : surface, extensions, requiredFeatures));
+			logger->Info("Device %u scored %lld (%s)\n", i, static_cast<long long>(scores[i].score), scores[i].reason.c_str());
+			if (scores[i].score > scores[best].score) {
+				best = i;
+			}
+		}
+
+		uint32_t chosen = best;
+		if (deviceOverride >= 0) {
+			if (static_cast<uint32_t>(deviceOverride) < physicalDevices.size() && scores[deviceOverride].Usable()) {
+				chosen = static_cast<uint32_t>(deviceOverride);
+			} else {
+				logger->Warning("Device %d can't be used, so it's been ignored.\n", deviceOverride);
+			}
+		}
+
+		if (!scores[chosen].Usable()) {
+			logger->Error("None of the physical devices can run this.\n");
+			return false;
+		}
+
+		physicalDevice = physicalDevices[chosen];
+		logger->Info("Using device %u, %s: %s%s.\n", chosen, physicalDevice.getProperties().deviceName, scores[chosen].reason.c_str(), chosen != best ? " (chosen with /DEVICE)" : "");
+
+		// We need somewhere to submit our drawing to (that can present to the window, if there is one), and
+		// ideally separate families for uploads and compute so they can overlap with it.
+		queueFamilies = QueueFamilies::Select(physicalDevice, headless ? vk::SurfaceKHR() : surface);
+		if (!queueFamilies.HasGraphics()) {
+			logger->Error("The physical device has no graphics queue that can present.\n");
+			return false;
+		}
+		logger->Info("Graphics on queue family %u, transfers on %u%s, compute on %u%s.\n", queueFamilies.graphics, queueFamilies.transfer, queueFamilies.HasDedicatedTransfer() ? " (dedicated)" : "", queueFamilies.compute, queueFamilies.HasAsyncCompute() ? " (async)" : "");
+
+		// Each role gets its own queue where the family has enough of them, and shares the family's last
+		// one otherwise. Graphics goes first and has the highest priority, since it's what the frame waits
+		// on; uploads come last since they can usually afford to be late.
+		std::vector<vk::QueueFamilyProperties> familyProperties = physicalDevice.getQueueFamilyProperties();
+		const uint32_t roleFamilies[] = { queueFamilies.graphics, queueFamilies.compute, queueFamilies.transfer };
+		const float rolePriorities[] = { 1.0f, 0.75f, 0.5f };
+		uint32_t roleQueues[3];
+		std::vector<uint32_t> families;
+		std::vector<std::vector<float>> priorities;
+		for (int role = 0; role < 3; ++role) {
+			size_t slot = std::find(families.begin(), families.end(), roleFamilies[role]) - families.begin();
+			if (slot == families.size()) {
+				families.push_back(roleFamilies[role]);
+				priorities.push_back(std::vector<float>());
+			}
+			if (priorities[slot].size() < familyProperties[roleFamilies[role]].queueCount) {
+				priorities[slot].push_back(rolePriorities[role]);
+			}
+			roleQueues[role] = static_cast<uint32_t>(priorities[slot].size() - 1);
+		}
+
+		std::vector<vk::DeviceQueueCreateInfo> queueInfos;
+		for (size_t i = 0; i < families.size(); ++i) {
+			vk::DeviceQueueCreateInfo queueInfo = vk::DeviceQueueCreateInfo();
+			queueInfo.setQueueFamilyIndex(families[i]);
+			queueInfo.setQueueCount(static_cast<uint32_t>(priorities[i].size()));
+			queueInfo.setPQueuePriorities(priorities[i].data());
+			queueInfos.push_back(queueInfo);
+		}
 
 		vk::DeviceCreateInfo deviceInfo = vk::DeviceCreateInfo();
-		vk::DeviceQueueCreateInfo deviceQueueInfo = vk::DeviceQueueCreateInfo();
+		deviceInfo.setQueueCreateInfoCount(static_cast<uint32_t>(queueInfos.size()));
+		deviceInfo.setPQueueCreateInfos(queueInfos.data());
+		deviceInfo.setPEnabledFeatures(&requiredFeatures);
 
-		float queuePriorities[] = {1.0f};
+		// Bindless descriptors need their extension and features turned on here, or the fallback gets used.
+		bindless = physicalDeviceProperties2 && DescriptorHeap::Supported(instance, physicalDevice);
+		DescriptorIndexingFeatures indexingFeatures = DescriptorHeap::RequiredFeatures();
+		if (bindless) {
+			extensions.push_back(DescriptorHeap::DeviceExtension);
+			deviceInfo.setPNext(&indexingFeatures);
+		}
+		deviceInfo.setEnabledExtensionCount(static_cast<uint32_t>(extensions.size()));
+		deviceInfo.setPpEnabledExtensionNames(extensions.data());
+		logger->Info("Descriptors are %s.\n", bindless ? "bindless" : "in a set per material");
 
-		deviceQueueInfo.setQueueCount(1);
-		deviceQueueInfo.setPQueuePriorities(queuePriorities);
-		deviceInfo.setQueueCreateInfoCount(1);
-		deviceInfo.setPQueueCreateInfos(&deviceQueueInfo);
+		// Pipeline statistics are nice to have, so they're only turned on if the device we ended up with has them.
+		pipelineStatistics = GpuProfiler::SupportsStatistics(physicalDevice, requiredFeatures);
 
-		VkDevice deviceLegacy;
+		device = physicalDevice.createDevice(deviceInfo);
 
-		vkCreateDevice(physicalDevice, &(VkDeviceCreateInfo)deviceInfo, nullptr, &deviceLegacy);
+		graphicsQueue = device.getQueue(queueFamilies.graphics, roleQueues[0]);
+		computeQueue = device.getQueue(queueFamilies.compute, roleQueues[1]);
+		transferQueue = device.getQueue(queueFamilies.transfer, roleQueues[2]);
 
-		device = vk::Device(deviceLegacy);
+		return true;
+	}
 
-		PFN_vkGetPhysicalDeviceSurfaceFormatsKHR vkGetPhysicalDeviceSurfaceFormatsKHR = nullptr;
+	bool Engine::InitialiseWindow() {
+		// Then we get monitor and video properties.
+		monitor = glfwGetPrimaryMonitor();
+		vidmode = glfwGetVideoMode(monitor);
+		glfwWindowHint(GLFW_RED_BITS, vidmode->redBits);
+		glfwWindowHint(GLFW_GREEN_BITS, vidmode->greenBits);
+		glfwWindowHint(GLFW_BLUE_BITS, vidmode->blueBits);
+		glfwWindowHint(GLFW_REFRESH_RATE, vidmode->refreshRate);
 
-		*(void **)&vkGetPhysicalDeviceSurfaceFormatsKHR = vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceSurfaceFormatsKHR");
+		const bool borderlessFullscreen = false;
 
-		PFN_vkCreateDevice pfnCreateDevice = (PFN_vkCreateDevice)glfwGetInstanceProcAddress(instance, "vkCreateDevice");
-		PFN_vkGetDeviceProcAddr pfnGetDeviceProcAddr = (PFN_vkGetDeviceProcAddr)glfwGetInstanceProcAddress(instance, "vkGetDeviceProcAddr");
+		const char* windowTitle = "HELLO WORLD!";
+
+		// This is the point when you call glfwWindowHint for features.
+		glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
 
 		// Then, we create the window.
 		if (borderlessFullscreen) {
 			window = glfwCreateWindow(vidmode->width, vidmode->height, windowTitle, monitor, nullptr);
 		} else {
-			window = glfwCreateWindow(800, 600, windowTitle, nullptr, nullptr);
+			window = glfwCreateWindow(width, height, windowTitle, nullptr, nullptr);
+		}
+
+		if (window == nullptr) {
+			logger->Error("GLFW couldn't create a window.\n");
+			return false;
 		}
 
-		// Finally, set up the Vulkan surface.
+		return true;
+	}
+
+	bool Engine::InitialiseSurface() {
 		// TODO: Add surface properties here.
-		VkSurfaceKHR surfaceLegacy = surface;
+		VkSurfaceKHR surfaceLegacy;
 		VkResult err = glfwCreateWindowSurface(instance, window, nullptr, &surfaceLegacy);
 		if (err != (VkResult)vk::Result::eSuccess) {
-			std::cout << "Vulkan did not create a surface properly.\n";
-			return 1;
+			logger->Error("Vulkan did not create a surface properly.\n");
+			return false;
 		} else {
-			std::cout << "Vulkan was successfully created as a surface.\n";
+			logger->Info("Vulkan was successfully created as a surface.\n");
 		}
+		surface = vk::SurfaceKHR(surfaceLegacy);
 
 		return true;
 	}
 
+	bool Engine::InitialiseSwapchain() {
+		int framebufferWidth, framebufferHeight;
+		glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+
+		swapchain = new Swapchain(physicalDevice, device, surface, vk::Extent2D(static_cast<uint32_t>(framebufferWidth), static_cast<uint32_t>(framebufferHeight)), presentMode, swapImageCount);
+		if (swapchain->PresentMode() != presentMode) {
+			logger->Warning("%s isn't supported here, falling back to %s.\n", vk::to_string(presentMode).c_str(), vk::to_string(swapchain->PresentMode()).c_str());
+		}
+		logger->Info("Swapchain is %ux%u with %u images, presenting with %s.\n", swapchain->Extent().width, swapchain->Extent().height, swapchain->ImageCount(), vk::to_string(swapchain->PresentMode()).c_str());
+
+		return true;
+	}
+
+	void Engine::InitialiseRenderPass(vk::Format format) {
+		// A single colour attachment that gets cleared every frame. The render graph moves the image into
+		// the attachment layout beforehand and out to wherever it's going afterwards, so the pass itself
+		// never changes it.
+		vk::AttachmentDescription colourAttachment = vk::AttachmentDescription();
+		colourAttachment.setFormat(format);
+		colourAttachment.setSamples(vk::SampleCountFlagBits::e1);
+		colourAttachment.setLoadOp(vk::AttachmentLoadOp::eClear);
+		colourAttachment.setStoreOp(vk::AttachmentStoreOp::eStore);
+		colourAttachment.setStencilLoadOp(vk::AttachmentLoadOp::eDontCare);
+		colourAttachment.setStencilStoreOp(vk::AttachmentStoreOp::eDontCare);
+		colourAttachment.setInitialLayout(vk::ImageLayout::eColorAttachmentOptimal);
+		colourAttachment.setFinalLayout(vk::ImageLayout::eColorAttachmentOptimal);
+
+		vk::AttachmentReference colourReference(0, vk::ImageLayout::eColorAttachmentOptimal);
+
+		vk::SubpassDescription subpass = vk::SubpassDescription();
+		subpass.setPipelineBindPoint(vk::PipelineBindPoint::eGraphics);
+		subpass.setColorAttachmentCount(1);
+		subpass.setPColorAttachments(&colourReference);
+
+		vk::RenderPassCreateInfo renderPassInfo = vk::RenderPassCreateInfo();
+		renderPassInfo.setAttachmentCount(1);
+		renderPassInfo.setPAttachments(&colourAttachment);
+		renderPassInfo.setSubpassCount(1);
+		renderPassInfo.setPSubpasses(&subpass);
+
+		renderPass = device.createRenderPass(renderPassInfo);
+	}
+
+	void Engine::InitialiseFramebuffers() {
+		std::vector<vk::ImageView> views;
+		vk::Extent2D extent;
+		if (headless) {
+			views.push_back(offscreenTarget->View());
+			extent = offscreenTarget->Extent();
+		} else {
+			for (uint32_t i = 0; i < swapchain->ImageCount(); ++i) {
+				views.push_back(swapchain->View(i));
+			}
+			extent = swapchain->Extent();
+		}
+
+		for (vk::ImageView& view : views) {
+			vk::FramebufferCreateInfo framebufferInfo = vk::FramebufferCreateInfo();
+			framebufferInfo.setRenderPass(renderPass);
+			framebufferInfo.setAttachmentCount(1);
+			framebufferInfo.setPAttachments(&view);
+			framebufferInfo.setWidth(extent.width);
+			framebufferInfo.setHeight(extent.height);
+			framebufferInfo.setLayers(1);
+			framebuffers.push_back(device.createFramebuffer(framebufferInfo));
+		}
+	}
+
+	void Engine::DestroyFramebuffers() {
+		for (vk::Framebuffer& framebuffer : framebuffers) {
+			device.destroyFramebuffer(framebuffer);
+		}
+		framebuffers.clear();
+	}
+
+	void Engine::RecreateSwapchain() {
+		// A minimised window has nothing to present to, so just wait until it comes back.
+		int framebufferWidth, framebufferHeight;
+		glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+		if (framebufferWidth == 0 || framebufferHeight == 0) {
+			glfwWaitEvents();
+			return;
+		}
+
+		device.waitIdle();
+		DestroyFramebuffers();
+		vk::Format previousFormat = swapchain->Format();
+		swapchain->Recreate(vk::Extent2D(static_cast<uint32_t>(framebufferWidth), static_cast<uint32_t>(framebufferHeight)));
+
+		// The surface's formats are asked for again on every recreation, and can change when the window
+		// moves to another monitor. The render pass is built for one format, so it has to follow.
+		if (swapchain->Format() != previousFormat) {
+			device.destroyRenderPass(renderPass);
+			InitialiseRenderPass(swapchain->Format());
+			logger->Info("Swapchain format changed from %s to %s, so the render pass was rebuilt.\n", vk::to_string(previousFormat).c_str(), vk::to_string(swapchain->Format()).c_str());
+		}
+		InitialiseFramebuffers();
+		BuildRenderGraph();
+		swapchainStale = false;
+
+		logger->Info("Swapchain recreated at %ux%u.\n", swapchain->Extent().width, swapchain->Extent().height);
+	}
+
+	void Engine::BuildRenderGraph() {
+		renderGraph->Reset();
+
+		// Whatever we draw to starts each frame with nothing worth keeping, and ends up presented or read back.
+		vk::Format format = headless ? offscreenTarget->Format() : swapchain->Format();
+		vk::Extent2D extent = headless ? offscreenTarget->Extent() : swapchain->Extent();
+		vk::ImageLayout finalLayout = headless ? vk::ImageLayout::eTransferSrcOptimal : vk::ImageLayout::ePresentSrcKHR;
+		backbuffer = renderGraph->ImportImage("backbuffer", format, extent, vk::ImageLayout::eUndefined, finalLayout);
+
+		uint32_t mainPass = renderGraph->AddPass("main pass", RenderQueue::Graphics, &Engine::MainPass, this);
+		renderGraph->Use(mainPass, backbuffer, RenderAccess::ColourAttachment);
+
+		renderGraph->Compile();
+		logger->Info("Render graph has %u passes (%u culled, %u async) with %u barriers and %.2fMB of transient images (%.2fMB without aliasing).\n", renderGraph->PassCount(), renderGraph->CulledPasses(), renderGraph->AsyncPasses(), renderGraph->BarrierCount(), renderGraph->TransientMemory() / 1048576.0, renderGraph->UnaliasedMemory() / 1048576.0);
+	}
+
+	void Engine::InstanceJob(void* data) {
+		Engine* engine = static_cast<Engine*>(data);
+		{
+			StartupScope scope(engine->startup, "instance");
+			if (!engine->InitialiseInstance()) {
+				return;
+			}
+		}
+
+		// Listing every device is slow on some drivers, and it doesn't need the surface yet.
+		StartupScope scope(engine->startup, "device enumeration");
+		engine->instanceReady = engine->EnumerateDevices();
+	}
+
+	void Engine::ReadPipelineCacheJob(void* data) {
+		Engine* engine = static_cast<Engine*>(data);
+		StartupScope scope(engine->startup, "pipeline cache read");
+		engine->pipelineCacheFile = PipelineCache::Read(engine->pipelineCachePath);
+	}
+
+	void Engine::LogStartup(double startupTime) {
+		// Phases on different threads overlap, so they can add up to more than startup took.
+		std::vector<StartupPhase> phases = startup->Phases();
+		for (StartupPhase& phase : phases) {
+			logger->Info("    %-24s %9.3fms for %9.3fms on thread %u\n", phase.name, phase.start * 1000.0, phase.duration * 1000.0, phase.thread);
+		}
+		logger->Info("Startup phases add up to %.3fms, done in %.3fms.\n", startup->SerialTime() * 1000.0, startupTime * 1000.0);
+	}
+
+	void Engine::Abort() {
+		logger->Flush();
+		abort();
+	}
+
+	vk::Pipeline Engine::BuildIdlePipeline(vk::Device device, vk::PipelineCache cache, void* data) {
+		Engine* engine = static_cast<Engine*>(data);
+
+		vk::ShaderModule shader = device.createShaderModule(vk::ShaderModuleCreateInfo(vk::ShaderModuleCreateFlags(), sizeof(IdleComputeShader), IdleComputeShader));
+
+		vk::PipelineShaderStageCreateInfo stage = vk::PipelineShaderStageCreateInfo();
+		stage.setStage(vk::ShaderStageFlagBits::eCompute);
+		stage.setModule(shader);
+		stage.setPName("main");
+
+		vk::ComputePipelineCreateInfo pipelineInfo = vk::ComputePipelineCreateInfo();
+		pipelineInfo.setStage(stage);
+		pipelineInfo.setLayout(engine->pipelineLayout);
+
+		// The module isn't needed once the pipeline exists, whether or not it worked.
+		vk::Pipeline pipeline;
+		try {
+			pipeline = device.createComputePipeline(cache, pipelineInfo);
+		} catch (...) {
+			device.destroyShaderModule(shader);
+			throw;
+		}
+		device.destroyShaderModule(shader);
+		return pipeline;
+	}
+
+	void Engine::UpdateJob(void* data) {
+		Engine* engine = static_cast<Engine*>(data);
+
+		// The simulation runs at a fixed rate regardless of how fast we're drawing.
+		while (engine->framerate->ConsumeTick()) {
+			engine->Update(engine->framerate->TickDelta());
+		}
+	}
+
+	void Engine::CullJob(void* data) {
+		Engine* engine = static_cast<Engine*>(data);
+		engine->Cull(engine->framerate->Alpha());
+		engine->updateEnd = engine->framerate->Now();
+	}
+
+	void Engine::BeginFrameJob(void* data) {
+		Engine* engine = static_cast<Engine*>(data);
+
+		// This only waits if the GPU is a whole ring of frames behind; the update and cull stages have
+		// already run alongside whatever it's still doing.
+		engine->frames->Begin(engine->framerate->FrameCount());
+		engine->descriptors->BeginFrame();
+
+		// Whatever the GPU measured the last time this slot was used is finished by now, so reading it
+		// back doesn't wait.
+		engine->gpuTimingReady = engine->profiler->Collect(engine->frames->Index(), engine->gpuTiming);
+
+		// The ring has just waited for this frame's previous use to finish, so its constants can be reused.
+		engine->uniforms->Reset(engine->frames->Index());
+		FrameConstants constants;
+		constants.time = static_cast<float>(engine->renderTime);
+		constants.alpha = static_cast<float>(engine->framerate->Alpha());
+		constants.frame = static_cast<uint32_t>(engine->framerate->FrameCount());
+		constants.drawCount = static_cast<uint32_t>(engine->drawList.Size());
+		engine->uniforms->Push(constants, engine->frameConstants);
+
+		// If there's no image to draw to, the whole frame is skipped until the swapchain is rebuilt.
+		engine->frameSkipped = false;
+		if (!engine->headless) {
+			if (engine->swapchainStale || !engine->swapchain->Acquire(engine->frames->Current().imageAcquired, engine->currentImage)) {
+				engine->swapchainStale = true;
+				engine->frameSkipped = true;
+			}
+		}
+	}
+
+	void Engine::RecordPartitionJob(void* data) {
+		RecordPartition* partition = static_cast<RecordPartition*>(data);
+		if (!partition->engine->frameSkipped) {
+			partition->engine->RecordDraws(*partition);
+		}
+	}
+
+	void Engine::SubmitJob(void* data) {
+		Engine* engine = static_cast<Engine*>(data);
+		if (!engine->frameSkipped) {
+			engine->DrawBuffer();
+		}
+	}
+
+	void Engine::Update(double delta) {
+		// For now the scene is just a clock that the clear colour follows.
+		previousSimulationTime = simulationTime;
+		simulationTime += delta;
+	}
+
+	void Engine::Cull(double alpha) {
+		// This works out what the frame will show from the last two ticks. Visibility tests belong here
+		// once there's a scene with more in it than a clock.
+		renderTime = previousSimulationTime + (simulationTime - previousSimulationTime) * alpha;
+
+		// The scene is a grid of tiles that pulse out of step with each other.
+		uint32_t columns = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(drawCount))));
+		uint32_t rows = columns > 0 ? (drawCount + columns - 1) / columns : 0;
+		drawList.Clear();
+		for (uint32_t i = 0; i < drawCount; ++i) {
+			float pulse = static_cast<float>(0.5 + 0.5 * std::sin(renderTime + i * 0.1));
+			DrawItem item;
+			item.x = static_cast<float>(i % columns) / columns;
+			item.y = static_cast<float>(i / columns) / rows;
+			item.width = 0.8f / columns;
+			item.height = 0.8f / rows;
+			item.colour = { 0.2f + 0.6f * pulse, 0.3f, 0.8f - 0.6f * pulse, 1.0f };
+			drawList.Add(item);
+		}
+	}
+
+	void Engine::RecordDraws(RecordPartition& partition) {
+		vk::Framebuffer framebuffer = headless ? framebuffers[0] : framebuffers[currentImage];
+		vk::Extent2D extent = headless ? offscreenTarget->Extent() : swapchain->Extent();
+
+		// The buffer comes from this thread's own pool, so no other thread can be recording into it.
+		partition.commandBuffer = frames->SecondaryBuffer(JobSystem::ThreadIndex());
+
+		// The primary buffer counts pipeline statistics across these, so they have to say they'll run under that query.
+		vk::CommandBufferInheritanceInfo inheritance(renderPass, 0, framebuffer, VK_FALSE, vk::QueryControlFlags(), profiler->StatisticFlags());
+		partition.commandBuffer.begin(vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eRenderPassContinue | vk::CommandBufferUsageFlagBits::eOneTimeSubmit, &inheritance));
+
+		size_t begin, end;
+		drawList.Partition(partition.count, partition.index, begin, end);
+		for (size_t i = begin; i < end; ++i) {
+			// There's no pipeline yet, so each tile is drawn as a clear of its own rectangle.
+			const DrawItem& item = drawList[i];
+			int32_t x = std::min(static_cast<int32_t>(item.x * extent.width), static_cast<int32_t>(extent.width) - 1);
+			int32_t y = std::min(static_cast<int32_t>(item.y * extent.height), static_cast<int32_t>(extent.height) - 1);
+			uint32_t width = std::max(1u, std::min(static_cast<uint32_t>(item.width * extent.width), extent.width - x));
+			uint32_t height = std::max(1u, std::min(static_cast<uint32_t>(item.height * extent.height), extent.height - y));
+
+			vk::ClearAttachment attachment(vk::ImageAspectFlagBits::eColor, 0, vk::ClearValue(vk::ClearColorValue(item.colour)));
+			vk::ClearRect rect(vk::Rect2D(vk::Offset2D(x, y), vk::Extent2D(width, height)), 0, 1);
+			partition.commandBuffer.clearAttachments(attachment, rect);
+		}
+
+		partition.commandBuffer.end();
+	}
+
 	void Engine::DrawBuffer() {
+		FrameContext& frame = frames->Current();
+		vk::CommandBuffer commandBuffer = frame.commandBuffer;
+
+		commandBuffer.begin(vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+		profiler->BeginFrame(commandBuffer, frames->Index(), frame.frameNumber);
+
+		// The idle shader doesn't compute anything yet, but it's dispatched with the heap bound and the
+		// frame's material pushed, so the constants are there for it the way every pass will get them.
+		vk::Pipeline idle = pipelines->Get(idlePipeline);
+		if (idle) {
+			commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, idle);
+			descriptors->BindHeap(commandBuffer, vk::PipelineBindPoint::eCompute, pipelineLayout);
+			descriptors->Push(commandBuffer, vk::PipelineBindPoint::eCompute, pipelineLayout, frameMaterial);
+			commandBuffer.dispatch(1, 1, 1);
+		}
+
+		if (headless) {
+			renderGraph->Bind(backbuffer, offscreenTarget->Image(), offscreenTarget->View());
+		} else {
+			renderGraph->Bind(backbuffer, swapchain->Image(currentImage), swapchain->View(currentImage));
+		}
+		renderGraph->Execute(commandBuffer, frames->Index(), profiler);
+
+		profiler->EndFrame(commandBuffer);
+		commandBuffer.end();
 
+		// Windowed frames can't touch the image until it's been acquired, and can't be presented until
+		// they're drawn. Anything the render graph sent to the compute queue gets waited on as well.
+		std::vector<vk::Semaphore> waits;
+		std::vector<vk::PipelineStageFlags> waitStages;
+		std::vector<vk::Semaphore> signals;
+		if (!headless) {
+			waits.push_back(frame.imageAcquired);
+			waitStages.push_back(vk::PipelineStageFlagBits::eColorAttachmentOutput);
+			signals.push_back(frame.renderFinished);
+		}
+		renderGraph->SubmitSemaphores(waits, waitStages, signals);
+
+		vk::SubmitInfo submitInfo = vk::SubmitInfo();
+		submitInfo.setCommandBufferCount(1);
+		submitInfo.setPCommandBuffers(&commandBuffer);
+		submitInfo.setWaitSemaphoreCount(static_cast<uint32_t>(waits.size()));
+		submitInfo.setPWaitSemaphores(waits.data());
+		submitInfo.setPWaitDstStageMask(waitStages.data());
+		submitInfo.setSignalSemaphoreCount(static_cast<uint32_t>(signals.size()));
+		submitInfo.setPSignalSemaphores(signals.data());
+
+		frames->Submit(graphicsQueue, submitInfo);
+	}
+
+	void Engine::MainPass(vk::CommandBuffer commandBuffer, void* data) {
+		Engine* engine = static_cast<Engine*>(data);
+		vk::Framebuffer framebuffer = engine->headless ? engine->framebuffers[0] : engine->framebuffers[engine->currentImage];
+		vk::Extent2D extent = engine->headless ? engine->offscreenTarget->Extent() : engine->swapchain->Extent();
+
+		// The render pass does the clear, then the tiles are drawn over it.
+		float pulse = static_cast<float>(0.5 + 0.5 * std::sin(engine->renderTime));
+		vk::ClearValue clearValue(vk::ClearColorValue(std::array<float, 4>{ 0.1f, 0.2f * pulse, 0.4f, 1.0f }));
+		vk::RenderPassBeginInfo renderPassBegin = vk::RenderPassBeginInfo();
+		renderPassBegin.setRenderPass(engine->renderPass);
+		renderPassBegin.setFramebuffer(framebuffer);
+		renderPassBegin.setRenderArea(vk::Rect2D(vk::Offset2D(0, 0), extent));
+		renderPassBegin.setClearValueCount(1);
+		renderPassBegin.setPClearValues(&clearValue);
+		commandBuffer.beginRenderPass(renderPassBegin, vk::SubpassContents::eSecondaryCommandBuffers);
+
+		// Partition order, not the order the jobs finished in, so every frame draws the same way.
+		std::vector<vk::CommandBuffer> secondaries;
+		for (RecordPartition& partition : engine->partitions) {
+			secondaries.push_back(partition.commandBuffer);
+		}
+		commandBuffer.executeCommands(secondaries);
+
+		commandBuffer.endRenderPass();
+	}
+
+	void Engine::MeasureRecordingScaling() {
+		// Records the same draw list split across 1 to N threads, without submitting any of it, so the
+		// report shows how well recording scales on this machine.
+		const int iterations = 32;
+		for (uint32_t threads = 1; threads <= partitions.size(); ++threads) {
+			for (RecordPartition& partition : partitions) {
+				partition.count = threads;
+			}
+
+			double recordTime = 0.0;
+			for (int i = 0; i < iterations; ++i) {
+				frames->Begin(framerate->FrameCount());
+				frameSkipped = false;
+
+				double start = framerate->Now();
+				JobCounter recorded;
+				for (uint32_t p = 0; p < threads; ++p) {
+					jobs->Run(&Engine::RecordPartitionJob, &partitions[p], &recorded);
+				}
+				jobs->Wait(recorded);
+				recordTime += framerate->Now() - start;
+			}
+
+			benchmark->RecordScaling(threads, recordTime / iterations);
+			logger->Info("Recording %u draws on %u threads took %.3fms.\n", drawCount, threads, recordTime / iterations * 1000.0);
+		}
+
+		for (RecordPartition& partition : partitions) {
+			partition.count = static_cast<uint32_t>(partitions.size());
+		}
 	}
 }
\ No newline at end of file
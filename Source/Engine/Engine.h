@@ -1,9 +1,29 @@
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include <vulkan/vulkan.hpp>
 #include <GLFW/glfw3.h>
 
+#include "Benchmark.h"
+#include "DescriptorHeap.h"
+#include "DeviceScore.h"
+#include "DrawList.h"
+#include "FrameRing.h"
 #include "Framerate.h"
+#include "GpuAllocator.h"
+#include "GpuProfiler.h"
+#include "JobSystem.h"
+#include "Logger.h"
+#include "OffscreenTarget.h"
+#include "PipelineCache.h"
+#include "PipelineManager.h"
+#include "QueueFamilies.h"
+#include "RenderGraph.h"
+#include "StartupProfile.h"
+#include "Swapchain.h"
+#include "UniformAllocator.h"
 
 namespace Biendeo::VulkanGame {
 	class Engine {
@@ -15,6 +35,9 @@ namespace Biendeo::VulkanGame {
 
 		private:
 		Framerate* framerate;
+		Logger* logger;
+		Benchmark* benchmark;
+		JobSystem* jobs;
 
 		GLFWmonitor* monitor;
 		const GLFWvidmode* vidmode;
@@ -22,17 +45,152 @@ namespace Biendeo::VulkanGame {
 
 		vk::ApplicationInfo applicationInfo;
 		vk::InstanceCreateInfo instanceInfo;
+		std::vector<vk::PhysicalDevice> physicalDevices;
 		vk::PhysicalDevice physicalDevice;
+		int deviceOverride;
 		vk::Device device;
 		vk::Instance instance;
 		vk::SurfaceKHR surface;
 
-		bool verbose;
+		// Compute and transfer may be the same queue as graphics on simpler devices; see QueueFamilies.
+		QueueFamilies queueFamilies;
+		vk::Queue graphicsQueue;
+		vk::Queue computeQueue;
+		vk::Queue transferQueue;
+
+		GpuAllocator* allocator;
+
+		PipelineCache* pipelineCache;
+		std::string pipelineCachePath;
+		bool coldPipelineCache;
+
+		// Read off the disk while the device is being made, and handed to the cache once it has been.
+		PipelineCacheFile pipelineCacheFile;
+
+		UniformAllocator* uniforms;
+
+		// The per-frame constants every shader can see, written once at the start of the frame.
+		UniformSlice frameConstants;
+
+		// The frame's uniform buffer is in here as a material, so passes can reach the constants by its index.
+		DescriptorHeap* descriptors;
+		uint32_t frameMaterial;
+
+		// Whether the instance can ask devices about descriptor indexing, and whether the device we made
+		// can do it.
+		bool physicalDeviceProperties2;
+		bool bindless;
+
+		// Everything that draws or dispatches uses this layout, with the heap (or the material's set
+		// without bindless) in set zero.
+		PipelineManager* pipelines;
+		vk::PipelineLayout pipelineLayout;
+		PipelineHandle idlePipeline;
+
+		FrameRing* frames;
+		uint32_t framesInFlight;
+
+		// The GPU's timings for a frame are read back when its slot in the ring comes around again, and
+		// handed to the frame statistics by the main thread once that frame's jobs are done.
+		GpuProfiler* profiler;
+		bool pipelineStatistics;
+		GpuFrameTiming gpuTiming;
+		bool gpuTimingReady;
+
+		OffscreenTarget* offscreenTarget;
+
+		Swapchain* swapchain;
+		vk::PresentModeKHR presentMode;
+		uint32_t swapImageCount;
+		vk::RenderPass renderPass;
+		std::vector<vk::Framebuffer> framebuffers;
+
+		// Barriers, layout changes and the order of passes all come from here. It's rebuilt whenever the
+		// swapchain is.
+		RenderGraph* renderGraph;
+		RenderResource backbuffer;
+
+		// Which swapchain image this frame draws to, and whether there was nothing to draw to this time.
+		uint32_t currentImage;
+		bool frameSkipped;
+
+		// Set when the swapchain no longer matches the window, so it's rebuilt before the next frame.
+		bool swapchainStale;
+
+		short tickRate;
+		short maxTicksPerFrame;
+		PacingMode pacing;
+		bool pacingExplicit;
+		std::string statisticsPath;
+		bool headless;
+		// The run stops after this many frames, or carries on until it's closed if this is zero.
+		uint64_t frameLimit;
+		uint32_t width;
+		uint32_t height;
+
+		FramePacer::Clock::time_point constructionStart;
+		StartupProfile* startup;
+
+		// Set by the instance job once the instance is made and the devices are listed.
+		bool instanceReady;
+
+		double simulationTime;
+		double previousSimulationTime;
+		double renderTime;
+
+		DrawList drawList;
+		uint32_t drawCount;
+
+		// Each partition of the draw list gets recorded into its own secondary buffer by whichever thread
+		// picks up the job, then they're all executed in partition order.
+		struct RecordPartition {
+			Engine* engine;
+			uint32_t index;
+			uint32_t count;
+			vk::CommandBuffer commandBuffer;
+		};
+		std::vector<RecordPartition> partitions;
+
+		// When the update stage finished this frame, as seen by the job that finished it.
+		double updateEnd;
 
 		bool InitialiseGLFW();
 		bool CheckVulkanCompatability();
+		bool InitialiseInstance();
+		bool EnumerateDevices();
+		bool InitialiseDevice();
 		bool InitialiseWindow();
+		bool InitialiseSurface();
+		bool InitialiseSwapchain();
+		void InitialiseRenderPass(vk::Format format);
+		void InitialiseFramebuffers();
+		void DestroyFramebuffers();
+		void RecreateSwapchain();
+		void BuildRenderGraph();
+
+		void Abort();
+
+		// Startup work that can happen off the main thread.
+		static void InstanceJob(void* data);
+		static void ReadPipelineCacheJob(void* data);
+		void LogStartup(double startupTime);
+
+		static vk::Pipeline BuildIdlePipeline(vk::Device device, vk::PipelineCache cache, void* data);
 
+		static void UpdateJob(void* data);
+		static void CullJob(void* data);
+		static void BeginFrameJob(void* data);
+		static void RecordPartitionJob(void* data);
+		static void SubmitJob(void* data);
+
+		void Update(double delta);
+		void Cull(double alpha);
+		void RecordDraws(RecordPartition& partition);
 		void DrawBuffer();
+		static void MainPass(vk::CommandBuffer commandBuffer, void* data);
+
+		void MeasureRecordingScaling();
+
+		void WriteStatistics();
 	};
 }
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "FrameStatistics.h"
+
+namespace Biendeo::VulkanGame {
+	namespace {
+		// The spin threshold never drops below or rises above these, whatever the OS does.
+		const std::chrono::microseconds minimumSpinThreshold(100);
+		const std::chrono::microseconds maximumSpinThreshold(4000);
+
+		// Below this much remaining time, yielding risks getting descheduled past the deadline.
+		const std::chrono::microseconds busySpinWindow(50);
+	}
+
+	FramePacer::FramePacer(PacingMode mode) {
+		this->mode = mode;
+		this->lateFrames = 0ull;
+		this->oversleepMean = 0.0;
+		this->oversleepDeviation = 0.0;
+		this->spinThreshold = std::chrono::microseconds(1000);
+	}
+
+	bool FramePacer::WaitUntil(Clock::time_point deadline) {
+		// If we're already late, return straight away rather than stalling; the caller re-phases.
+		if (Clock::now() >= deadline) {
+			++lateFrames;
+			return false;
+		}
+
+		switch (mode) {
+			case PacingMode::None:
+				break;
+			case PacingMode::Sleep:
+				SleepUntil(deadline);
+				break;
+			case PacingMode::Hybrid:
+				SleepUntil(deadline - spinThreshold);
+				SpinUntil(deadline);
+				break;
+			case PacingMode::Spin:
+				SpinUntil(deadline);
+				break;
+		}
+		return true;
+	}
+
+	PacingMode FramePacer::Mode() {
+		return mode;
+	}
+
+	PacingMode FramePacer::Mode(PacingMode mode) {
+		this->mode = mode;
+		return mode;
+	}
+
+	bool FramePacer::ParseMode(const std::string& name, PacingMode& mode) {
+		if (name == "NONE") mode = PacingMode::None;
+		else if (name == "SLEEP") mode = PacingMode::Sleep;
+		else if (name == "HYBRID") mode = PacingMode::Hybrid;
+		else if (name == "SPIN") mode = PacingMode::Spin;
+		else return false;
+		return true;
+	}
+
+	FramePacer::Clock::duration FramePacer::SpinThreshold() {
+		return spinThreshold;
+	}
+
+	uint64_t FramePacer::LateFrames() {
+		return lateFrames;
+	}
+
+	WakeJitter FramePacer::MeasureWakeJitter(PacingMode mode, int samples, Clock::duration interval) {
+		FramePacer pacer(mode);
+		std::vector<double> lateness;
+		lateness.reserve(samples);
+
+		Clock::time_point deadline = Clock::now() + interval;
+		for (int i = 0; i < samples; ++i) {
+			pacer.WaitUntil(deadline);
+			Clock::time_point woke = Clock::now();
+			lateness.push_back(std::chrono::duration<double, std::micro>(woke - deadline).count());
+			deadline = woke + interval;
+		}
+
+		WakeJitter result = {0.0, 0.0, 0.0, 0.0};
+		if (lateness.empty()) {
+			return result;
+		}
+
+		for (double l : lateness) {
+			result.mean += l;
+		}
+		result.mean /= lateness.size();
+
+		std::sort(lateness.begin(), lateness.end());
+		result.p50 = FrameStatistics::Percentile(lateness, 50);
+		result.p99 = FrameStatistics::Percentile(lateness, 99);
+		result.max = lateness.back();
+		return result;
+	}
+
+	void FramePacer::SleepUntil(Clock::time_point deadline) {
+		Clock::time_point before = Clock::now();
+		if (before >= deadline) {
+			return;
+		}
+
+		std::this_thread::sleep_for(deadline - before);
+
+		// Learning how far past the request the OS woke us up tells the hybrid mode when to stop sleeping.
+		UpdateSpinThreshold(Clock::now() - deadline);
+	}
+
+	void FramePacer::SpinUntil(Clock::time_point deadline) {
+		Clock::time_point now = Clock::now();
+		while (now < deadline) {
+			if (deadline - now > busySpinWindow) {
+				std::this_thread::yield();
+			}
+			now = Clock::now();
+		}
+	}
+
+	void FramePacer::UpdateSpinThreshold(Clock::duration oversleep) {
+		double sample = std::chrono::duration<double, std::micro>(oversleep).count();
+		double difference = sample - oversleepMean;
+		oversleepMean += 0.1 * difference;
+		oversleepDeviation += 0.1 * (std::abs(difference) - oversleepDeviation);
+
+		// Stop sleeping a couple of deviations before the usual oversleep to cover most of the spread.
+		auto threshold = std::chrono::microseconds(static_cast<int64_t>(oversleepMean + 2.0 * oversleepDeviation));
+		spinThreshold = std::max<Clock::duration>(minimumSpinThreshold, std::min<Clock::duration>(maximumSpinThreshold, threshold));
+	}
+}
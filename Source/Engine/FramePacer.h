@@ -0,0 +1,60 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace Biendeo::VulkanGame {
+	enum class PacingMode {
+		// Don't wait at all, draw as fast as possible.
+		None,
+		// Let the OS sleep the whole way to the deadline.
+		Sleep,
+		// Sleep most of the way, then spin for the last stretch.
+		Hybrid,
+		// Yield until the last 50us, then busy-spin the rest of the way to the deadline.
+		Spin
+	};
+
+	// How late a pacer wakes up after its deadline, in microseconds.
+	struct WakeJitter {
+		double mean;
+		double p50;
+		double p99;
+		double max;
+	};
+
+	class FramePacer {
+		public:
+		typedef std::chrono::steady_clock Clock;
+
+		FramePacer(PacingMode mode = PacingMode::Hybrid);
+
+		// Waits until the deadline. Returns false if the deadline had already passed.
+		bool WaitUntil(Clock::time_point deadline);
+
+		PacingMode Mode();
+		PacingMode Mode(PacingMode mode);
+
+		Clock::duration SpinThreshold();
+		uint64_t LateFrames();
+
+		static WakeJitter MeasureWakeJitter(PacingMode mode, int samples, Clock::duration interval);
+
+		// Turns NONE, SLEEP, HYBRID or SPIN into a mode. Returns false and leaves mode alone otherwise.
+		static bool ParseMode(const std::string& name, PacingMode& mode);
+
+		private:
+		PacingMode mode;
+		uint64_t lateFrames;
+
+		// A running estimate of how much the OS oversleeps by, so we know how early to stop sleeping.
+		double oversleepMean;
+		double oversleepDeviation;
+		Clock::duration spinThreshold;
+
+		void SleepUntil(Clock::time_point deadline);
+		void SpinUntil(Clock::time_point deadline);
+		void UpdateSpinThreshold(Clock::duration oversleep);
+	};
+}
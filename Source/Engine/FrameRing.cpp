@@ -0,0 +1,145 @@
+#include "FrameRing.h"
+
+#include <algorithm>
+
+namespace Biendeo::VulkanGame {
+	namespace {
+		const vk::DeviceSize FramePoolSize = 4ull * 1024ull * 1024ull;
+		const vk::DeviceSize TransientPoolSize = 8ull * 1024ull * 1024ull;
+
+		// Which memory types a buffer can use depends on its usage, so each pool asks with a buffer that
+		// has every usage its buffers might.
+		vk::MemoryRequirements PoolRequirements(vk::Device device, vk::DeviceSize size, vk::BufferUsageFlags usage) {
+			vk::Buffer probe = device.createBuffer(vk::BufferCreateInfo(vk::BufferCreateFlags(), size, usage, vk::SharingMode::eExclusive));
+			vk::MemoryRequirements requirements = device.getBufferMemoryRequirements(probe);
+			device.destroyBuffer(probe);
+			return requirements;
+		}
+	}
+
+	FrameRing::FrameRing(GpuAllocator* allocator, uint32_t queueFamily, uint32_t framesInFlight, uint32_t workerCount) {
+		this->device = allocator->Device();
+		this->index = 0;
+
+		// Copied out first, since std::min takes a reference and the constant has nothing out of class for
+		// it to refer to.
+		const uint32_t maxFramesInFlight = MaxFramesInFlight;
+		framesInFlight = std::max(1u, std::min(maxFramesInFlight, framesInFlight));
+		contexts.resize(framesInFlight);
+
+		vk::BufferUsageFlags sharedUsage = vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eIndexBuffer | vk::BufferUsageFlagBits::eIndirectBuffer | vk::BufferUsageFlagBits::eTransferSrc;
+		vk::MemoryRequirements frameRequirements = PoolRequirements(device, FramePoolSize, sharedUsage | vk::BufferUsageFlagBits::eUniformBuffer);
+		vk::MemoryRequirements transientRequirements = PoolRequirements(device, TransientPoolSize, sharedUsage | vk::BufferUsageFlagBits::eTransferDst);
+
+		for (FrameContext& context : contexts) {
+			// Each frame's pool gets reset as a whole, which is cheaper than resetting buffers one by one.
+			context.commandPool = device.createCommandPool(vk::CommandPoolCreateInfo(vk::CommandPoolCreateFlagBits::eTransient, queueFamily));
+			context.commandBuffer = device.allocateCommandBuffers(vk::CommandBufferAllocateInfo(context.commandPool, vk::CommandBufferLevel::ePrimary, 1))[0];
+
+			for (uint32_t i = 0; i < workerCount; ++i) {
+				context.workerPools.push_back(device.createCommandPool(vk::CommandPoolCreateInfo(vk::CommandPoolCreateFlagBits::eTransient, queueFamily)));
+			}
+			context.secondaryBuffers.resize(workerCount);
+			context.secondariesUsed.resize(workerCount, 0);
+
+			// Fences start signalled so the first lap around the ring doesn't wait on work that never ran.
+			context.fence = device.createFence(vk::FenceCreateInfo(vk::FenceCreateFlagBits::eSignaled));
+			context.imageAcquired = device.createSemaphore(vk::SemaphoreCreateInfo());
+			context.renderFinished = device.createSemaphore(vk::SemaphoreCreateInfo());
+			context.framePool = new GpuLinearPool(allocator, frameRequirements, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+			context.transientPool = new GpuLinearPool(allocator, transientRequirements, vk::MemoryPropertyFlagBits::eDeviceLocal);
+			context.frameNumber = 0ull;
+		}
+	}
+
+	FrameRing::~FrameRing() {
+		for (FrameContext& context : contexts) {
+			device.waitForFences(context.fence, VK_TRUE, UINT64_MAX);
+		}
+
+		for (FrameContext& context : contexts) {
+			ReleaseBuffers(context);
+			delete context.transientPool;
+			delete context.framePool;
+			device.destroySemaphore(context.renderFinished);
+			device.destroySemaphore(context.imageAcquired);
+			device.destroyFence(context.fence);
+			for (vk::CommandPool pool : context.workerPools) {
+				device.destroyCommandPool(pool);
+			}
+			device.destroyCommandPool(context.commandPool);
+		}
+	}
+
+	FrameContext& FrameRing::Begin(uint64_t frameNumber) {
+		index = (index + 1) % contexts.size();
+		FrameContext& context = contexts[index];
+
+		device.waitForFences(context.fence, VK_TRUE, UINT64_MAX);
+		device.resetCommandPool(context.commandPool, vk::CommandPoolResetFlags());
+		for (size_t i = 0; i < context.workerPools.size(); ++i) {
+			device.resetCommandPool(context.workerPools[i], vk::CommandPoolResetFlags());
+			context.secondariesUsed[i] = 0;
+		}
+		ReleaseBuffers(context);
+
+		context.frameNumber = frameNumber;
+		return context;
+	}
+
+	FrameContext& FrameRing::Current() {
+		return contexts[index];
+	}
+
+	vk::CommandBuffer FrameRing::SecondaryBuffer(uint32_t worker) {
+		FrameContext& context = contexts[index];
+		std::vector<vk::CommandBuffer>& buffers = context.secondaryBuffers[worker];
+		if (context.secondariesUsed[worker] == buffers.size()) {
+			buffers.push_back(device.allocateCommandBuffers(vk::CommandBufferAllocateInfo(context.workerPools[worker], vk::CommandBufferLevel::eSecondary, 1))[0]);
+		}
+		return buffers[context.secondariesUsed[worker]++];
+	}
+
+	void FrameRing::Submit(vk::Queue queue, const vk::SubmitInfo& submitInfo) {
+		// The fence is only reset once we know something will signal it again.
+		FrameContext& context = contexts[index];
+		device.resetFences(context.fence);
+		queue.submit(submitInfo, context.fence);
+	}
+
+	vk::Buffer FrameRing::CreateFrameBuffer(vk::DeviceSize size, vk::BufferUsageFlags usage, GpuAllocation& allocation) {
+		return CreatePoolBuffer(contexts[index].framePool, size, usage, allocation);
+	}
+
+	vk::Buffer FrameRing::CreateTransientBuffer(vk::DeviceSize size, vk::BufferUsageFlags usage, GpuAllocation& allocation) {
+		return CreatePoolBuffer(contexts[index].transientPool, size, usage, allocation);
+	}
+
+	uint32_t FrameRing::FramesInFlight() {
+		return static_cast<uint32_t>(contexts.size());
+	}
+
+	uint32_t FrameRing::Index() {
+		return index;
+	}
+
+	vk::Buffer FrameRing::CreatePoolBuffer(GpuLinearPool* pool, vk::DeviceSize size, vk::BufferUsageFlags usage, GpuAllocation& allocation) {
+		vk::Buffer buffer = device.createBuffer(vk::BufferCreateInfo(vk::BufferCreateFlags(), size, usage, vk::SharingMode::eExclusive));
+		if (!pool->Allocate(device.getBufferMemoryRequirements(buffer), allocation)) {
+			device.destroyBuffer(buffer);
+			return vk::Buffer();
+		}
+		device.bindBufferMemory(buffer, allocation.memory, allocation.offset);
+		contexts[index].buffers.push_back(buffer);
+		return buffer;
+	}
+
+	void FrameRing::ReleaseBuffers(FrameContext& context) {
+		for (vk::Buffer buffer : context.buffers) {
+			device.destroyBuffer(buffer);
+		}
+		context.buffers.clear();
+		context.framePool->Reset();
+		context.transientPool->Reset();
+	}
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <vulkan/vulkan.hpp>
+
+#include "GpuAllocator.h"
+
+namespace Biendeo::VulkanGame {
+	// Everything a single frame needs to itself while the GPU might still be working on it.
+	struct FrameContext {
+		vk::CommandPool commandPool;
+		vk::CommandBuffer commandBuffer;
+
+		// Each job thread gets its own pool, since a pool can only be recorded from by one thread at a time.
+		// Secondary buffers stay allocated between laps and are handed out again after the pool resets.
+		std::vector<vk::CommandPool> workerPools;
+		std::vector<std::vector<vk::CommandBuffer>> secondaryBuffers;
+		std::vector<size_t> secondariesUsed;
+
+		// Signalled when the GPU has finished with this frame.
+		vk::Fence fence;
+		vk::Semaphore imageAcquired;
+		vk::Semaphore renderFinished;
+
+		// Buffers that only live as long as the frame, released the next time the context comes around.
+		// Their memory comes out of the frame's own pools, which are emptied at the same time. The frame
+		// pool is host visible for data the CPU writes each frame, and the transient pool is device local
+		// for scratch space only the GPU touches.
+		std::vector<vk::Buffer> buffers;
+		GpuLinearPool* framePool;
+		GpuLinearPool* transientPool;
+
+		uint64_t frameNumber;
+	};
+
+	// A ring of frame contexts, so the CPU can record one frame while the GPU is still running the last.
+	class FrameRing {
+		public:
+		static const uint32_t MaxFramesInFlight = 3;
+
+		FrameRing(GpuAllocator* allocator, uint32_t queueFamily, uint32_t framesInFlight, uint32_t workerCount);
+		~FrameRing();
+
+		// Moves on to the next context, waiting for the GPU to finish with it first.
+		FrameContext& Begin(uint64_t frameNumber);
+		FrameContext& Current();
+
+		// Hands out a secondary command buffer from the given worker's pool for the current frame. Only
+		// that worker may call this with its index.
+		vk::CommandBuffer SecondaryBuffer(uint32_t worker);
+
+		void Submit(vk::Queue queue, const vk::SubmitInfo& submitInfo);
+		// These make a buffer that's destroyed once the GPU is done with this frame, either host visible
+		// and mapped or device local. They return a null buffer if that pool has run out or the usage
+		// doesn't suit its memory.
+		vk::Buffer CreateFrameBuffer(vk::DeviceSize size, vk::BufferUsageFlags usage, GpuAllocation& allocation);
+		vk::Buffer CreateTransientBuffer(vk::DeviceSize size, vk::BufferUsageFlags usage, GpuAllocation& allocation);
+
+		uint32_t FramesInFlight();
+		uint32_t Index();
+
+		private:
+		vk::Device device;
+		std::vector<FrameContext> contexts;
+		uint32_t index;
+
+		vk::Buffer CreatePoolBuffer(GpuLinearPool* pool, vk::DeviceSize size, vk::BufferUsageFlags usage, GpuAllocation& allocation);
+		void ReleaseBuffers(FrameContext& context);
+	};
+}
@@ -0,0 +1,213 @@
+#include "FrameStatistics.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace Biendeo::VulkanGame {
+	namespace {
+		PhaseSummary SummarisePhase(std::vector<double>& samples) {
+			PhaseSummary summary = {0.0, 0.0, 0.0, 0.0, 0.0};
+			if (samples.empty()) {
+				return summary;
+			}
+
+			for (double sample : samples) {
+				summary.mean += sample;
+			}
+			summary.mean /= samples.size();
+
+			std::sort(samples.begin(), samples.end());
+			summary.p50 = FrameStatistics::Percentile(samples, 50);
+			summary.p95 = FrameStatistics::Percentile(samples, 95);
+			summary.p99 = FrameStatistics::Percentile(samples, 99);
+			summary.max = samples.back();
+			return summary;
+		}
+
+		void WritePhaseJSON(std::ostream& file, const char* name, const PhaseSummary& phase, bool last) {
+			file << "\t\t\"" << name << "\": { ";
+			file << "\"mean\": " << phase.mean * 1000.0 << ", ";
+			file << "\"p50\": " << phase.p50 * 1000.0 << ", ";
+			file << "\"p95\": " << phase.p95 * 1000.0 << ", ";
+			file << "\"p99\": " << phase.p99 * 1000.0 << ", ";
+			file << "\"max\": " << phase.max * 1000.0 << " }";
+			file << (last ? "\n" : ",\n");
+		}
+	}
+
+	FrameStatistics::FrameStatistics(double hitchThreshold) : head(0ull), hitches(0ull) {
+		this->hitchThreshold = hitchThreshold;
+		for (std::atomic<float>& gpuTime : gpuTimes) {
+			gpuTime.store(0.0f, std::memory_order_relaxed);
+		}
+	}
+
+	void FrameStatistics::Record(const FrameTiming& timing) {
+		uint64_t index = head.load(std::memory_order_relaxed);
+		timings[index % Capacity] = timing;
+		gpuTimes[index % Capacity].store(static_cast<float>(timing.gpu), std::memory_order_relaxed);
+
+		if (timing.total > hitchThreshold) {
+			hitches.fetch_add(1ull, std::memory_order_relaxed);
+		}
+
+		// Publishing the new head after the write means readers never see a half-written slot as new.
+		head.store(index + 1, std::memory_order_release);
+	}
+
+	void FrameStatistics::RecordGpu(uint64_t frame, double gpu) {
+		// The frame we're after is only a few slots back, so there's no point searching the whole ring.
+		// Only this thread writes the timings, so reading their frame numbers here is safe, but the time
+		// itself has to go through the atomic since readers might be copying the slot.
+		uint64_t index = head.load(std::memory_order_relaxed);
+		for (uint64_t i = index; i > 0 && index - i < 8; --i) {
+			if (timings[(i - 1) % Capacity].frame == frame) {
+				gpuTimes[(i - 1) % Capacity].store(static_cast<float>(gpu), std::memory_order_relaxed);
+				return;
+			}
+		}
+	}
+
+	std::vector<FrameTiming> FrameStatistics::Snapshot() {
+		uint64_t end = head.load(std::memory_order_acquire);
+		uint64_t begin = end > Capacity ? end - Capacity : 0ull;
+
+		std::vector<FrameTiming> snapshot;
+		snapshot.reserve(static_cast<size_t>(end - begin));
+		for (uint64_t i = begin; i < end; ++i) {
+			snapshot.push_back(timings[i % Capacity]);
+			snapshot.back().gpu = gpuTimes[i % Capacity].load(std::memory_order_relaxed);
+		}
+
+		// Anything the writer lapped while we were copying may be torn, so it gets dropped. That includes
+		// the slot for index after, which the writer could be in the middle of filling. The fence keeps
+		// the copies above from being moved past the second load of head. A GPU time that lands after its
+		// slot was copied just means the snapshot doesn't have it yet.
+		std::atomic_thread_fence(std::memory_order_acquire);
+		uint64_t after = head.load(std::memory_order_relaxed);
+		uint64_t overwritten = after + 1 > Capacity ? after + 1 - Capacity : 0ull;
+		if (overwritten > begin) {
+			size_t torn = static_cast<size_t>(std::min(overwritten, end) - begin);
+			snapshot.erase(snapshot.begin(), snapshot.begin() + torn);
+		}
+		return snapshot;
+	}
+
+	FrameSummary FrameStatistics::Summarise() {
+		FrameSummary summary = Summarise(Snapshot(), hitchThreshold);
+
+		// The ring only holds recent frames, but the hitch count covers the whole run.
+		summary.hitches = HitchCount();
+		return summary;
+	}
+
+	FrameSummary FrameStatistics::Summarise(const std::vector<FrameTiming>& timings, double hitchThreshold) {
+		std::vector<double> update, draw, sleep, present, total, gpu;
+		uint64_t hitches = 0ull;
+		uint64_t gpuBound = 0ull;
+		for (const FrameTiming& timing : timings) {
+			update.push_back(timing.update);
+			draw.push_back(timing.draw);
+			sleep.push_back(timing.sleep);
+			present.push_back(timing.present);
+			total.push_back(timing.total);
+			if (timing.total > hitchThreshold) {
+				++hitches;
+			}
+			// Frames the GPU never reported on would drag its percentiles down, so they're left out.
+			if (timing.gpu > 0.0) {
+				gpu.push_back(timing.gpu);
+				if (timing.gpu > timing.update + timing.draw) {
+					++gpuBound;
+				}
+			}
+		}
+
+		FrameSummary summary;
+		summary.frames = timings.size();
+		summary.hitches = hitches;
+		summary.gpuBound = gpuBound;
+		summary.gpuMeasured = gpu.size();
+		summary.update = SummarisePhase(update);
+		summary.draw = SummarisePhase(draw);
+		summary.sleep = SummarisePhase(sleep);
+		summary.present = SummarisePhase(present);
+		summary.total = SummarisePhase(total);
+		summary.gpu = SummarisePhase(gpu);
+		return summary;
+	}
+
+	double FrameStatistics::Percentile(const std::vector<double>& sorted, size_t percent) {
+		if (sorted.empty()) {
+			return 0.0;
+		}
+		return sorted[(sorted.size() - 1) * percent / 100];
+	}
+
+	uint64_t FrameStatistics::RecordedFrames() {
+		return head.load(std::memory_order_acquire);
+	}
+
+	uint64_t FrameStatistics::HitchCount() {
+		return hitches.load(std::memory_order_relaxed);
+	}
+
+	double FrameStatistics::HitchThreshold() {
+		return hitchThreshold;
+	}
+
+	double FrameStatistics::HitchThreshold(double hitchThreshold) {
+		this->hitchThreshold = hitchThreshold;
+		return hitchThreshold;
+	}
+
+	bool FrameStatistics::WriteCSV(const std::string& path) {
+		std::ofstream file(path);
+		if (!file) {
+			return false;
+		}
+
+		// Times are written in milliseconds since that's what people read frame times in.
+		file << "frame,update_ms,draw_ms,sleep_ms,present_ms,total_ms,gpu_ms\n";
+		for (const FrameTiming& timing : Snapshot()) {
+			file << timing.frame << ",";
+			file << timing.update * 1000.0 << ",";
+			file << timing.draw * 1000.0 << ",";
+			file << timing.sleep * 1000.0 << ",";
+			file << timing.present * 1000.0 << ",";
+			file << timing.total * 1000.0 << ",";
+			file << timing.gpu * 1000.0 << "\n";
+		}
+		return file.good();
+	}
+
+	bool FrameStatistics::WriteJSON(const std::string& path) {
+		std::ofstream file(path);
+		if (!file) {
+			return false;
+		}
+
+		FrameSummary summary = Summarise();
+		file << "{\n";
+		file << "\t\"recordedFrames\": " << RecordedFrames() << ",\n";
+		file << "\t\"sampledFrames\": " << summary.frames << ",\n";
+		file << "\t\"hitches\": " << summary.hitches << ",\n";
+		file << "\t\"hitchThresholdMs\": " << hitchThreshold * 1000.0 << ",\n";
+		file << "\t\"gpuMeasuredFrames\": " << summary.gpuMeasured << ",\n";
+		file << "\t\"gpuBoundFrames\": " << summary.gpuBound << ",\n";
+		WritePhasesJSON(file, summary);
+		file << "}\n";
+		return file.good();
+	}
+
+	void FrameStatistics::WritePhasesJSON(std::ostream& file, const FrameSummary& summary) {
+		file << "\t\"phasesMs\": {\n";
+		WritePhaseJSON(file, "update", summary.update, false);
+		WritePhaseJSON(file, "draw", summary.draw, false);
+		WritePhaseJSON(file, "sleep", summary.sleep, false);
+		WritePhaseJSON(file, "present", summary.present, false);
+		WritePhaseJSON(file, "total", summary.total, false);
+		WritePhaseJSON(file, "gpu", summary.gpu, true);
+		file << "\t}\n";
+	}
+}
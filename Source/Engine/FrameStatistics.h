@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Biendeo::VulkanGame {
+	// How long each phase of a frame took on the CPU, in seconds. The GPU's time for the frame only turns
+	// up a lap of the frame ring later, so it's filled in then, and stays zero if it never arrives.
+	struct FrameTiming {
+		uint64_t frame;
+		double update;
+		double draw;
+		double sleep;
+		double present;
+		double total;
+		double gpu;
+	};
+
+	struct PhaseSummary {
+		double mean;
+		double p50;
+		double p95;
+		double p99;
+		double max;
+	};
+
+	struct FrameSummary {
+		size_t frames;
+		uint64_t hitches;
+
+		// Frames where the GPU took longer than the CPU spent updating and recording, out of the frames the
+		// GPU was measured for.
+		uint64_t gpuBound;
+		uint64_t gpuMeasured;
+
+		PhaseSummary update;
+		PhaseSummary draw;
+		PhaseSummary sleep;
+		PhaseSummary present;
+		PhaseSummary total;
+		PhaseSummary gpu;
+	};
+
+	// Keeps the most recent frame timings in a fixed ring. Only the frame thread records, but any thread
+	// can take a snapshot without locking it.
+	class FrameStatistics {
+		public:
+		static const size_t Capacity = 1024;
+
+		FrameStatistics(double hitchThreshold);
+
+		void Record(const FrameTiming& timing);
+
+		// Fills in the GPU time of a frame that's already been recorded. Does nothing if it's been lapped.
+		// Like Record, only the frame thread may call this.
+		void RecordGpu(uint64_t frame, double gpu);
+		std::vector<FrameTiming> Snapshot();
+		FrameSummary Summarise();
+
+		static FrameSummary Summarise(const std::vector<FrameTiming>& timings, double hitchThreshold);
+
+		// The sample percent of the way along an already sorted list, picked the same way for every
+		// summary so numbers from different places can be compared. Zero for an empty list.
+		static double Percentile(const std::vector<double>& sorted, size_t percent);
+		static void WritePhasesJSON(std::ostream& file, const FrameSummary& summary);
+
+		uint64_t RecordedFrames();
+		uint64_t HitchCount();
+
+		double HitchThreshold();
+		double HitchThreshold(double hitchThreshold);
+
+		bool WriteCSV(const std::string& path);
+		bool WriteJSON(const std::string& path);
+
+		private:
+		FrameTiming timings[Capacity];
+
+		// GPU times arrive after their slot's been published, so they're kept apart from the timings where
+		// readers can pick them up at any time. Each one goes with the timing in the same slot.
+		std::atomic<float> gpuTimes[Capacity];
+		std::atomic<uint64_t> head;
+		std::atomic<uint64_t> hitches;
+		double hitchThreshold;
+	};
+}
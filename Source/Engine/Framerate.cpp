@@ -1,40 +1,82 @@
 #include "Framerate.h"
 
-#include <thread>
-
-#define GLFW_INCLUDE_VULKAN
-#include <GLFW/glfw3.h>
+#include <cmath>
 
 namespace Biendeo::VulkanGame {
-	Framerate::Framerate(short expectedFPS) {
+	namespace {
+		// A frame taking this many times longer than it should counts as a hitch.
+		const double hitchFactor = 1.5;
+	}
+
+	Framerate::Framerate(short expectedFPS, short tickRate) : statistics(hitchFactor / expectedFPS) {
 		this->expectedFPS = expectedFPS;
 		this->frameCount = 0ull;
+		this->tickRate = tickRate;
+		this->maxTicksPerFrame = 5;
+		this->ticksThisFrame = 0;
+		this->accumulator = 0.0;
+		this->tickCount = 0ull;
+		this->fixedFrameDelta = 0.0;
+		this->startTime = FramePacer::Clock::now();
+		this->lastDraw = Now();
+		this->nextDraw = lastDraw;
 		UpdateDrawTimes();
 	}
 
 	void Framerate::SleepToNextSwapBuffer() {
-		double currentTime = glfwGetTime();
-		auto nanos = static_cast<uint64_t>((nextDraw - currentTime) * 1000000000.0);
-		std::this_thread::sleep_for(std::chrono::nanoseconds(nanos));
+		auto deadline = startTime + std::chrono::duration_cast<FramePacer::Clock::duration>(std::chrono::duration<double>(nextDraw));
+		pacer.WaitUntil(deadline);
 	}
 
 	void Framerate::UpdateDrawTimes() {
 		double previousDraw = this->lastDraw;
-		this->lastDraw = glfwGetTime();
+		this->lastDraw = Now();
 		this->delta = this->lastDraw - previousDraw;
-		this->nextDraw = lastDraw + 1.0 / expectedFPS;
+
+		// Deadlines advance by whole frames so small overruns are made up next frame. If we've fallen
+		// more than a frame behind, the schedule starts again from now instead of rushing to catch up.
+		double period = 1.0 / expectedFPS;
+		this->nextDraw += period;
+		if (this->nextDraw <= this->lastDraw) {
+			this->nextDraw = this->lastDraw + period;
+		}
+
+		// The time that's passed gets handed to the simulation in fixed ticks. With a fixed frame delta
+		// the simulation ignores the wall clock entirely, so runs are repeatable.
+		this->accumulator += this->fixedFrameDelta > 0.0 ? this->fixedFrameDelta : this->delta;
+		this->ticksThisFrame = 0;
 	}
 
 	uint64_t Framerate::IncrementFrameCount() {
 		return ++frameCount;
 	}
 
+	bool Framerate::ConsumeTick() {
+		double tickDelta = TickDelta();
+		if (accumulator < tickDelta) {
+			return false;
+		}
+
+		// If we've hit the catch-up cap, the rest of the backlog is dropped so a long stall doesn't make
+		// every following frame spend its time simulating. Only the partial tick is kept for interpolation.
+		if (ticksThisFrame >= maxTicksPerFrame) {
+			accumulator = std::fmod(accumulator, tickDelta);
+			return false;
+		}
+
+		accumulator -= tickDelta;
+		++ticksThisFrame;
+		++tickCount;
+		return true;
+	}
+
 	short Framerate::ExpectedFPS() {
 		return expectedFPS;
 	}
 
 	short Framerate::ExpectedFPS(short expectedFPS) {
 		this->expectedFPS = expectedFPS;
+		statistics.HitchThreshold(hitchFactor / expectedFPS);
 		return expectedFPS;
 	}
 
@@ -45,4 +87,66 @@ namespace Biendeo::VulkanGame {
 	double Framerate::Delta() {
 		return delta;
 	}
+
+	double Framerate::Alpha() {
+		// How far between the last two ticks this frame is, for interpolating simulation state.
+		return accumulator / TickDelta();
+	}
+
+	short Framerate::TickRate() {
+		return tickRate;
+	}
+
+	short Framerate::TickRate(short tickRate) {
+		this->tickRate = tickRate;
+		return tickRate;
+	}
+
+	double Framerate::TickDelta() {
+		return 1.0 / tickRate;
+	}
+
+	short Framerate::MaxTicksPerFrame() {
+		return maxTicksPerFrame;
+	}
+
+	short Framerate::MaxTicksPerFrame(short maxTicksPerFrame) {
+		this->maxTicksPerFrame = maxTicksPerFrame;
+		return maxTicksPerFrame;
+	}
+
+	uint64_t Framerate::TickCount() {
+		return tickCount;
+	}
+
+	double Framerate::FixedFrameDelta() {
+		return fixedFrameDelta;
+	}
+
+	double Framerate::FixedFrameDelta(double fixedFrameDelta) {
+		// Whatever wall time had built up would make the first frames differ between runs.
+		this->fixedFrameDelta = fixedFrameDelta;
+		this->accumulator = 0.0;
+		return fixedFrameDelta;
+	}
+
+	PacingMode Framerate::Pacing() {
+		return pacer.Mode();
+	}
+
+	PacingMode Framerate::Pacing(PacingMode mode) {
+		return pacer.Mode(mode);
+	}
+
+	uint64_t Framerate::LateFrames() {
+		return pacer.LateFrames();
+	}
+
+	double Framerate::Now() {
+		return std::chrono::duration<double>(FramePacer::Clock::now() - startTime).count();
+	}
+
+	FrameStatistics& Framerate::Statistics() {
+		return statistics;
+	}
 }
\ No newline at end of file
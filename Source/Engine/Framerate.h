@@ -2,21 +2,47 @@
 
 #include <cstdint>
 
+#include "FramePacer.h"
+#include "FrameStatistics.h"
+
 namespace Biendeo::VulkanGame {
 	class Framerate {
 		public:
-		Framerate(short expectedFPS);
+		Framerate(short expectedFPS, short tickRate = 60);
 
 		void SleepToNextSwapBuffer();
 		void UpdateDrawTimes();
 		uint64_t IncrementFrameCount();
 
+		bool ConsumeTick();
+
 		short ExpectedFPS();
 		short ExpectedFPS(short expectedFPS);
 
 		uint64_t FrameCount();
 
 		double Delta();
+		double Alpha();
+
+		short TickRate();
+		short TickRate(short tickRate);
+		double TickDelta();
+
+		short MaxTicksPerFrame();
+		short MaxTicksPerFrame(short maxTicksPerFrame);
+
+		uint64_t TickCount();
+
+		double FixedFrameDelta();
+		double FixedFrameDelta(double fixedFrameDelta);
+
+		PacingMode Pacing();
+		PacingMode Pacing(PacingMode mode);
+		uint64_t LateFrames();
+
+		double Now();
+
+		FrameStatistics& Statistics();
 
 		private:
 		short expectedFPS;
@@ -24,5 +50,17 @@ namespace Biendeo::VulkanGame {
 		double lastDraw;
 		double nextDraw;
 		uint64_t frameCount;
+
+		short tickRate;
+		short maxTicksPerFrame;
+		short ticksThisFrame;
+		double accumulator;
+		uint64_t tickCount;
+		double fixedFrameDelta;
+
+		FramePacer pacer;
+		FramePacer::Clock::time_point startTime;
+
+		FrameStatistics statistics;
 	};
 }
@@ -0,0 +1,210 @@
+#include "GpuAllocator.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Biendeo::VulkanGame {
+	namespace {
+		// Smaller pieces than this cost more in bookkeeping than they'd save.
+		const vk::DeviceSize SmallestNode = 256;
+	}
+
+	GpuAllocator::GpuAllocator(vk::PhysicalDevice physicalDevice, vk::Device device, vk::DeviceSize blockSize) {
+		this->physicalDevice = physicalDevice;
+		this->device = device;
+		this->memoryProperties = physicalDevice.getMemoryProperties();
+		this->blockSize = NextPowerOfTwo(blockSize);
+		this->dedicatedAllocations = 0;
+		this->dedicatedBytes = 0;
+
+		// Nodes are aligned to their own size, so keeping them at least as big as the buffer-image
+		// granularity means a buffer and an image can never end up sharing a page.
+		vk::DeviceSize granularity = physicalDevice.getProperties().limits.bufferImageGranularity;
+		this->minimumNodeSize = std::min(this->blockSize, NextPowerOfTwo(std::max(SmallestNode, granularity)));
+	}
+
+	GpuAllocator::~GpuAllocator() {
+		for (Block& block : blocks) {
+			if (block.mapped != nullptr) {
+				device.unmapMemory(block.memory);
+			}
+			device.freeMemory(block.memory);
+		}
+	}
+
+	GpuAllocation GpuAllocator::Allocate(const vk::MemoryRequirements& requirements, vk::MemoryPropertyFlags properties) {
+		uint32_t memoryType = FindMemoryType(requirements.memoryTypeBits, properties);
+		GpuAllocation allocation = GpuAllocation();
+
+		// Big resources would waste most of a block, so they get memory of their own.
+		if (requirements.size > blockSize / 2) {
+			allocation.memory = device.allocateMemory(vk::MemoryAllocateInfo(requirements.size, memoryType));
+			allocation.offset = 0;
+			allocation.size = requirements.size;
+			allocation.mapped = MapIfHostVisible(allocation.memory, memoryType, requirements.size);
+			allocation.memoryType = memoryType;
+			allocation.block = GpuAllocation::Dedicated;
+			allocation.level = 0;
+
+			std::lock_guard<std::mutex> lock(mutex);
+			++dedicatedAllocations;
+			dedicatedBytes += requirements.size;
+			return allocation;
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+		for (uint32_t i = 0; i < blocks.size(); ++i) {
+			if (blocks[i].memoryType == memoryType && AllocateFromBlock(i, requirements, allocation)) {
+				return allocation;
+			}
+		}
+
+		uint32_t blockIndex = CreateBlock(memoryType);
+		if (!AllocateFromBlock(blockIndex, requirements, allocation)) {
+			throw std::runtime_error("A fresh memory block couldn't fit an allocation.");
+		}
+		return allocation;
+	}
+
+	void GpuAllocator::Free(GpuAllocation& allocation) {
+		if (!allocation.memory) {
+			return;
+		}
+
+		if (allocation.block == GpuAllocation::Dedicated) {
+			if (allocation.mapped != nullptr) {
+				device.unmapMemory(allocation.memory);
+			}
+			device.freeMemory(allocation.memory);
+
+			std::lock_guard<std::mutex> lock(mutex);
+			--dedicatedAllocations;
+			dedicatedBytes -= allocation.size;
+		} else {
+			std::lock_guard<std::mutex> lock(mutex);
+			blocks[allocation.block].nodes.Free(allocation.offset, allocation.level);
+		}
+
+		allocation = GpuAllocation();
+	}
+
+	GpuAllocation GpuAllocator::AllocateImage(vk::Image image, vk::MemoryPropertyFlags properties) {
+		GpuAllocation allocation = Allocate(device.getImageMemoryRequirements(image), properties);
+		device.bindImageMemory(image, allocation.memory, allocation.offset);
+		return allocation;
+	}
+
+	GpuAllocation GpuAllocator::AllocateBuffer(vk::Buffer buffer, vk::MemoryPropertyFlags properties) {
+		GpuAllocation allocation = Allocate(device.getBufferMemoryRequirements(buffer), properties);
+		device.bindBufferMemory(buffer, allocation.memory, allocation.offset);
+		return allocation;
+	}
+
+	GpuMemoryStatistics GpuAllocator::Statistics() {
+		std::lock_guard<std::mutex> lock(mutex);
+		GpuMemoryStatistics statistics = GpuMemoryStatistics();
+		statistics.blocks = static_cast<uint32_t>(blocks.size());
+		statistics.dedicatedAllocations = dedicatedAllocations;
+		statistics.allocations = dedicatedAllocations;
+		statistics.reserved = dedicatedBytes;
+		statistics.used = dedicatedBytes;
+
+		vk::DeviceSize free = 0;
+		for (Block& block : blocks) {
+			statistics.allocations += block.nodes.Allocations();
+			statistics.reserved += blockSize;
+			statistics.used += block.nodes.Used();
+			free += blockSize - block.nodes.Used();
+			statistics.largestFreeRange = std::max(statistics.largestFreeRange, block.nodes.LargestFree());
+		}
+
+		statistics.fragmentation = free > 0 ? 1.0 - static_cast<double>(statistics.largestFreeRange) / free : 0.0;
+		return statistics;
+	}
+
+	vk::Device GpuAllocator::Device() {
+		return device;
+	}
+
+	uint32_t GpuAllocator::FindMemoryType(uint32_t typeBits, vk::MemoryPropertyFlags properties) {
+		for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i) {
+			if ((typeBits & (1u << i)) && (memoryProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+				return i;
+			}
+		}
+		throw std::runtime_error("No suitable memory type for an allocation.");
+	}
+
+	bool GpuAllocator::AllocateFromBlock(uint32_t blockIndex, const vk::MemoryRequirements& requirements, GpuAllocation& allocation) {
+		Block& block = blocks[blockIndex];
+		uint32_t level = block.nodes.LevelFor(requirements.size, requirements.alignment);
+		uint64_t offset = 0;
+		if (!block.nodes.Allocate(level, offset)) {
+			return false;
+		}
+
+		allocation.memory = block.memory;
+		allocation.offset = offset;
+		allocation.size = block.nodes.NodeSize(level);
+		allocation.mapped = block.mapped != nullptr ? static_cast<uint8_t*>(block.mapped) + offset : nullptr;
+		allocation.memoryType = block.memoryType;
+		allocation.block = blockIndex;
+		allocation.level = level;
+		return true;
+	}
+
+	uint32_t GpuAllocator::CreateBlock(uint32_t memoryType) {
+		vk::DeviceMemory memory = device.allocateMemory(vk::MemoryAllocateInfo(blockSize, memoryType));
+		Block block = { memory, memoryType, MapIfHostVisible(memory, memoryType, blockSize), BuddyAllocator(blockSize, minimumNodeSize) };
+		blocks.push_back(block);
+		return static_cast<uint32_t>(blocks.size() - 1);
+	}
+
+	void* GpuAllocator::MapIfHostVisible(vk::DeviceMemory memory, uint32_t memoryType, vk::DeviceSize size) {
+		// Host-visible memory stays mapped for as long as it's around; mapping on demand costs more.
+		if (memoryProperties.memoryTypes[memoryType].propertyFlags & vk::MemoryPropertyFlagBits::eHostVisible) {
+			return device.mapMemory(memory, 0, size);
+		}
+		return nullptr;
+	}
+
+	GpuLinearPool::GpuLinearPool(GpuAllocator* allocator, const vk::MemoryRequirements& requirements, vk::MemoryPropertyFlags properties) : range(requirements.size) {
+		this->allocator = allocator;
+		this->allocation = allocator->Allocate(requirements, properties);
+	}
+
+	GpuLinearPool::~GpuLinearPool() {
+		allocator->Free(allocation);
+	}
+
+	bool GpuLinearPool::Allocate(const vk::MemoryRequirements& requirements, GpuAllocation& piece) {
+		if (!(requirements.memoryTypeBits & (1u << allocation.memoryType))) {
+			return false;
+		}
+
+		// The pool's start is aligned to its own size (or is a whole allocation), so aligning the offset
+		// from it is enough.
+		uint64_t offset = 0;
+		if (!range.Allocate(requirements.size, requirements.alignment, offset)) {
+			return false;
+		}
+
+		piece = allocation;
+		piece.offset = allocation.offset + offset;
+		piece.size = requirements.size;
+		piece.mapped = allocation.mapped != nullptr ? static_cast<uint8_t*>(allocation.mapped) + offset : nullptr;
+		return true;
+	}
+
+	void GpuLinearPool::Reset() {
+		range.Reset();
+	}
+
+	vk::DeviceSize GpuLinearPool::Used() {
+		return range.Used();
+	}
+
+	vk::DeviceSize GpuLinearPool::Size() {
+		return range.Size();
+	}
+}
\ No newline at end of file
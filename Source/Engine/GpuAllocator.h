@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <vulkan/vulkan.hpp>
+
+#include "RangeAllocator.h"
+
+namespace Biendeo::VulkanGame {
+	// A piece of device memory handed out by the allocator. Keep hold of it to free it later.
+	struct GpuAllocation {
+		static const uint32_t Dedicated = UINT32_MAX;
+
+		vk::DeviceMemory memory;
+		vk::DeviceSize offset;
+		vk::DeviceSize size;
+
+		// Points at the start of the allocation if its memory is host visible, otherwise it's null.
+		void* mapped;
+
+		uint32_t memoryType;
+		uint32_t block;
+		uint32_t level;
+	};
+
+	struct GpuMemoryStatistics {
+		uint32_t blocks;
+		uint32_t dedicatedAllocations;
+		uint64_t allocations;
+
+		// Bytes taken from the driver, and how much of that is handed out.
+		vk::DeviceSize reserved;
+		vk::DeviceSize used;
+
+		vk::DeviceSize largestFreeRange;
+
+		// Zero when the free space is all in one piece, approaching one as it gets scattered.
+		double fragmentation;
+	};
+
+	// Takes memory from the driver in large blocks and hands out pieces of them, since drivers only
+	// allow a few thousand allocations and each one is slow. Blocks are split with a BuddyAllocator;
+	// anything bigger than half a block gets its own allocation.
+	class GpuAllocator {
+		public:
+		static const vk::DeviceSize DefaultBlockSize = 64ull * 1024ull * 1024ull;
+
+		GpuAllocator(vk::PhysicalDevice physicalDevice, vk::Device device, vk::DeviceSize blockSize = DefaultBlockSize);
+		~GpuAllocator();
+
+		GpuAllocation Allocate(const vk::MemoryRequirements& requirements, vk::MemoryPropertyFlags properties);
+		void Free(GpuAllocation& allocation);
+
+		// These allocate memory for the resource and bind it straight away.
+		GpuAllocation AllocateImage(vk::Image image, vk::MemoryPropertyFlags properties);
+		GpuAllocation AllocateBuffer(vk::Buffer buffer, vk::MemoryPropertyFlags properties);
+
+		GpuMemoryStatistics Statistics();
+
+		vk::Device Device();
+		uint32_t FindMemoryType(uint32_t typeBits, vk::MemoryPropertyFlags properties);
+
+		private:
+		struct Block {
+			vk::DeviceMemory memory;
+			uint32_t memoryType;
+			void* mapped;
+			BuddyAllocator nodes;
+		};
+
+		vk::PhysicalDevice physicalDevice;
+		vk::Device device;
+		vk::PhysicalDeviceMemoryProperties memoryProperties;
+		vk::DeviceSize blockSize;
+		vk::DeviceSize minimumNodeSize;
+
+		std::mutex mutex;
+		std::vector<Block> blocks;
+		uint32_t dedicatedAllocations;
+		vk::DeviceSize dedicatedBytes;
+
+		bool AllocateFromBlock(uint32_t blockIndex, const vk::MemoryRequirements& requirements, GpuAllocation& allocation);
+		uint32_t CreateBlock(uint32_t memoryType);
+		void* MapIfHostVisible(vk::DeviceMemory memory, uint32_t memoryType, vk::DeviceSize size);
+	};
+
+	// Memory that's handed out by bumping an offset and all given back at once. This suits data that only
+	// lives for a frame. It's meant for buffers, since images might need more space between them.
+	class GpuLinearPool {
+		public:
+		// The requirements give the pool's size and which memory types it may use, so they should come from
+		// the kind of buffer it'll hold.
+		GpuLinearPool(GpuAllocator* allocator, const vk::MemoryRequirements& requirements, vk::MemoryPropertyFlags properties);
+		~GpuLinearPool();
+
+		// Returns false if the pool is full or its memory doesn't suit the requirements. Pieces from here
+		// must never be passed to GpuAllocator::Free.
+		bool Allocate(const vk::MemoryRequirements& requirements, GpuAllocation& allocation);
+		void Reset();
+
+		vk::DeviceSize Used();
+		vk::DeviceSize Size();
+
+		private:
+		GpuAllocator* allocator;
+		GpuAllocation allocation;
+		LinearAllocator range;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,206 @@
+#include "GpuProfiler.h"
+
+#include <algorithm>
+
+namespace Biendeo::VulkanGame {
+	namespace {
+		// Every frame has a start and end timestamp, then a pair for each region.
+		const uint32_t FrameStart = 0;
+		const uint32_t FrameEnd = 1;
+
+		uint32_t RegionStart(uint32_t region) {
+			return 2 + region * 2;
+		}
+
+		const vk::QueryPipelineStatisticFlags StatisticsQueried = vk::QueryPipelineStatisticFlagBits::eVertexShaderInvocations | vk::QueryPipelineStatisticFlagBits::eClippingPrimitives | vk::QueryPipelineStatisticFlagBits::eFragmentShaderInvocations | vk::QueryPipelineStatisticFlagBits::eComputeShaderInvocations;
+	}
+
+	GpuProfiler::GpuProfiler(vk::PhysicalDevice physicalDevice, vk::Device device, uint32_t queueFamily, uint32_t framesInFlight, bool pipelineStatistics) {
+		this->device = device;
+		this->current = 0;
+		this->statistics = pipelineStatistics;
+		this->collectedFrames = 0ull;
+
+		// Some queues can't write timestamps at all, and the rest only count up to a certain number of bits
+		// before wrapping around.
+		uint32_t validBits = physicalDevice.getQueueFamilyProperties()[queueFamily].timestampValidBits;
+		this->timestamps = validBits > 0;
+		this->timestampMask = validBits >= 64 ? UINT64_MAX : (1ull << validBits) - 1ull;
+		this->timestampPeriod = physicalDevice.getProperties().limits.timestampPeriod * 1e-9;
+
+		frames.resize(framesInFlight);
+		for (FrameQueries& frame : frames) {
+			if (timestamps) {
+				frame.timestamps = device.createQueryPool(vk::QueryPoolCreateInfo(vk::QueryPoolCreateFlags(), vk::QueryType::eTimestamp, RegionStart(MaxRegions), vk::QueryPipelineStatisticFlags()));
+			}
+			if (statistics) {
+				frame.statistics = device.createQueryPool(vk::QueryPoolCreateInfo(vk::QueryPoolCreateFlags(), vk::QueryType::ePipelineStatistics, 1, StatisticsQueried));
+			}
+			frame.regionNames.resize(MaxRegions, nullptr);
+			frame.regionCount = 0;
+			frame.frameNumber = 0ull;
+			frame.recorded = false;
+		}
+
+		results.resize(RegionStart(MaxRegions));
+	}
+
+	GpuProfiler::~GpuProfiler() {
+		for (FrameQueries& frame : frames) {
+			if (timestamps) {
+				device.destroyQueryPool(frame.timestamps);
+			}
+			if (statistics) {
+				device.destroyQueryPool(frame.statistics);
+			}
+		}
+	}
+
+	bool GpuProfiler::SupportsStatistics(vk::PhysicalDevice physicalDevice, vk::PhysicalDeviceFeatures& features) {
+		// The frame's draws are all in secondary buffers, so the query has to stay active across them,
+		// which needs inherited queries as well.
+		vk::PhysicalDeviceFeatures available = physicalDevice.getFeatures();
+		if (!available.pipelineStatisticsQuery || !available.inheritedQueries) {
+			return false;
+		}
+		features.pipelineStatisticsQuery = VK_TRUE;
+		features.inheritedQueries = VK_TRUE;
+		return true;
+	}
+
+	bool GpuProfiler::Collect(uint32_t frameIndex, GpuFrameTiming& timing) {
+		FrameQueries& frame = frames[frameIndex];
+		if (!frame.recorded || !Enabled()) {
+			return false;
+		}
+
+		// No wait flag, so anything that isn't finished yet comes back as not ready rather than blocking.
+		uint32_t queryCount = RegionStart(frame.regionCount);
+		if (timestamps) {
+			vk::Result result = device.getQueryPoolResults(frame.timestamps, 0, queryCount, vk::ArrayProxy<uint64_t>(queryCount, results.data()), sizeof(uint64_t), vk::QueryResultFlagBits::e64);
+			if (result != vk::Result::eSuccess) {
+				return false;
+			}
+		}
+
+		timing.statistics[0] = timing.statistics[1] = timing.statistics[2] = timing.statistics[3] = 0ull;
+		if (statistics) {
+			vk::Result result = device.getQueryPoolResults(frame.statistics, 0, 1, vk::ArrayProxy<uint64_t>(StatisticCount, timing.statistics), sizeof(uint64_t) * StatisticCount, vk::QueryResultFlagBits::e64);
+			if (result != vk::Result::eSuccess) {
+				return false;
+			}
+		}
+		frame.recorded = false;
+
+		timing.frame = frame.frameNumber;
+		timing.total = timestamps ? ((results[FrameEnd] - results[FrameStart]) & timestampMask) * timestampPeriod : 0.0;
+		timing.regions.clear();
+		for (uint32_t i = 0; i < frame.regionCount && timestamps; ++i) {
+			GpuRegionTiming region;
+			region.name = frame.regionNames[i];
+			region.time = ((results[RegionStart(i) + 1] - results[RegionStart(i)]) & timestampMask) * timestampPeriod;
+			timing.regions.push_back(region);
+
+			// Regions are matched up by name, since the same region won't always get the same index.
+			std::vector<RegionTotal>::iterator total = std::find_if(totals.begin(), totals.end(), [&region](const RegionTotal& total) { return std::string(total.name) == region.name; });
+			if (total == totals.end()) {
+				totals.push_back({ region.name, 0.0, 0ull });
+				total = totals.end() - 1;
+			}
+			total->time += region.time;
+			++total->count;
+		}
+		++collectedFrames;
+		return true;
+	}
+
+	void GpuProfiler::BeginFrame(vk::CommandBuffer commandBuffer, uint32_t frameIndex, uint64_t frameNumber) {
+		current = frameIndex;
+		FrameQueries& frame = frames[current];
+		frame.regionCount = 0;
+		frame.frameNumber = frameNumber;
+		frame.recorded = Enabled();
+
+		// Queries have to be reset before they're written again, and that can't happen inside a render pass.
+		if (timestamps) {
+			commandBuffer.resetQueryPool(frame.timestamps, 0, RegionStart(MaxRegions));
+			commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, frame.timestamps, FrameStart);
+		}
+		if (statistics) {
+			commandBuffer.resetQueryPool(frame.statistics, 0, 1);
+			commandBuffer.beginQuery(frame.statistics, 0, vk::QueryControlFlags());
+		}
+	}
+
+	void GpuProfiler::EndFrame(vk::CommandBuffer commandBuffer) {
+		FrameQueries& frame = frames[current];
+		if (statistics) {
+			commandBuffer.endQuery(frame.statistics, 0);
+		}
+		if (timestamps) {
+			commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, frame.timestamps, FrameEnd);
+		}
+	}
+
+	uint32_t GpuProfiler::BeginRegion(vk::CommandBuffer commandBuffer, const char* name) {
+		FrameQueries& frame = frames[current];
+		if (!timestamps || frame.regionCount == MaxRegions) {
+			return MaxRegions;
+		}
+
+		uint32_t region = frame.regionCount++;
+		frame.regionNames[region] = name;
+		commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, frame.timestamps, RegionStart(region));
+		return region;
+	}
+
+	void GpuProfiler::EndRegion(vk::CommandBuffer commandBuffer, uint32_t region) {
+		if (region < MaxRegions) {
+			commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, frames[current].timestamps, RegionStart(region) + 1);
+		}
+	}
+
+	vk::QueryPipelineStatisticFlags GpuProfiler::StatisticFlags() {
+		return statistics ? StatisticsQueried : vk::QueryPipelineStatisticFlags();
+	}
+
+	bool GpuProfiler::Enabled() {
+		return timestamps || statistics;
+	}
+
+	bool GpuProfiler::StatisticsEnabled() {
+		return statistics;
+	}
+
+	std::vector<GpuRegionTiming> GpuProfiler::RegionAverages() {
+		std::vector<GpuRegionTiming> averages;
+		for (RegionTotal& total : totals) {
+			averages.push_back({ total.name, total.time / total.count });
+		}
+		return averages;
+	}
+
+	uint64_t GpuProfiler::CollectedFrames() {
+		return collectedFrames;
+	}
+
+	const char* GpuProfiler::StatisticName(uint32_t statistic) {
+		switch (statistic) {
+			case 0: return "vertex shader invocations";
+			case 1: return "clipping primitives";
+			case 2: return "fragment shader invocations";
+			case 3: return "compute shader invocations";
+			default: return "unknown";
+		}
+	}
+
+	GpuScope::GpuScope(GpuProfiler* profiler, vk::CommandBuffer commandBuffer, const char* name) {
+		this->profiler = profiler;
+		this->commandBuffer = commandBuffer;
+		this->region = profiler->BeginRegion(commandBuffer, name);
+	}
+
+	GpuScope::~GpuScope() {
+		profiler->EndRegion(commandBuffer, region);
+	}
+}
\ No newline at end of file
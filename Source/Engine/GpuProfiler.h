@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <vulkan/vulkan.hpp>
+
+namespace Biendeo::VulkanGame {
+	// How long one named region of a frame took on the GPU, in seconds.
+	struct GpuRegionTiming {
+		const char* name;
+		double time;
+	};
+
+	// Everything the GPU measured for one frame, read back a lap of the frame ring after it was recorded.
+	struct GpuFrameTiming {
+		uint64_t frame;
+		double total;
+		std::vector<GpuRegionTiming> regions;
+
+		// Vertex shader invocations, clipping primitives, fragment shader invocations and compute shader
+		// invocations, in the order Vulkan writes them. All zero if the device can't count them.
+		uint64_t statistics[4];
+	};
+
+	// Timestamps and pipeline statistics for the frame's primary command buffer. There's a set of query
+	// pools per frame in flight, and each set is only read once the frame ring has waited on that frame's
+	// fence, so reading back never stalls on the GPU.
+	class GpuProfiler {
+		public:
+		static const uint32_t MaxRegions = 32;
+		static const uint32_t StatisticCount = 4;
+
+		GpuProfiler(vk::PhysicalDevice physicalDevice, vk::Device device, uint32_t queueFamily, uint32_t framesInFlight, bool pipelineStatistics);
+		~GpuProfiler();
+
+		// Whether the device can do pipeline statistics with secondary command buffers, which is what the
+		// frame is recorded in. The features it needs are set in features if so.
+		static bool SupportsStatistics(vk::PhysicalDevice physicalDevice, vk::PhysicalDeviceFeatures& features);
+
+		// Reads back what the given frame slot measured last time it was used. Returns false if it measured
+		// nothing, or the results aren't there yet. Call it after the slot's fence is waited on.
+		bool Collect(uint32_t frameIndex, GpuFrameTiming& timing);
+
+		// Starts measuring a frame. This has to go outside of any render pass, before anything else is
+		// recorded into the command buffer.
+		void BeginFrame(vk::CommandBuffer commandBuffer, uint32_t frameIndex, uint64_t frameNumber);
+		void EndFrame(vk::CommandBuffer commandBuffer);
+
+		// Regions can nest, but they're dropped once a frame has MaxRegions of them. The name has to outlive
+		// the profiler.
+		uint32_t BeginRegion(vk::CommandBuffer commandBuffer, const char* name);
+		void EndRegion(vk::CommandBuffer commandBuffer, uint32_t region);
+
+		// What secondary command buffers have to inherit while the frame is being measured.
+		vk::QueryPipelineStatisticFlags StatisticFlags();
+
+		bool Enabled();
+		bool StatisticsEnabled();
+
+		// The average time of each region over every frame collected so far.
+		std::vector<GpuRegionTiming> RegionAverages();
+		uint64_t CollectedFrames();
+
+		static const char* StatisticName(uint32_t statistic);
+
+		private:
+		struct FrameQueries {
+			vk::QueryPool timestamps;
+			vk::QueryPool statistics;
+			std::vector<const char*> regionNames;
+			uint32_t regionCount;
+			uint64_t frameNumber;
+			bool recorded;
+		};
+
+		vk::Device device;
+		std::vector<FrameQueries> frames;
+		uint32_t current;
+
+		bool timestamps;
+		bool statistics;
+		double timestampPeriod;
+		uint64_t timestampMask;
+
+		std::vector<uint64_t> results;
+
+		struct RegionTotal {
+			const char* name;
+			double time;
+			uint64_t count;
+		};
+		std::vector<RegionTotal> totals;
+		uint64_t collectedFrames;
+	};
+
+	// Measures a region of a command buffer for as long as it's in scope.
+	class GpuScope {
+		public:
+		GpuScope(GpuProfiler* profiler, vk::CommandBuffer commandBuffer, const char* name);
+		~GpuScope();
+
+		private:
+		GpuProfiler* profiler;
+		vk::CommandBuffer commandBuffer;
+		uint32_t region;
+	};
+}
\ No newline at end of file
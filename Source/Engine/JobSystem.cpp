@@ -0,0 +1,251 @@
+#include "JobSystem.h"
+
+#include <chrono>
+
+namespace Biendeo::VulkanGame {
+	namespace {
+		thread_local unsigned threadIndex = 0;
+
+		// How many times an idle worker looks for work before it goes to sleep.
+		const int idleSpins = 64;
+		const std::chrono::milliseconds idleSleep(1);
+
+		// How many not-yet-ready jobs a thread will set aside while looking for one it can run.
+		const size_t maxDeferredJobs = 16;
+	}
+
+	JobCounter::JobCounter() : value(0) {
+
+	}
+
+	bool JobCounter::Done() {
+		return value.load(std::memory_order_acquire) == 0;
+	}
+
+	JobDeque::JobDeque() : top(0), bottom(0) {
+		for (int64_t i = 0; i < Capacity; ++i) {
+			buffer[i].store(nullptr, std::memory_order_relaxed);
+		}
+	}
+
+	bool JobDeque::Push(Job* job) {
+		int64_t b = bottom.load(std::memory_order_relaxed);
+		int64_t t = top.load(std::memory_order_acquire);
+		if (b - t >= Capacity) {
+			return false;
+		}
+
+		buffer[b & (Capacity - 1)].store(job, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	Job* JobDeque::Pop() {
+		int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t t = top.load(std::memory_order_relaxed);
+
+		if (t > b) {
+			// It was already empty.
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		Job* job = buffer[b & (Capacity - 1)].load(std::memory_order_relaxed);
+		if (t == b) {
+			// This was the last job, so we race any thieves for it.
+			if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+				job = nullptr;
+			}
+			bottom.store(b + 1, std::memory_order_relaxed);
+		}
+		return job;
+	}
+
+	Job* JobDeque::Steal() {
+		int64_t t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t b = bottom.load(std::memory_order_acquire);
+
+		if (t >= b) {
+			return nullptr;
+		}
+
+		Job* job = buffer[t & (Capacity - 1)].load(std::memory_order_relaxed);
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			return nullptr;
+		}
+		return job;
+	}
+
+	JobSystem::JobSystem(unsigned threadCount) : running(true), sleepers(0) {
+		if (threadCount == 0) {
+			threadCount = std::thread::hardware_concurrency();
+		}
+		if (threadCount == 0) {
+			threadCount = 1;
+		}
+
+		for (unsigned i = 0; i < threadCount; ++i) {
+			ThreadState* state = new ThreadState();
+			state->nextJob = 0;
+			threads.push_back(state);
+		}
+
+		// The thread that made us is thread zero and helps out whenever it waits.
+		threadIndex = 0;
+		for (unsigned i = 1; i < threadCount; ++i) {
+			workers.push_back(std::thread(&JobSystem::WorkerLoop, this, i));
+		}
+	}
+
+	JobSystem::~JobSystem() {
+		running.store(false, std::memory_order_release);
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			wake.notify_all();
+		}
+
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+
+		for (ThreadState* state : threads) {
+			delete state;
+		}
+	}
+
+	void JobSystem::Run(JobFunction function, void* data, JobCounter* counter, JobCounter* dependency) {
+		Job* job = AllocateJob();
+		job->function = function;
+		job->data = data;
+		job->counter = counter;
+		job->dependency = dependency;
+
+		if (counter != nullptr) {
+			counter->value.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		// If our deque's full there's already plenty to go around, so just do it now. It still can't start
+		// before its dependency is done, so this thread helps with other work until then, the same as
+		// TryRunJob does for deferred jobs it can't put back.
+		if (!threads[threadIndex]->deque.Push(job)) {
+			if (dependency != nullptr) {
+				Wait(*dependency);
+			}
+			Execute(job);
+			return;
+		}
+
+		if (sleepers.load(std::memory_order_relaxed) > 0) {
+			wake.notify_one();
+		}
+	}
+
+	void JobSystem::Wait(JobCounter& counter) {
+		while (!counter.Done()) {
+			if (!TryRunJob()) {
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	unsigned JobSystem::ThreadCount() {
+		return static_cast<unsigned>(threads.size());
+	}
+
+	unsigned JobSystem::ThreadIndex() {
+		return threadIndex;
+	}
+
+	Job* JobSystem::AllocateJob() {
+		// Each thread hands out jobs from its own ring, which assumes no more than JobPoolSize of a
+		// thread's jobs are ever in flight at once.
+		ThreadState* state = threads[threadIndex];
+		Job* job = &state->jobs[state->nextJob % JobPoolSize];
+		++state->nextJob;
+		return job;
+	}
+
+	Job* JobSystem::FindJob() {
+		Job* job = threads[threadIndex]->deque.Pop();
+		if (job != nullptr) {
+			return job;
+		}
+
+		// Steal from everyone else, starting after ourselves so threads don't all hit the same victim.
+		size_t count = threads.size();
+		for (size_t i = 1; i < count; ++i) {
+			job = threads[(threadIndex + i) % count]->deque.Steal();
+			if (job != nullptr) {
+				return job;
+			}
+		}
+		return nullptr;
+	}
+
+	bool JobSystem::TryRunJob() {
+		// Jobs still waiting on a dependency are set aside while we look for one that can run, then go
+		// back in the order they came out. Otherwise a waiting job on top of our deque would hide the
+		// very job it's waiting for.
+		Job* deferred[maxDeferredJobs];
+		size_t deferredCount = 0;
+
+		Job* job = FindJob();
+		while (job != nullptr && job->dependency != nullptr && !job->dependency->Done()) {
+			deferred[deferredCount++] = job;
+			job = deferredCount < maxDeferredJobs ? FindJob() : nullptr;
+		}
+
+		while (deferredCount > 0) {
+			Job* waiting = deferred[--deferredCount];
+			if (!threads[threadIndex]->deque.Push(waiting)) {
+				Wait(*waiting->dependency);
+				Execute(waiting);
+			}
+		}
+
+		if (job == nullptr) {
+			return false;
+		}
+
+		Execute(job);
+		return true;
+	}
+
+	void JobSystem::Execute(Job* job) {
+		job->function(job->data);
+		if (job->counter != nullptr) {
+			job->counter->value.fetch_sub(1, std::memory_order_release);
+		}
+	}
+
+	void JobSystem::WorkerLoop(unsigned index) {
+		threadIndex = index;
+
+		int idle = 0;
+		while (running.load(std::memory_order_acquire)) {
+			if (TryRunJob()) {
+				idle = 0;
+				continue;
+			}
+
+			if (++idle < idleSpins) {
+				std::this_thread::yield();
+				continue;
+			}
+
+			// Nothing's turned up for a while, so sleep until someone queues work (or briefly, in case
+			// the wake-up raced with us going to sleep).
+			sleepers.fetch_add(1, std::memory_order_relaxed);
+			{
+				std::unique_lock<std::mutex> lock(sleepMutex);
+				wake.wait_for(lock, idleSleep);
+			}
+			sleepers.fetch_sub(1, std::memory_order_relaxed);
+			idle = 0;
+		}
+	}
+}
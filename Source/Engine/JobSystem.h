@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Biendeo::VulkanGame {
+	typedef void (*JobFunction)(void* data);
+
+	// Counts outstanding jobs. It goes up when a job is queued against it, and down when the job finishes.
+	class JobCounter {
+		public:
+		JobCounter();
+
+		bool Done();
+
+		private:
+		friend class JobSystem;
+		std::atomic<int32_t> value;
+	};
+
+	struct Job {
+		JobFunction function;
+		void* data;
+		JobCounter* counter;
+		JobCounter* dependency;
+	};
+
+	// A fixed-size Chase-Lev deque. The owning thread pushes and pops at the bottom, other threads steal
+	// from the top, and none of it takes a lock.
+	class JobDeque {
+		public:
+		static const int64_t Capacity = 4096;
+
+		JobDeque();
+
+		bool Push(Job* job);
+		Job* Pop();
+		Job* Steal();
+
+		private:
+		std::atomic<int64_t> top;
+		std::atomic<int64_t> bottom;
+		std::atomic<Job*> buffer[Capacity];
+	};
+
+	class JobSystem {
+		public:
+		// Zero threads means one for every hardware thread, counting the one that made the system.
+		JobSystem(unsigned threadCount = 0);
+		~JobSystem();
+
+		// Queues a job. If it has a dependency, it won't start until that counter has reached zero.
+		void Run(JobFunction function, void* data, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+
+		// Runs other jobs while waiting, so a waiting thread is never just idle.
+		void Wait(JobCounter& counter);
+
+		unsigned ThreadCount();
+
+		// Which of the system's threads this is; the thread that made the system is always zero.
+		static unsigned ThreadIndex();
+
+		private:
+		static const size_t JobPoolSize = 4096;
+
+		struct ThreadState {
+			JobDeque deque;
+			Job jobs[JobPoolSize];
+			size_t nextJob;
+		};
+
+		std::vector<ThreadState*> threads;
+		std::vector<std::thread> workers;
+		std::atomic<bool> running;
+
+		std::mutex sleepMutex;
+		std::condition_variable wake;
+		std::atomic<int> sleepers;
+
+		Job* AllocateJob();
+		Job* FindJob();
+		bool TryRunJob();
+		void Execute(Job* job);
+		void WorkerLoop(unsigned index);
+	};
+}
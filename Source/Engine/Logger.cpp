@@ -0,0 +1,185 @@
+#include "Logger.h"
+
+#include <chrono>
+#include <cstdio>
+
+namespace Biendeo::VulkanGame {
+	namespace {
+		// How long the writer sleeps when it finds nothing in the queue.
+		const std::chrono::milliseconds idleInterval(2);
+
+		const char* LevelPrefix(LogLevel level) {
+			switch (level) {
+				case LogLevel::Warning:
+					return "Warning: ";
+				case LogLevel::Error:
+					return "Error: ";
+				default:
+					return "";
+			}
+		}
+	}
+
+	Logger::Logger(LogLevel level, uint32_t maxMessagesPerSecond) : enqueuePosition(0), dequeuePosition(0), level(level), rateWindow(0), rateCount(0), dropped(0ull), running(true) {
+		for (size_t i = 0; i < QueueSize; ++i) {
+			slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+		this->maxMessagesPerSecond = maxMessagesPerSecond;
+		this->reportedDropped = 0ull;
+		this->writer = std::thread(&Logger::WriterLoop, this);
+	}
+
+	Logger::~Logger() {
+		running.store(false, std::memory_order_release);
+		writer.join();
+	}
+
+	void Logger::Log(LogLevel level, const char* format, ...) {
+		va_list arguments;
+		va_start(arguments, format);
+		Enqueue(level, format, arguments);
+		va_end(arguments);
+	}
+
+	void Logger::Debug(const char* format, ...) {
+		va_list arguments;
+		va_start(arguments, format);
+		Enqueue(LogLevel::Debug, format, arguments);
+		va_end(arguments);
+	}
+
+	void Logger::Info(const char* format, ...) {
+		va_list arguments;
+		va_start(arguments, format);
+		Enqueue(LogLevel::Info, format, arguments);
+		va_end(arguments);
+	}
+
+	void Logger::Warning(const char* format, ...) {
+		va_list arguments;
+		va_start(arguments, format);
+		Enqueue(LogLevel::Warning, format, arguments);
+		va_end(arguments);
+	}
+
+	void Logger::Error(const char* format, ...) {
+		va_list arguments;
+		va_start(arguments, format);
+		Enqueue(LogLevel::Error, format, arguments);
+		va_end(arguments);
+	}
+
+	LogLevel Logger::Level() {
+		return level.load(std::memory_order_relaxed);
+	}
+
+	LogLevel Logger::Level(LogLevel level) {
+		this->level.store(level, std::memory_order_relaxed);
+		return level;
+	}
+
+	uint64_t Logger::DroppedMessages() {
+		return dropped.load(std::memory_order_relaxed);
+	}
+
+	void Logger::Flush() {
+		size_t target = enqueuePosition.load(std::memory_order_acquire);
+		while (dequeuePosition.load(std::memory_order_acquire) < target) {
+			std::this_thread::sleep_for(idleInterval);
+		}
+	}
+
+	void Logger::Enqueue(LogLevel level, const char* format, va_list arguments) {
+		if (level < this->level.load(std::memory_order_relaxed)) {
+			return;
+		}
+
+		// Errors are never rate limited, they're the ones we'd want to see.
+		if (level != LogLevel::Error && !AllowedByRate()) {
+			dropped.fetch_add(1ull, std::memory_order_relaxed);
+			return;
+		}
+
+		// This is a bounded multi-producer queue; each slot's sequence says whose turn it is to use it.
+		size_t position = enqueuePosition.load(std::memory_order_relaxed);
+		Slot* slot;
+		while (true) {
+			slot = &slots[position % QueueSize];
+			size_t sequence = slot->sequence.load(std::memory_order_acquire);
+			intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+			if (difference == 0) {
+				if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			} else if (difference < 0) {
+				// The writer hasn't caught up, so the queue's full.
+				dropped.fetch_add(1ull, std::memory_order_relaxed);
+				return;
+			} else {
+				position = enqueuePosition.load(std::memory_order_relaxed);
+			}
+		}
+
+		slot->level = level;
+		vsnprintf(slot->message, MessageSize, format, arguments);
+		slot->sequence.store(position + 1, std::memory_order_release);
+	}
+
+	bool Logger::AllowedByRate() {
+		if (maxMessagesPerSecond == 0) {
+			return true;
+		}
+
+		int64_t window = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		int64_t currentWindow = rateWindow.load(std::memory_order_relaxed);
+		if (window != currentWindow && rateWindow.compare_exchange_strong(currentWindow, window, std::memory_order_relaxed)) {
+			rateCount.store(0, std::memory_order_relaxed);
+		}
+		return rateCount.fetch_add(1, std::memory_order_relaxed) < maxMessagesPerSecond;
+	}
+
+	bool Logger::Drain() {
+		bool wroteAnything = false;
+		size_t position = dequeuePosition.load(std::memory_order_relaxed);
+		while (true) {
+			Slot& slot = slots[position % QueueSize];
+			if (slot.sequence.load(std::memory_order_acquire) != position + 1) {
+				break;
+			}
+
+			FILE* stream = slot.level >= LogLevel::Warning ? stderr : stdout;
+			fputs(LevelPrefix(slot.level), stream);
+			fputs(slot.message, stream);
+
+			// Hand the slot back to producers for the next lap around the queue.
+			slot.sequence.store(position + QueueSize, std::memory_order_release);
+			++position;
+			wroteAnything = true;
+		}
+
+		uint64_t droppedNow = dropped.load(std::memory_order_relaxed);
+		if (droppedNow != reportedDropped) {
+			fprintf(stderr, "(%llu log messages dropped)\n", static_cast<unsigned long long>(droppedNow - reportedDropped));
+			reportedDropped = droppedNow;
+			wroteAnything = true;
+		}
+
+		if (wroteAnything) {
+			fflush(stdout);
+			fflush(stderr);
+		}
+		dequeuePosition.store(position, std::memory_order_release);
+		return wroteAnything;
+	}
+
+	void Logger::WriterLoop() {
+		while (running.load(std::memory_order_acquire)) {
+			if (!Drain()) {
+				std::this_thread::sleep_for(idleInterval);
+			}
+		}
+
+		// Anything logged before shutdown still gets written.
+		Drain();
+	}
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <cstdarg>
+#include <cstdint>
+#include <thread>
+
+namespace Biendeo::VulkanGame {
+	enum class LogLevel {
+		Debug,
+		Info,
+		Warning,
+		Error
+	};
+
+	// Formats messages on the calling thread into a fixed queue slot, and leaves all the actual writing to
+	// a background thread. Logging never blocks or allocates; if the queue is full or a thread is logging
+	// faster than the rate limit, the message is dropped and counted instead.
+	class Logger {
+		public:
+		static const size_t QueueSize = 1024;
+		static const size_t MessageSize = 256;
+
+		Logger(LogLevel level, uint32_t maxMessagesPerSecond = 1000);
+		~Logger();
+
+		void Log(LogLevel level, const char* format, ...);
+		void Debug(const char* format, ...);
+		void Info(const char* format, ...);
+		void Warning(const char* format, ...);
+		void Error(const char* format, ...);
+
+		LogLevel Level();
+		LogLevel Level(LogLevel level);
+
+		uint64_t DroppedMessages();
+
+		// Blocks until everything logged so far has been written.
+		void Flush();
+
+		private:
+		struct Slot {
+			std::atomic<size_t> sequence;
+			LogLevel level;
+			char message[MessageSize];
+		};
+
+		Slot slots[QueueSize];
+		std::atomic<size_t> enqueuePosition;
+		std::atomic<size_t> dequeuePosition;
+
+		std::atomic<LogLevel> level;
+		uint32_t maxMessagesPerSecond;
+		std::atomic<int64_t> rateWindow;
+		std::atomic<uint32_t> rateCount;
+		std::atomic<uint64_t> dropped;
+		uint64_t reportedDropped;
+
+		std::atomic<bool> running;
+		std::thread writer;
+
+		void Enqueue(LogLevel level, const char* format, va_list arguments);
+		bool AllowedByRate();
+		bool Drain();
+		void WriterLoop();
+	};
+}
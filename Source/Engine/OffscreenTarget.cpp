@@ -0,0 +1,56 @@
+#include "OffscreenTarget.h"
+
+namespace Biendeo::VulkanGame {
+	OffscreenTarget::OffscreenTarget(GpuAllocator* allocator, uint32_t width, uint32_t height, vk::Format format) {
+		this->allocator = allocator;
+		this->device = allocator->Device();
+		this->format = format;
+		this->extent = vk::Extent2D(width, height);
+
+		// Transfer source is there so frames can be read back and checked.
+		vk::ImageCreateInfo imageInfo = vk::ImageCreateInfo();
+		imageInfo.setImageType(vk::ImageType::e2D);
+		imageInfo.setFormat(format);
+		imageInfo.setExtent(vk::Extent3D(width, height, 1));
+		imageInfo.setMipLevels(1);
+		imageInfo.setArrayLayers(1);
+		imageInfo.setSamples(vk::SampleCountFlagBits::e1);
+		imageInfo.setTiling(vk::ImageTiling::eOptimal);
+		imageInfo.setUsage(vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eTransferSrc);
+		imageInfo.setSharingMode(vk::SharingMode::eExclusive);
+		imageInfo.setInitialLayout(vk::ImageLayout::eUndefined);
+		image = device.createImage(imageInfo);
+
+		memory = allocator->AllocateImage(image, vk::MemoryPropertyFlagBits::eDeviceLocal);
+
+		vk::ImageViewCreateInfo viewInfo = vk::ImageViewCreateInfo();
+		viewInfo.setImage(image);
+		viewInfo.setViewType(vk::ImageViewType::e2D);
+		viewInfo.setFormat(format);
+		viewInfo.setSubresourceRange(vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1));
+		view = device.createImageView(viewInfo);
+	}
+
+	OffscreenTarget::~OffscreenTarget() {
+		device.destroyImageView(view);
+		device.destroyImage(image);
+		allocator->Free(memory);
+	}
+
+	vk::Image OffscreenTarget::Image() {
+		return image;
+	}
+
+	vk::ImageView OffscreenTarget::View() {
+		return view;
+	}
+
+	vk::Format OffscreenTarget::Format() {
+		return format;
+	}
+
+	vk::Extent2D OffscreenTarget::Extent() {
+		return extent;
+	}
+
+}
\ No newline at end of file
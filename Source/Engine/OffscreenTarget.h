@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include "GpuAllocator.h"
+
+namespace Biendeo::VulkanGame {
+	// A colour image that we render into when there's no window to present to.
+	class OffscreenTarget {
+		public:
+		OffscreenTarget(GpuAllocator* allocator, uint32_t width, uint32_t height, vk::Format format = vk::Format::eR8G8B8A8Unorm);
+		~OffscreenTarget();
+
+		vk::Image Image();
+		vk::ImageView View();
+		vk::Format Format();
+		vk::Extent2D Extent();
+
+		private:
+		GpuAllocator* allocator;
+		vk::Device device;
+		vk::Image image;
+		GpuAllocation memory;
+		vk::ImageView view;
+		vk::Format format;
+		vk::Extent2D extent;
+	};
+}
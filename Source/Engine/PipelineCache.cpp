@@ -0,0 +1,195 @@
+#include "PipelineCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#endif
+
+namespace Biendeo::VulkanGame {
+	namespace {
+		// Our own header goes in front of the driver's data, so truncated or damaged files are caught
+		// before the driver ever sees them.
+		const uint32_t FileMagic = 0x43505642; // "BVPC"
+		const uint32_t FileVersion = 1;
+
+		struct FileHeader {
+			uint32_t magic;
+			uint32_t version;
+			uint64_t dataSize;
+			uint64_t checksum;
+		};
+
+		// The header every driver puts at the start of its cache data.
+		struct DriverHeader {
+			uint32_t headerSize;
+			uint32_t headerVersion;
+			uint32_t vendorID;
+			uint32_t deviceID;
+			uint8_t uuid[VK_UUID_SIZE];
+		};
+
+		uint64_t Checksum(const uint8_t* data, size_t size) {
+			// 64-bit FNV-1a, which is plenty for spotting a bad write.
+			uint64_t hash = 14695981039346656037ull;
+			for (size_t i = 0; i < size; ++i) {
+				hash ^= data[i];
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		bool ReplaceFile(const std::string& from, const std::string& to) {
+			#ifdef _WIN32
+			return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+			#else
+			return std::rename(from.c_str(), to.c_str()) == 0;
+			#endif
+		}
+	}
+
+	PipelineCache::PipelineCache(vk::PhysicalDevice physicalDevice, vk::Device device, const std::string& path, const PipelineCacheFile& file) {
+		this->physicalDevice = physicalDevice;
+		this->device = device;
+		this->path = path;
+		this->state = PipelineCacheState::Cold;
+
+		// Anything that goes wrong once a file was found means it was there but couldn't be used.
+		bool usable = false;
+		if (file.found) {
+			state = PipelineCacheState::Rejected;
+			rejectReason = file.rejectReason;
+			if (rejectReason.empty() && Validate(file.data)) {
+				state = PipelineCacheState::Warm;
+				usable = true;
+			}
+		}
+
+		vk::PipelineCacheCreateInfo cacheInfo = vk::PipelineCacheCreateInfo();
+		cacheInfo.setInitialDataSize(usable ? file.data.size() : 0);
+		cacheInfo.setPInitialData(usable ? file.data.data() : nullptr);
+		cache = device.createPipelineCache(cacheInfo);
+	}
+
+	PipelineCache::~PipelineCache() {
+		device.destroyPipelineCache(cache);
+	}
+
+	bool PipelineCache::Save() {
+		std::vector<uint8_t> data = device.getPipelineCacheData(cache);
+
+		FileHeader header;
+		header.magic = FileMagic;
+		header.version = FileVersion;
+		header.dataSize = data.size();
+		header.checksum = Checksum(data.data(), data.size());
+
+		std::string temporaryPath = path + ".tmp";
+		{
+			std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+			if (!file) {
+				return false;
+			}
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			file.write(reinterpret_cast<const char*>(data.data()), data.size());
+			file.flush();
+			if (!file.good()) {
+				file.close();
+				std::remove(temporaryPath.c_str());
+				return false;
+			}
+		}
+
+		if (!ReplaceFile(temporaryPath, path)) {
+			std::remove(temporaryPath.c_str());
+			return false;
+		}
+		return true;
+	}
+
+	vk::PipelineCache PipelineCache::Handle() {
+		return cache;
+	}
+
+	PipelineCacheState PipelineCache::State() {
+		return state;
+	}
+
+	const std::string& PipelineCache::RejectReason() {
+		return rejectReason;
+	}
+
+	const char* PipelineCache::StateName(PipelineCacheState state) {
+		switch (state) {
+			case PipelineCacheState::Warm: return "warm";
+			case PipelineCacheState::Rejected: return "rejected";
+			default: return "cold";
+		}
+	}
+
+	PipelineCacheFile PipelineCache::Read(const std::string& path) {
+		PipelineCacheFile result;
+		result.found = false;
+
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		if (!file) {
+			return result;
+		}
+		result.found = true;
+
+		std::streamoff fileSize = file.tellg();
+		file.seekg(0);
+		FileHeader header;
+		if (fileSize < static_cast<std::streamoff>(sizeof(header)) || !file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+			result.rejectReason = "file is too short";
+			return result;
+		}
+		if (header.magic != FileMagic || header.version != FileVersion) {
+			result.rejectReason = "not a cache file from this version";
+			return result;
+		}
+		if (header.dataSize != static_cast<uint64_t>(fileSize) - sizeof(header)) {
+			result.rejectReason = "file is truncated";
+			return result;
+		}
+
+		result.data.resize(static_cast<size_t>(header.dataSize));
+		if (!file.read(reinterpret_cast<char*>(result.data.data()), result.data.size())) {
+			result.rejectReason = "file couldn't be read";
+			return result;
+		}
+		if (Checksum(result.data.data(), result.data.size()) != header.checksum) {
+			result.rejectReason = "checksum doesn't match";
+			return result;
+		}
+		return result;
+	}
+
+	bool PipelineCache::Validate(const std::vector<uint8_t>& data) {
+		// Drivers are meant to reject foreign data themselves, but not all of them do it gracefully.
+		DriverHeader header;
+		if (data.size() < sizeof(header)) {
+			rejectReason = "driver header is missing";
+			return false;
+		}
+		std::memcpy(&header, data.data(), sizeof(header));
+
+		vk::PhysicalDeviceProperties properties = physicalDevice.getProperties();
+		if (header.headerSize < sizeof(header) || header.headerSize > data.size() || header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE) {
+			rejectReason = "driver header is malformed";
+			return false;
+		}
+		if (header.vendorID != properties.vendorID || header.deviceID != properties.deviceID) {
+			rejectReason = "made on a different device";
+			return false;
+		}
+		if (std::memcmp(header.uuid, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+			rejectReason = "made by a different driver";
+			return false;
+		}
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <vulkan/vulkan.hpp>
+
+namespace Biendeo::VulkanGame {
+	enum class PipelineCacheState {
+		// There was nothing on disk, or it was ignored on purpose.
+		Cold,
+		// The cache on disk was loaded and handed to the driver.
+		Warm,
+		// There was a cache on disk, but it was for another device or driver, or it was damaged.
+		Rejected
+	};
+
+	// A cache file as it came off the disk. Reading it doesn't need a device, so it can happen while the
+	// device is still being made; whether it suits that device gets checked once there is one.
+	struct PipelineCacheFile {
+		bool found;
+		std::vector<uint8_t> data;
+
+		// Why the file couldn't be used, if it was there but damaged.
+		std::string rejectReason;
+	};
+
+	// A VkPipelineCache that's kept on disk between runs, so pipelines only compile from scratch once.
+	class PipelineCache {
+		public:
+		// An empty file (one that wasn't found) starts the cache cold.
+		PipelineCache(vk::PhysicalDevice physicalDevice, vk::Device device, const std::string& path, const PipelineCacheFile& file);
+		~PipelineCache();
+
+		static PipelineCacheFile Read(const std::string& path);
+
+		// Writes the cache to a temporary file and then moves it into place, so a crash halfway through
+		// never leaves a broken cache behind.
+		bool Save();
+
+		vk::PipelineCache Handle();
+		PipelineCacheState State();
+
+		// Why the cache on disk was rejected, if it was.
+		const std::string& RejectReason();
+
+		static const char* StateName(PipelineCacheState state);
+
+		private:
+		vk::PhysicalDevice physicalDevice;
+		vk::Device device;
+		vk::PipelineCache cache;
+		std::string path;
+		PipelineCacheState state;
+		std::string rejectReason;
+
+		bool Validate(const std::vector<uint8_t>& data);
+	};
+}
\ No newline at end of file
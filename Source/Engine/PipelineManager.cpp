@@ -0,0 +1,161 @@
+#include "PipelineManager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#endif
+
+namespace Biendeo::VulkanGame {
+	PipelineManager::PipelineManager(vk::Device device, vk::PipelineCache cache, unsigned threadCount) {
+		this->device = device;
+		this->cache = cache;
+		this->entries = new Entry[MaxPipelines];
+		this->count = 0;
+		this->pending = 0;
+		this->running = true;
+
+		if (threadCount == 0) {
+			threadCount = std::max(1u, std::thread::hardware_concurrency() / 4);
+		}
+		for (unsigned i = 0; i < threadCount; ++i) {
+			workers.emplace_back(&PipelineManager::WorkerLoop, this);
+		}
+	}
+
+	PipelineManager::~PipelineManager() {
+		// Anything still queued is dropped, but whatever's mid-compile has to finish first.
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			running = false;
+			pending -= static_cast<uint32_t>(queue.size());
+			queue.clear();
+		}
+		wake.notify_all();
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+
+		for (uint32_t i = 0; i < count; ++i) {
+			if (entries[i].pipeline) {
+				device.destroyPipeline(entries[i].pipeline);
+			}
+		}
+		delete[] entries;
+	}
+
+	PipelineHandle PipelineManager::Request(const std::string& name, PipelineBuilder builder, void* data) {
+		PipelineHandle handle;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			std::unordered_map<std::string, PipelineHandle>::iterator found = names.find(name);
+			if (found != names.end()) {
+				return found->second;
+			}
+			if (count == MaxPipelines) {
+				throw std::runtime_error("Too many pipelines have been requested.");
+			}
+
+			handle = count;
+			Entry& entry = entries[handle];
+			entry.name = name;
+			entry.builder = builder;
+			entry.data = data;
+			entry.pipeline = vk::Pipeline();
+			entry.compileTime = 0.0;
+			entry.state.store(static_cast<int>(PipelineState::Pending), std::memory_order_relaxed);
+			names[name] = handle;
+			count.store(handle + 1, std::memory_order_release);
+
+			queue.push_back(handle);
+			++pending;
+		}
+		wake.notify_one();
+		return handle;
+	}
+
+	void PipelineManager::Prewarm(const std::vector<PipelineRequest>& requests) {
+		for (const PipelineRequest& request : requests) {
+			Request(request.name, request.builder, request.data);
+		}
+	}
+
+	PipelineState PipelineManager::State(PipelineHandle handle) {
+		if (handle >= count.load(std::memory_order_acquire)) {
+			return PipelineState::Failed;
+		}
+		return static_cast<PipelineState>(entries[handle].state.load(std::memory_order_acquire));
+	}
+
+	bool PipelineManager::Ready(PipelineHandle handle) {
+		return State(handle) == PipelineState::Ready;
+	}
+
+	vk::Pipeline PipelineManager::Get(PipelineHandle handle, PipelineHandle fallback) {
+		if (Ready(handle)) {
+			return entries[handle].pipeline;
+		}
+		if (fallback != InvalidPipeline && Ready(fallback)) {
+			return entries[fallback].pipeline;
+		}
+		return vk::Pipeline();
+	}
+
+	void PipelineManager::WaitIdle() {
+		std::unique_lock<std::mutex> lock(mutex);
+		idle.wait(lock, [this]() { return pending == 0; });
+	}
+
+	uint32_t PipelineManager::Pending() {
+		std::lock_guard<std::mutex> lock(mutex);
+		return pending;
+	}
+
+	double PipelineManager::CompileTime(PipelineHandle handle) {
+		return State(handle) == PipelineState::Pending ? 0.0 : entries[handle].compileTime;
+	}
+
+	void PipelineManager::WorkerLoop() {
+		// Compiling is never urgent compared to the frame, so let the scheduler favour everything else.
+		#ifdef _WIN32
+		SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+		#endif
+
+		while (true) {
+			PipelineHandle handle;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wake.wait(lock, [this]() { return !running || !queue.empty(); });
+				if (!running) {
+					return;
+				}
+				handle = queue.front();
+				queue.pop_front();
+			}
+
+			Entry& entry = entries[handle];
+			PipelineState result = PipelineState::Ready;
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			try {
+				entry.pipeline = entry.builder(device, cache, entry.data);
+				if (!entry.pipeline) {
+					result = PipelineState::Failed;
+				}
+			} catch (const std::exception&) {
+				result = PipelineState::Failed;
+			}
+			entry.compileTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			entry.state.store(static_cast<int>(result), std::memory_order_release);
+
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				--pending;
+			}
+			idle.notify_all();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <vulkan/vulkan.hpp>
+
+namespace Biendeo::VulkanGame {
+	typedef uint32_t PipelineHandle;
+
+	// Makes one pipeline. These run on the compile threads, so they can't touch anything that isn't
+	// safe to use from another thread. Throwing marks the pipeline as failed.
+	typedef vk::Pipeline (*PipelineBuilder)(vk::Device device, vk::PipelineCache cache, void* data);
+
+	enum class PipelineState {
+		Pending,
+		Ready,
+		Failed
+	};
+
+	struct PipelineRequest {
+		std::string name;
+		PipelineBuilder builder;
+		void* data;
+	};
+
+	// Compiles pipelines in the background and hands back a handle straight away, so asking for one
+	// mid-frame never stalls the frame. Draws check whether it's ready, and skip or use a fallback if
+	// it isn't yet.
+	class PipelineManager {
+		public:
+		static const PipelineHandle InvalidPipeline = UINT32_MAX;
+		static const uint32_t MaxPipelines = 1024;
+
+		// Zero threads means a quarter of the hardware threads, leaving the rest to the frame.
+		PipelineManager(vk::Device device, vk::PipelineCache cache, unsigned threadCount = 0);
+		~PipelineManager();
+
+		// Asking for a name that's already been asked for gives back the same handle.
+		PipelineHandle Request(const std::string& name, PipelineBuilder builder, void* data);
+		void Prewarm(const std::vector<PipelineRequest>& requests);
+
+		PipelineState State(PipelineHandle handle);
+		bool Ready(PipelineHandle handle);
+
+		// Gives the fallback's pipeline if this one isn't ready, and a null pipeline if neither is.
+		vk::Pipeline Get(PipelineHandle handle, PipelineHandle fallback = InvalidPipeline);
+
+		// Blocks until nothing is left to compile, like at the end of a loading screen.
+		void WaitIdle();
+		uint32_t Pending();
+
+		// How long the pipeline took to build, in seconds.
+		double CompileTime(PipelineHandle handle);
+
+		private:
+		struct Entry {
+			std::string name;
+			PipelineBuilder builder;
+			void* data;
+			vk::Pipeline pipeline;
+			double compileTime;
+			std::atomic<int> state;
+		};
+
+		vk::Device device;
+		vk::PipelineCache cache;
+
+		// Entries never move once they're made, so other threads can read them without a lock once
+		// their state says they're done.
+		Entry* entries;
+		std::atomic<uint32_t> count;
+		std::unordered_map<std::string, PipelineHandle> names;
+
+		std::mutex mutex;
+		std::condition_variable wake;
+		std::condition_variable idle;
+		std::deque<PipelineHandle> queue;
+		uint32_t pending;
+		bool running;
+		std::vector<std::thread> workers;
+
+		void WorkerLoop();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "QueueFamilies.h"
+
+#include <vector>
+
+namespace Biendeo::VulkanGame {
+	bool QueueFamilies::HasGraphics() {
+		return graphics != None;
+	}
+
+	bool QueueFamilies::HasDedicatedTransfer() {
+		return transfer != graphics;
+	}
+
+	bool QueueFamilies::HasAsyncCompute() {
+		return compute != graphics;
+	}
+
+	QueueFamilies QueueFamilies::Select(vk::PhysicalDevice physicalDevice, vk::SurfaceKHR surface) {
+		std::vector<vk::QueueFamilyProperties> properties = physicalDevice.getQueueFamilyProperties();
+		QueueFamilies families;
+		families.graphics = None;
+		families.transfer = None;
+		families.compute = None;
+
+		uint32_t transferWithoutGraphics = None;
+		for (uint32_t i = 0; i < properties.size(); ++i) {
+			vk::QueueFlags flags = properties[i].queueFlags;
+			if (properties[i].queueCount == 0) {
+				continue;
+			}
+
+			bool graphics = static_cast<bool>(flags & vk::QueueFlagBits::eGraphics);
+			bool compute = static_cast<bool>(flags & vk::QueueFlagBits::eCompute);
+			bool transfer = static_cast<bool>(flags & vk::QueueFlagBits::eTransfer);
+
+			if (graphics && families.graphics == None && (!surface || physicalDevice.getSurfaceSupportKHR(i, surface))) {
+				families.graphics = i;
+			}
+
+			// A family with compute but no graphics runs alongside the graphics queue rather than
+			// taking turns with it.
+			if (compute && !graphics && families.compute == None) {
+				families.compute = i;
+			}
+
+			// The best transfer family only does transfers, which is usually a separate copy engine.
+			// Failing that, anything without graphics is still better than the graphics queue.
+			if (transfer && !graphics && !compute && families.transfer == None) {
+				families.transfer = i;
+			}
+			if ((transfer || compute) && !graphics && transferWithoutGraphics == None) {
+				transferWithoutGraphics = i;
+			}
+		}
+
+		if (families.transfer == None) {
+			families.transfer = transferWithoutGraphics;
+		}
+
+		// Graphics families can always do both, so they're the fallback.
+		if (families.transfer == None) {
+			families.transfer = families.graphics;
+		}
+		if (families.compute == None) {
+			families.compute = families.graphics;
+		}
+
+		return families;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+#include <vulkan/vulkan.hpp>
+
+namespace Biendeo::VulkanGame {
+	// Which queue family each kind of work goes to. Transfer and compute share the graphics family when
+	// the device has nothing better, so they're always safe to use.
+	struct QueueFamilies {
+		static const uint32_t None = UINT32_MAX;
+
+		uint32_t graphics;
+		uint32_t transfer;
+		uint32_t compute;
+
+		bool HasGraphics();
+		bool HasDedicatedTransfer();
+		bool HasAsyncCompute();
+
+		// Pass a null surface when there's nothing to present to.
+		static QueueFamilies Select(vk::PhysicalDevice physicalDevice, vk::SurfaceKHR surface);
+	};
+}
\ No newline at end of file
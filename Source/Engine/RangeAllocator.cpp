@@ -0,0 +1,142 @@
+#include "RangeAllocator.h"
+
+#include <algorithm>
+
+namespace Biendeo::VulkanGame {
+	BuddyAllocator::BuddyAllocator(uint64_t size, uint64_t minimumNodeSize) {
+		this->size = NextPowerOfTwo(size);
+		this->minimumNodeSize = std::min(this->size, NextPowerOfTwo(minimumNodeSize));
+		this->used = 0;
+		this->allocations = 0;
+
+		this->levels = 1;
+		for (uint64_t node = this->size; node > this->minimumNodeSize; node >>= 1) {
+			++levels;
+		}
+		freeLists.resize(levels);
+		freeLists[0].insert(0);
+	}
+
+	uint32_t BuddyAllocator::Levels() {
+		return levels;
+	}
+
+	uint64_t BuddyAllocator::NodeSize(uint32_t level) {
+		return size >> level;
+	}
+
+	uint32_t BuddyAllocator::LevelFor(uint64_t size, uint64_t alignment) {
+		uint64_t nodeSize = std::max(minimumNodeSize, NextPowerOfTwo(std::max(size, alignment)));
+		uint32_t level = 0;
+		while (level + 1 < levels && NodeSize(level + 1) >= nodeSize) {
+			++level;
+		}
+		return level;
+	}
+
+	bool BuddyAllocator::Allocate(uint32_t level, uint64_t& offset) {
+		// Find the smallest free node that's at least big enough, then split it down to size.
+		uint32_t found = level + 1;
+		for (uint32_t i = level + 1; i-- > 0;) {
+			if (!freeLists[i].empty()) {
+				found = i;
+				break;
+			}
+		}
+		if (found > level) {
+			return false;
+		}
+
+		offset = *freeLists[found].begin();
+		freeLists[found].erase(freeLists[found].begin());
+		for (uint32_t i = found; i < level; ++i) {
+			freeLists[i + 1].insert(offset + NodeSize(i + 1));
+		}
+
+		used += NodeSize(level);
+		++allocations;
+		return true;
+	}
+
+	void BuddyAllocator::Free(uint64_t offset, uint32_t level) {
+		used -= NodeSize(level);
+		--allocations;
+
+		// Merge with the buddy for as long as it's free too.
+		while (level > 0) {
+			uint64_t buddy = offset ^ NodeSize(level);
+			std::set<uint64_t>::iterator found = freeLists[level].find(buddy);
+			if (found == freeLists[level].end()) {
+				break;
+			}
+			freeLists[level].erase(found);
+			offset = std::min(offset, buddy);
+			--level;
+		}
+		freeLists[level].insert(offset);
+	}
+
+	uint64_t BuddyAllocator::Size() {
+		return size;
+	}
+
+	uint64_t BuddyAllocator::Used() {
+		return used;
+	}
+
+	uint32_t BuddyAllocator::Allocations() {
+		return allocations;
+	}
+
+	uint64_t BuddyAllocator::LargestFree() {
+		for (uint32_t level = 0; level < levels; ++level) {
+			if (!freeLists[level].empty()) {
+				return NodeSize(level);
+			}
+		}
+		return 0;
+	}
+
+	size_t BuddyAllocator::FreeNodes(uint32_t level) {
+		return freeLists[level].size();
+	}
+
+	LinearAllocator::LinearAllocator(uint64_t size) {
+		this->size = size;
+		this->head = 0;
+	}
+
+	bool LinearAllocator::Allocate(uint64_t size, uint64_t alignment, uint64_t& offset) {
+		uint64_t start = AlignUp(head, alignment);
+		if (start > this->size || size > this->size - start) {
+			return false;
+		}
+		offset = start;
+		head = start + size;
+		return true;
+	}
+
+	void LinearAllocator::Reset() {
+		head = 0;
+	}
+
+	uint64_t LinearAllocator::Size() {
+		return size;
+	}
+
+	uint64_t LinearAllocator::Used() {
+		return head;
+	}
+
+	uint64_t NextPowerOfTwo(uint64_t value) {
+		uint64_t power = 1;
+		while (power < value) {
+			power <<= 1;
+		}
+		return power;
+	}
+
+	uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+		return alignment > 1 ? (value + alignment - 1) / alignment * alignment : value;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+namespace Biendeo::VulkanGame {
+	// Hands out pieces of a range of offsets by splitting it in halves, and merges freed halves back
+	// together. It only keeps the books; whatever the offsets point into lives somewhere else.
+	class BuddyAllocator {
+		public:
+		// The size is rounded up to a power of two. Nodes never get smaller than the minimum node size.
+		BuddyAllocator(uint64_t size, uint64_t minimumNodeSize);
+
+		// Level zero is the whole range, and each level down is half the size of the one above.
+		uint32_t Levels();
+		uint64_t NodeSize(uint32_t level);
+
+		// The level of the smallest node that fits the size. Nodes are aligned to their own size, so
+		// asking for the alignment as well covers that too. The size has to fit in the whole range.
+		uint32_t LevelFor(uint64_t size, uint64_t alignment);
+
+		// Returns false if there's no free node at the level or above it to split down.
+		bool Allocate(uint32_t level, uint64_t& offset);
+		void Free(uint64_t offset, uint32_t level);
+
+		uint64_t Size();
+		uint64_t Used();
+		uint32_t Allocations();
+		uint64_t LargestFree();
+		size_t FreeNodes(uint32_t level);
+
+		private:
+		uint64_t size;
+		uint64_t minimumNodeSize;
+		uint32_t levels;
+
+		// One set of free offsets for each node size, largest first.
+		std::vector<std::set<uint64_t>> freeLists;
+		uint64_t used;
+		uint32_t allocations;
+	};
+
+	// Hands out pieces of a range by bumping an offset, and takes them all back at once.
+	class LinearAllocator {
+		public:
+		LinearAllocator(uint64_t size);
+
+		// Returns false if the piece doesn't fit in what's left, leaving the head where it was.
+		bool Allocate(uint64_t size, uint64_t alignment, uint64_t& offset);
+		void Reset();
+
+		uint64_t Size();
+		uint64_t Used();
+
+		private:
+		uint64_t size;
+		uint64_t head;
+	};
+
+	uint64_t NextPowerOfTwo(uint64_t value);
+	uint64_t AlignUp(uint64_t value, uint64_t alignment);
+}
\ No newline at end of file
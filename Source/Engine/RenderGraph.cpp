@@ -0,0 +1,696 @@
+#include "RenderGraph.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Biendeo::VulkanGame {
+	namespace {
+		uint32_t Bit(RenderAccess access) {
+			return 1u << static_cast<uint32_t>(access);
+		}
+
+		const uint32_t AccessCount = 7;
+
+		// Attachments count as reads too, since a pass might load what's already there.
+		const uint32_t WriteAccesses = Bit(RenderAccess::ColourAttachment) | Bit(RenderAccess::DepthAttachment) | Bit(RenderAccess::StorageWrite) | Bit(RenderAccess::TransferWrite);
+		const uint32_t ReadAccesses = Bit(RenderAccess::ColourAttachment) | Bit(RenderAccess::DepthAttachment) | Bit(RenderAccess::Sampled) | Bit(RenderAccess::StorageRead) | Bit(RenderAccess::TransferRead);
+
+		const vk::AccessFlags WriteAccessFlags = vk::AccessFlagBits::eShaderWrite | vk::AccessFlagBits::eColorAttachmentWrite | vk::AccessFlagBits::eDepthStencilAttachmentWrite | vk::AccessFlagBits::eTransferWrite;
+
+		vk::ImageLayout Layout(RenderAccess access) {
+			switch (access) {
+				case RenderAccess::ColourAttachment: return vk::ImageLayout::eColorAttachmentOptimal;
+				case RenderAccess::DepthAttachment: return vk::ImageLayout::eDepthStencilAttachmentOptimal;
+				case RenderAccess::Sampled: return vk::ImageLayout::eShaderReadOnlyOptimal;
+				case RenderAccess::StorageRead: return vk::ImageLayout::eGeneral;
+				case RenderAccess::StorageWrite: return vk::ImageLayout::eGeneral;
+				case RenderAccess::TransferRead: return vk::ImageLayout::eTransferSrcOptimal;
+				case RenderAccess::TransferWrite: return vk::ImageLayout::eTransferDstOptimal;
+				default: return vk::ImageLayout::eUndefined;
+			}
+		}
+
+		vk::ImageLayout Layout(uint32_t accesses) {
+			for (uint32_t i = 0; i < AccessCount; ++i) {
+				if (accesses & (1u << i)) {
+					return Layout(static_cast<RenderAccess>(i));
+				}
+			}
+			return vk::ImageLayout::eUndefined;
+		}
+
+		// Everything a pass's use of an image boils down to once we know which queue it's on.
+		struct AccessInfo {
+			vk::PipelineStageFlags stages;
+			vk::AccessFlags access;
+			vk::ImageLayout layout;
+			bool write;
+		};
+
+		AccessInfo Resolve(uint32_t accesses, bool compute) {
+			// Fragment shaders don't exist on a compute queue, so shader accesses only wait on what's there.
+			vk::PipelineStageFlags shaderStages = compute ? vk::PipelineStageFlags(vk::PipelineStageFlagBits::eComputeShader) : vk::PipelineStageFlagBits::eFragmentShader | vk::PipelineStageFlagBits::eComputeShader;
+
+			AccessInfo info;
+			info.layout = Layout(accesses);
+			info.write = (accesses & WriteAccesses) != 0;
+			if (accesses & Bit(RenderAccess::ColourAttachment)) {
+				info.stages |= vk::PipelineStageFlagBits::eColorAttachmentOutput;
+				info.access |= vk::AccessFlagBits::eColorAttachmentRead | vk::AccessFlagBits::eColorAttachmentWrite;
+			}
+			if (accesses & Bit(RenderAccess::DepthAttachment)) {
+				info.stages |= vk::PipelineStageFlagBits::eEarlyFragmentTests | vk::PipelineStageFlagBits::eLateFragmentTests;
+				info.access |= vk::AccessFlagBits::eDepthStencilAttachmentRead | vk::AccessFlagBits::eDepthStencilAttachmentWrite;
+			}
+			if (accesses & (Bit(RenderAccess::Sampled) | Bit(RenderAccess::StorageRead))) {
+				info.stages |= shaderStages;
+				info.access |= vk::AccessFlagBits::eShaderRead;
+			}
+			if (accesses & Bit(RenderAccess::StorageWrite)) {
+				info.stages |= shaderStages;
+				info.access |= vk::AccessFlagBits::eShaderWrite;
+			}
+			if (accesses & Bit(RenderAccess::TransferRead)) {
+				info.stages |= vk::PipelineStageFlagBits::eTransfer;
+				info.access |= vk::AccessFlagBits::eTransferRead;
+			}
+			if (accesses & Bit(RenderAccess::TransferWrite)) {
+				info.stages |= vk::PipelineStageFlagBits::eTransfer;
+				info.access |= vk::AccessFlagBits::eTransferWrite;
+			}
+			return info;
+		}
+
+		vk::ImageUsageFlags Usage(uint32_t accesses) {
+			vk::ImageUsageFlags usage;
+			if (accesses & Bit(RenderAccess::ColourAttachment)) usage |= vk::ImageUsageFlagBits::eColorAttachment;
+			if (accesses & Bit(RenderAccess::DepthAttachment)) usage |= vk::ImageUsageFlagBits::eDepthStencilAttachment;
+			if (accesses & Bit(RenderAccess::Sampled)) usage |= vk::ImageUsageFlagBits::eSampled;
+			if (accesses & (Bit(RenderAccess::StorageRead) | Bit(RenderAccess::StorageWrite))) usage |= vk::ImageUsageFlagBits::eStorage;
+			if (accesses & Bit(RenderAccess::TransferRead)) usage |= vk::ImageUsageFlagBits::eTransferSrc;
+			if (accesses & Bit(RenderAccess::TransferWrite)) usage |= vk::ImageUsageFlagBits::eTransferDst;
+			return usage;
+		}
+
+		vk::ImageAspectFlags Aspect(vk::Format format) {
+			switch (format) {
+				case vk::Format::eD16Unorm: return vk::ImageAspectFlagBits::eDepth;
+				case vk::Format::eD32Sfloat: return vk::ImageAspectFlagBits::eDepth;
+				case vk::Format::eD24UnormS8Uint: return vk::ImageAspectFlagBits::eDepth | vk::ImageAspectFlagBits::eStencil;
+				case vk::Format::eD32SfloatS8Uint: return vk::ImageAspectFlagBits::eDepth | vk::ImageAspectFlagBits::eStencil;
+				default: return vk::ImageAspectFlagBits::eColor;
+			}
+		}
+
+		// Who's going to use an imported image once the graph is done with it.
+		void FinalAccess(vk::ImageLayout layout, vk::PipelineStageFlags& stages, vk::AccessFlags& access) {
+			switch (layout) {
+				case vk::ImageLayout::ePresentSrcKHR:
+					// Presenting is synchronised by the semaphore the submission signals.
+					stages = vk::PipelineStageFlagBits::eBottomOfPipe;
+					access = vk::AccessFlags();
+					break;
+				case vk::ImageLayout::eTransferSrcOptimal:
+					stages = vk::PipelineStageFlagBits::eTransfer;
+					access = vk::AccessFlagBits::eTransferRead;
+					break;
+				case vk::ImageLayout::eShaderReadOnlyOptimal:
+					stages = vk::PipelineStageFlagBits::eFragmentShader | vk::PipelineStageFlagBits::eComputeShader;
+					access = vk::AccessFlagBits::eShaderRead;
+					break;
+				default:
+					stages = vk::PipelineStageFlagBits::eAllCommands;
+					access = vk::AccessFlagBits::eMemoryRead;
+					break;
+			}
+		}
+
+		bool Covers(vk::PipelineStageFlags have, vk::PipelineStageFlags want) {
+			return (have & want) == want;
+		}
+
+		bool Covers(vk::AccessFlags have, vk::AccessFlags want) {
+			return (have & want) == want;
+		}
+	}
+
+	RenderGraph::RenderGraph(GpuAllocator* allocator, QueueFamilies queueFamilies, vk::Queue computeQueue, uint32_t framesInFlight) {
+		this->allocator = allocator;
+		this->device = allocator->Device();
+		this->queueFamilies = queueFamilies;
+		this->computeQueue = computeQueue;
+		this->compiled = false;
+		this->barrierCount = 0;
+		this->currentFrame = 0;
+		this->submittedCompute = false;
+
+		// Async compute gets its own command buffers, since they go to a different queue family.
+		if (queueFamilies.HasAsyncCompute()) {
+			computeFrames.resize(framesInFlight);
+			for (ComputeFrame& frame : computeFrames) {
+				frame.commandPool = device.createCommandPool(vk::CommandPoolCreateInfo(vk::CommandPoolCreateFlagBits::eTransient, queueFamilies.compute));
+				frame.commandBuffer = device.allocateCommandBuffers(vk::CommandBufferAllocateInfo(frame.commandPool, vk::CommandBufferLevel::ePrimary, 1))[0];
+				frame.computeFinished = device.createSemaphore(vk::SemaphoreCreateInfo());
+				frame.graphicsFinished = device.createSemaphore(vk::SemaphoreCreateInfo());
+			}
+		}
+	}
+
+	RenderGraph::~RenderGraph() {
+		Reset();
+
+		for (ComputeFrame& frame : computeFrames) {
+			device.destroySemaphore(frame.graphicsFinished);
+			device.destroySemaphore(frame.computeFinished);
+			device.destroyCommandPool(frame.commandPool);
+		}
+	}
+
+	void RenderGraph::Reset() {
+		for (Resource& resource : resources) {
+			if (!resource.imported && resource.image) {
+				device.destroyImageView(resource.view);
+				device.destroyImage(resource.image);
+			}
+		}
+		for (Slot& slot : slots) {
+			allocator->Free(slot.memory);
+		}
+
+		resources.clear();
+		passes.clear();
+		slots.clear();
+		computeOrder.clear();
+		graphicsOrder.clear();
+		finalBarriers = BarrierBatch();
+		compiled = false;
+	}
+
+	RenderResource RenderGraph::ImportImage(const char* name, vk::Format format, vk::Extent2D extent, vk::ImageLayout initialLayout, vk::ImageLayout finalLayout) {
+		Resource resource = Resource();
+		resource.name = name;
+		resource.imported = true;
+		resource.format = format;
+		resource.extent = extent;
+		resource.initialLayout = initialLayout;
+		resource.finalLayout = finalLayout;
+		resources.push_back(resource);
+		return static_cast<RenderResource>(resources.size() - 1);
+	}
+
+	RenderResource RenderGraph::CreateImage(const char* name, vk::Format format, vk::Extent2D extent) {
+		Resource resource = Resource();
+		resource.name = name;
+		resource.imported = false;
+		resource.format = format;
+		resource.extent = extent;
+		resource.initialLayout = vk::ImageLayout::eUndefined;
+		resource.finalLayout = vk::ImageLayout::eUndefined;
+		resources.push_back(resource);
+		return static_cast<RenderResource>(resources.size() - 1);
+	}
+
+	uint32_t RenderGraph::AddPass(const char* name, RenderQueue queue, RenderPassFunction function, void* data) {
+		Pass pass;
+		pass.name = name;
+		pass.queue = queue;
+		pass.function = function;
+		pass.data = data;
+		pass.live = false;
+		pass.async = false;
+		passes.push_back(pass);
+		return static_cast<uint32_t>(passes.size() - 1);
+	}
+
+	void RenderGraph::Use(uint32_t pass, RenderResource resource, RenderAccess access) {
+		// An image can only be in one layout for the whole pass, so uses within a pass are merged.
+		for (ResourceUse& use : passes[pass].uses) {
+			if (use.resource == resource) {
+				if (Layout(use.accesses) != Layout(access)) {
+					throw std::runtime_error("A render pass uses an image in two different layouts.");
+				}
+				use.accesses |= Bit(access);
+				return;
+			}
+		}
+		passes[pass].uses.push_back({ resource, Bit(access) });
+	}
+
+	void RenderGraph::Compile() {
+		Cull();
+		Schedule();
+		AllocateTransients();
+		PlaceBarriers();
+		compiled = true;
+	}
+
+	void RenderGraph::Cull() {
+		// Working backwards from the imported images, a pass only stays if something after it needs what
+		// it writes. An image that's written without being read first doesn't need whoever wrote it before.
+		std::vector<bool> needed(resources.size());
+		for (size_t i = 0; i < resources.size(); ++i) {
+			needed[i] = resources[i].imported;
+			resources[i].live = false;
+		}
+
+		for (size_t p = passes.size(); p > 0; --p) {
+			Pass& pass = passes[p - 1];
+			pass.live = false;
+			for (ResourceUse& use : pass.uses) {
+				if ((use.accesses & WriteAccesses) && needed[use.resource]) {
+					pass.live = true;
+				}
+			}
+			if (!pass.live) {
+				continue;
+			}
+
+			for (ResourceUse& use : pass.uses) {
+				if (!(use.accesses & ReadAccesses) && !resources[use.resource].imported) {
+					needed[use.resource] = false;
+				}
+			}
+			for (ResourceUse& use : pass.uses) {
+				if (use.accesses & ReadAccesses) {
+					needed[use.resource] = true;
+				}
+				resources[use.resource].live = true;
+			}
+		}
+	}
+
+	void RenderGraph::Schedule() {
+		// Async passes are submitted before the graphics work, so one can only go to the compute queue if
+		// nothing on the graphics queue has touched its images yet this frame. Imported images stay on the
+		// graphics queue too, since they weren't made to be shared between queue families.
+		computeOrder.clear();
+		graphicsOrder.clear();
+		std::vector<bool> touchedByGraphics(resources.size(), false);
+		for (Resource& resource : resources) {
+			resource.onCompute = false;
+		}
+
+		for (uint32_t p = 0; p < passes.size(); ++p) {
+			Pass& pass = passes[p];
+			if (!pass.live) {
+				continue;
+			}
+
+			pass.async = pass.queue == RenderQueue::AsyncCompute && queueFamilies.HasAsyncCompute();
+			for (ResourceUse& use : pass.uses) {
+				if (resources[use.resource].imported || touchedByGraphics[use.resource]) {
+					pass.async = false;
+				}
+			}
+
+			if (pass.async) {
+				computeOrder.push_back(p);
+			} else {
+				graphicsOrder.push_back(p);
+			}
+			for (ResourceUse& use : pass.uses) {
+				if (pass.async) {
+					resources[use.resource].onCompute = true;
+				} else {
+					touchedByGraphics[use.resource] = true;
+				}
+			}
+		}
+
+		// Lifetimes are counted in the order the passes run.
+		for (Resource& resource : resources) {
+			resource.firstUse = UINT32_MAX;
+			resource.lastUse = 0;
+			resource.usage = vk::ImageUsageFlags();
+		}
+		std::vector<uint32_t> order = computeOrder;
+		order.insert(order.end(), graphicsOrder.begin(), graphicsOrder.end());
+		for (uint32_t position = 0; position < order.size(); ++position) {
+			for (ResourceUse& use : passes[order[position]].uses) {
+				Resource& resource = resources[use.resource];
+				resource.firstUse = std::min(resource.firstUse, position);
+				resource.lastUse = std::max(resource.lastUse, position);
+				resource.usage |= Usage(use.accesses);
+			}
+		}
+	}
+
+	void RenderGraph::AllocateTransients() {
+		std::vector<RenderResource> transients;
+		for (RenderResource r = 0; r < resources.size(); ++r) {
+			Resource& resource = resources[r];
+			if (resource.imported || !resource.live) {
+				continue;
+			}
+
+			// Anything the compute queue touches is shared with the graphics family instead of having its
+			// ownership handed back and forth.
+			uint32_t families[] = { queueFamilies.graphics, queueFamilies.compute };
+			vk::ImageCreateInfo imageInfo = vk::ImageCreateInfo();
+			imageInfo.setImageType(vk::ImageType::e2D);
+			imageInfo.setFormat(resource.format);
+			imageInfo.setExtent(vk::Extent3D(resource.extent.width, resource.extent.height, 1));
+			imageInfo.setMipLevels(1);
+			imageInfo.setArrayLayers(1);
+			imageInfo.setSamples(vk::SampleCountFlagBits::e1);
+			imageInfo.setTiling(vk::ImageTiling::eOptimal);
+			imageInfo.setUsage(resource.usage);
+			if (resource.onCompute && queueFamilies.compute != queueFamilies.graphics) {
+				imageInfo.setSharingMode(vk::SharingMode::eConcurrent);
+				imageInfo.setQueueFamilyIndexCount(2);
+				imageInfo.setPQueueFamilyIndices(families);
+			} else {
+				imageInfo.setSharingMode(vk::SharingMode::eExclusive);
+			}
+			imageInfo.setInitialLayout(vk::ImageLayout::eUndefined);
+			resource.image = device.createImage(imageInfo);
+			resource.requirements = device.getImageMemoryRequirements(resource.image);
+			transients.push_back(r);
+		}
+
+		// Biggest first, so the smaller images fill in around them. An image can move into a slot if it
+		// fits and isn't needed while anything already there is. Compute images run alongside the
+		// graphics passes, so their lifetimes can't be compared and they get a slot to themselves.
+		std::sort(transients.begin(), transients.end(), [this](RenderResource a, RenderResource b) { return resources[a].requirements.size > resources[b].requirements.size; });
+		for (RenderResource r : transients) {
+			Resource& resource = resources[r];
+			resource.slot = UINT32_MAX;
+			for (uint32_t s = 0; s < slots.size() && !resource.onCompute; ++s) {
+				Slot& slot = slots[s];
+				if (!slot.shared || resource.requirements.size > slot.requirements.size || resource.requirements.alignment > slot.requirements.alignment || !(resource.requirements.memoryTypeBits & slot.requirements.memoryTypeBits)) {
+					continue;
+				}
+				bool overlaps = false;
+				for (RenderResource occupant : slot.occupants) {
+					if (resource.firstUse <= resources[occupant].lastUse && resources[occupant].firstUse <= resource.lastUse) {
+						overlaps = true;
+					}
+				}
+				if (!overlaps) {
+					resource.slot = s;
+					break;
+				}
+			}
+
+			if (resource.slot == UINT32_MAX) {
+				Slot slot = Slot();
+				slot.requirements = resource.requirements;
+				slot.shared = !resource.onCompute;
+				slots.push_back(slot);
+				resource.slot = static_cast<uint32_t>(slots.size() - 1);
+			}
+			slots[resource.slot].requirements.memoryTypeBits &= resource.requirements.memoryTypeBits;
+			slots[resource.slot].occupants.push_back(r);
+		}
+
+		for (Slot& slot : slots) {
+			slot.memory = allocator->Allocate(slot.requirements, vk::MemoryPropertyFlagBits::eDeviceLocal);
+			std::sort(slot.occupants.begin(), slot.occupants.end(), [this](RenderResource a, RenderResource b) { return resources[a].firstUse < resources[b].firstUse; });
+			for (RenderResource r : slot.occupants) {
+				Resource& resource = resources[r];
+				device.bindImageMemory(resource.image, slot.memory.memory, slot.memory.offset);
+
+				vk::ImageViewCreateInfo viewInfo = vk::ImageViewCreateInfo();
+				viewInfo.setImage(resource.image);
+				viewInfo.setViewType(vk::ImageViewType::e2D);
+				viewInfo.setFormat(resource.format);
+				viewInfo.setSubresourceRange(vk::ImageSubresourceRange(Aspect(resource.format), 0, 1, 0, 1));
+				resource.view = device.createImageView(viewInfo);
+			}
+		}
+	}
+
+	void RenderGraph::PlaceBarriers() {
+		// What's happened to each image so far this frame, as far as the next barrier needs to know.
+		struct State {
+			bool touched;
+			bool onCompute;
+			vk::ImageLayout layout;
+			vk::PipelineStageFlags writeStages;
+			vk::AccessFlags writeAccess;
+			vk::PipelineStageFlags readStages;
+
+			// Where the last write has been made visible to, so later reads there don't need a barrier.
+			vk::PipelineStageFlags visibleStages;
+			vk::AccessFlags visibleAccess;
+		};
+		std::vector<State> states(resources.size(), State());
+		barrierCount = 0;
+		computeWaitStages = vk::PipelineStageFlags();
+
+		std::vector<uint32_t> order = computeOrder;
+		order.insert(order.end(), graphicsOrder.begin(), graphicsOrder.end());
+		for (uint32_t p : order) {
+			Pass& pass = passes[p];
+			pass.before = BarrierBatch();
+			for (ResourceUse& use : pass.uses) {
+				Resource& resource = resources[use.resource];
+				State& state = states[use.resource];
+				AccessInfo info = Resolve(use.accesses, pass.async);
+
+				Barrier barrier = { use.resource, state.layout, info.layout, vk::AccessFlags(), info.access };
+				vk::PipelineStageFlags srcStages;
+				bool needed = false;
+				if (!state.touched) {
+					// The first use in a frame always needs a barrier. What it waits on depends on what had the
+					// memory last, which isn't known until every image's been through here, so that's filled
+					// in afterwards. On the compute queue it only has to wait for the semaphore.
+					barrier.oldLayout = resource.imported ? resource.initialLayout : vk::ImageLayout::eUndefined;
+					resource.firstBarrierPass = p;
+					resource.firstBarrier = pass.before.barriers.size();
+					if (pass.async) {
+						srcStages = vk::PipelineStageFlagBits::eComputeShader;
+					}
+					needed = true;
+				} else if (state.onCompute && !pass.async) {
+					// The semaphore between the queues makes the compute work visible, as long as the graphics
+					// submission waits on it early enough. Only a change of layout still needs a barrier.
+					computeWaitStages |= info.stages;
+					srcStages = info.stages;
+					needed = state.layout != info.layout;
+					state.writeStages = vk::PipelineStageFlags();
+					state.writeAccess = vk::AccessFlags();
+					state.readStages = vk::PipelineStageFlags();
+				} else {
+					// Reads after reads in the same layout are the only thing that never needs a barrier.
+					bool layoutChange = state.layout != info.layout;
+					bool unseenWrite = state.writeAccess && !(Covers(state.visibleStages, info.stages) && Covers(state.visibleAccess, info.access));
+					bool overwrite = info.write && (state.readStages || state.writeStages);
+					if (layoutChange || unseenWrite || overwrite) {
+						srcStages = state.writeStages;
+						if (layoutChange || info.write) {
+							srcStages |= state.readStages;
+							state.readStages = vk::PipelineStageFlags();
+						}
+						barrier.srcAccess = state.writeAccess;
+						needed = true;
+					}
+				}
+
+				if (needed) {
+					pass.before.srcStages |= srcStages;
+					pass.before.dstStages |= info.stages;
+					pass.before.barriers.push_back(barrier);
+					state.visibleStages |= info.stages;
+					state.visibleAccess |= info.access;
+					++barrierCount;
+				}
+
+				state.touched = true;
+				state.onCompute = pass.async;
+				state.layout = info.layout;
+				if (info.write) {
+					state.writeStages = info.stages;
+					state.writeAccess = info.access & WriteAccessFlags;
+					state.readStages = vk::PipelineStageFlags();
+					state.visibleStages = vk::PipelineStageFlags();
+					state.visibleAccess = vk::AccessFlags();
+				} else {
+					state.readStages |= info.stages;
+				}
+				resource.endStages = state.writeStages | state.readStages;
+				resource.endAccess = state.writeAccess;
+			}
+		}
+
+		// Imported images are handed back in the layout whoever's next expects.
+		finalBarriers = BarrierBatch();
+		for (RenderResource r = 0; r < resources.size(); ++r) {
+			Resource& resource = resources[r];
+			State& state = states[r];
+			if (!resource.imported || !state.touched || (state.layout == resource.finalLayout && !state.writeAccess)) {
+				continue;
+			}
+
+			vk::PipelineStageFlags dstStages;
+			vk::AccessFlags dstAccess;
+			FinalAccess(resource.finalLayout, dstStages, dstAccess);
+			finalBarriers.srcStages |= state.writeStages | state.readStages;
+			finalBarriers.dstStages |= dstStages;
+			finalBarriers.barriers.push_back({ r, state.layout, resource.finalLayout, state.writeAccess, dstAccess });
+			++barrierCount;
+		}
+
+		// Now the first barrier of each image can wait on whatever had its memory before it: the previous
+		// image in the same slot, or the last one in the slot from the frame before. Imported images just
+		// wait on their own last use from the frame before.
+		for (RenderResource r = 0; r < resources.size(); ++r) {
+			Resource& resource = resources[r];
+			if (!resource.live || resource.onCompute) {
+				continue;
+			}
+
+			RenderResource previous = r;
+			if (!resource.imported) {
+				std::vector<RenderResource>& occupants = slots[resource.slot].occupants;
+				size_t index = std::find(occupants.begin(), occupants.end(), r) - occupants.begin();
+				previous = index > 0 ? occupants[index - 1] : occupants.back();
+			}
+
+			Pass& pass = passes[resource.firstBarrierPass];
+			pass.before.barriers[resource.firstBarrier].srcAccess = resources[previous].endAccess;
+			pass.before.srcStages |= resources[previous].endStages;
+		}
+	}
+
+	void RenderGraph::Bind(RenderResource resource, vk::Image image, vk::ImageView view) {
+		resources[resource].image = image;
+		resources[resource].view = view;
+	}
+
+	vk::Image RenderGraph::Image(RenderResource resource) {
+		return resources[resource].image;
+	}
+
+	vk::ImageView RenderGraph::View(RenderResource resource) {
+		return resources[resource].view;
+	}
+
+	void RenderGraph::Execute(vk::CommandBuffer commandBuffer, uint32_t frameIndex, GpuProfiler* profiler) {
+		if (!compiled) {
+			throw std::runtime_error("The render graph has to be compiled before it's run.");
+		}
+
+		currentFrame = frameIndex;
+		submittedCompute = false;
+
+		// The compute queue goes first so it can get started while the graphics work is still being recorded.
+		// It waits for the last frame's graphics work, since that might still be using the same images.
+		if (!computeOrder.empty()) {
+			ComputeFrame& frame = computeFrames[frameIndex];
+			device.resetCommandPool(frame.commandPool, vk::CommandPoolResetFlags());
+			frame.commandBuffer.begin(vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+			for (uint32_t p : computeOrder) {
+				RecordPass(frame.commandBuffer, passes[p], nullptr);
+			}
+			frame.commandBuffer.end();
+
+			vk::PipelineStageFlags waitStage = vk::PipelineStageFlagBits::eComputeShader;
+			vk::SubmitInfo submitInfo = vk::SubmitInfo();
+			submitInfo.setCommandBufferCount(1);
+			submitInfo.setPCommandBuffers(&frame.commandBuffer);
+			if (pendingGraphics) {
+				submitInfo.setWaitSemaphoreCount(1);
+				submitInfo.setPWaitSemaphores(&pendingGraphics);
+				submitInfo.setPWaitDstStageMask(&waitStage);
+			}
+			submitInfo.setSignalSemaphoreCount(1);
+			submitInfo.setPSignalSemaphores(&frame.computeFinished);
+			computeQueue.submit(submitInfo, vk::Fence());
+
+			pendingGraphics = vk::Semaphore();
+			submittedCompute = true;
+		}
+
+		for (uint32_t p : graphicsOrder) {
+			RecordPass(commandBuffer, passes[p], profiler);
+		}
+		RecordBarriers(commandBuffer, finalBarriers);
+	}
+
+	void RenderGraph::SubmitSemaphores(std::vector<vk::Semaphore>& waits, std::vector<vk::PipelineStageFlags>& waitStages, std::vector<vk::Semaphore>& signals) {
+		if (!submittedCompute) {
+			return;
+		}
+
+		// If nothing on the graphics side reads what compute made, it only has to be done by the end of the
+		// frame, so the frame's fence covers it.
+		ComputeFrame& frame = computeFrames[currentFrame];
+		waits.push_back(frame.computeFinished);
+		waitStages.push_back(computeWaitStages ? computeWaitStages : vk::PipelineStageFlags(vk::PipelineStageFlagBits::eBottomOfPipe));
+		signals.push_back(frame.graphicsFinished);
+		pendingGraphics = frame.graphicsFinished;
+	}
+
+	uint32_t RenderGraph::PassCount() {
+		return static_cast<uint32_t>(passes.size());
+	}
+
+	uint32_t RenderGraph::CulledPasses() {
+		return static_cast<uint32_t>(passes.size() - computeOrder.size() - graphicsOrder.size());
+	}
+
+	uint32_t RenderGraph::AsyncPasses() {
+		return static_cast<uint32_t>(computeOrder.size());
+	}
+
+	uint32_t RenderGraph::BarrierCount() {
+		return barrierCount;
+	}
+
+	vk::DeviceSize RenderGraph::TransientMemory() {
+		vk::DeviceSize size = 0;
+		for (Slot& slot : slots) {
+			size += slot.requirements.size;
+		}
+		return size;
+	}
+
+	vk::DeviceSize RenderGraph::UnaliasedMemory() {
+		vk::DeviceSize size = 0;
+		for (Resource& resource : resources) {
+			if (!resource.imported && resource.live) {
+				size += resource.requirements.size;
+			}
+		}
+		return size;
+	}
+
+	void RenderGraph::RecordBarriers(vk::CommandBuffer commandBuffer, const BarrierBatch& batch) {
+		if (batch.barriers.empty()) {
+			return;
+		}
+
+		// Everything a pass needs goes in one call, so the driver only has to stall once.
+		std::vector<vk::ImageMemoryBarrier> barriers;
+		for (const Barrier& barrier : batch.barriers) {
+			Resource& resource = resources[barrier.resource];
+			vk::ImageMemoryBarrier imageBarrier = vk::ImageMemoryBarrier();
+			imageBarrier.setSrcAccessMask(barrier.srcAccess);
+			imageBarrier.setDstAccessMask(barrier.dstAccess);
+			imageBarrier.setOldLayout(barrier.oldLayout);
+			imageBarrier.setNewLayout(barrier.newLayout);
+			imageBarrier.setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED);
+			imageBarrier.setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED);
+			imageBarrier.setImage(resource.image);
+			imageBarrier.setSubresourceRange(vk::ImageSubresourceRange(Aspect(resource.format), 0, 1, 0, 1));
+			barriers.push_back(imageBarrier);
+		}
+
+		vk::PipelineStageFlags srcStages = batch.srcStages ? batch.srcStages : vk::PipelineStageFlags(vk::PipelineStageFlagBits::eTopOfPipe);
+		vk::PipelineStageFlags dstStages = batch.dstStages ? batch.dstStages : vk::PipelineStageFlags(vk::PipelineStageFlagBits::eBottomOfPipe);
+		commandBuffer.pipelineBarrier(srcStages, dstStages, vk::DependencyFlags(), nullptr, nullptr, barriers);
+	}
+
+	void RenderGraph::RecordPass(vk::CommandBuffer commandBuffer, Pass& pass, GpuProfiler* profiler) {
+		RecordBarriers(commandBuffer, pass.before);
+
+		// Only the graphics queue's passes are timed, since that's the command buffer the profiler's in.
+		if (profiler != nullptr) {
+			GpuScope scope(profiler, commandBuffer, pass.name);
+			pass.function(commandBuffer, pass.data);
+		} else {
+			pass.function(commandBuffer, pass.data);
+		}
+	}
+}
\ No newline at end of file
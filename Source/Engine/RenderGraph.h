@@ -0,0 +1,188 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <vulkan/vulkan.hpp>
+
+#include "GpuAllocator.h"
+#include "GpuProfiler.h"
+#include "QueueFamilies.h"
+
+namespace Biendeo::VulkanGame {
+	typedef uint32_t RenderResource;
+	typedef void (*RenderPassFunction)(vk::CommandBuffer commandBuffer, void* data);
+
+	// Async compute passes run on the compute queue if the device has a separate one, and on the graphics
+	// queue otherwise.
+	enum class RenderQueue {
+		Graphics,
+		AsyncCompute
+	};
+
+	// How a pass uses an image. Each one implies the layout the image has to be in and what the barrier
+	// in front of the pass has to wait for.
+	enum class RenderAccess {
+		ColourAttachment,
+		DepthAttachment,
+		Sampled,
+		StorageRead,
+		StorageWrite,
+		TransferRead,
+		TransferWrite
+	};
+
+	// Passes declare the images they read and write, and Compile works out everything in between: which
+	// passes actually contribute to an imported image, the barriers and layout changes each one needs,
+	// which transient images can share memory, and which compute passes can run alongside the graphics
+	// queue. The graph is declared once and run every frame; anything that changes its shape (like the
+	// window size) means declaring and compiling it again.
+	class RenderGraph {
+		public:
+		static const RenderResource InvalidResource = UINT32_MAX;
+
+		RenderGraph(GpuAllocator* allocator, QueueFamilies queueFamilies, vk::Queue computeQueue, uint32_t framesInFlight);
+		~RenderGraph();
+
+		// Throws away the declared graph and anything it created. Wait for the GPU to be idle first.
+		void Reset();
+
+		// An image the graph doesn't own, like a swapchain image. It's left in finalLayout at the end of
+		// the frame, and starts each frame in initialLayout (undefined if its contents don't matter).
+		RenderResource ImportImage(const char* name, vk::Format format, vk::Extent2D extent, vk::ImageLayout initialLayout, vk::ImageLayout finalLayout);
+
+		// An image that only lives within a frame. The graph creates it, and it may share memory with
+		// other transient images that are never needed at the same time.
+		RenderResource CreateImage(const char* name, vk::Format format, vk::Extent2D extent);
+
+		// Passes run in the order they're added, so anything a pass reads has to be written before it.
+		uint32_t AddPass(const char* name, RenderQueue queue, RenderPassFunction function, void* data);
+		void Use(uint32_t pass, RenderResource resource, RenderAccess access);
+
+		void Compile();
+
+		// Points an imported image at what it is this frame.
+		void Bind(RenderResource resource, vk::Image image, vk::ImageView view);
+		vk::Image Image(RenderResource resource);
+		vk::ImageView View(RenderResource resource);
+
+		// Records the graphics passes into the command buffer, and records and submits the async compute
+		// passes on their own. The profiler can be null.
+		void Execute(vk::CommandBuffer commandBuffer, uint32_t frameIndex, GpuProfiler* profiler);
+
+		// What the graphics submission for the last Execute has to wait on and signal.
+		void SubmitSemaphores(std::vector<vk::Semaphore>& waits, std::vector<vk::PipelineStageFlags>& waitStages, std::vector<vk::Semaphore>& signals);
+
+		uint32_t PassCount();
+		uint32_t CulledPasses();
+		uint32_t AsyncPasses();
+		uint32_t BarrierCount();
+
+		// How much memory the transient images take, and how much they would without sharing.
+		vk::DeviceSize TransientMemory();
+		vk::DeviceSize UnaliasedMemory();
+
+		private:
+		struct Resource {
+			const char* name;
+			bool imported;
+			vk::Format format;
+			vk::Extent2D extent;
+			vk::ImageLayout initialLayout;
+			vk::ImageLayout finalLayout;
+			vk::Image image;
+			vk::ImageView view;
+
+			// Worked out by Compile.
+			vk::ImageUsageFlags usage;
+			bool live;
+			bool onCompute;
+			uint32_t firstUse;
+			uint32_t lastUse;
+			uint32_t slot;
+			vk::MemoryRequirements requirements;
+
+			// Where the frame's first barrier has to wait from, and where it is at the end of the frame.
+			uint32_t firstBarrierPass;
+			size_t firstBarrier;
+			vk::PipelineStageFlags endStages;
+			vk::AccessFlags endAccess;
+		};
+
+		struct ResourceUse {
+			RenderResource resource;
+			uint32_t accesses;
+		};
+
+		struct Barrier {
+			RenderResource resource;
+			vk::ImageLayout oldLayout;
+			vk::ImageLayout newLayout;
+			vk::AccessFlags srcAccess;
+			vk::AccessFlags dstAccess;
+		};
+
+		struct BarrierBatch {
+			vk::PipelineStageFlags srcStages;
+			vk::PipelineStageFlags dstStages;
+			std::vector<Barrier> barriers;
+		};
+
+		struct Pass {
+			const char* name;
+			RenderQueue queue;
+			RenderPassFunction function;
+			void* data;
+			std::vector<ResourceUse> uses;
+
+			bool live;
+			bool async;
+			BarrierBatch before;
+		};
+
+		// A piece of memory shared by transient images whose lifetimes don't overlap.
+		struct Slot {
+			vk::MemoryRequirements requirements;
+			std::vector<RenderResource> occupants;
+			bool shared;
+			GpuAllocation memory;
+		};
+
+		struct ComputeFrame {
+			vk::CommandPool commandPool;
+			vk::CommandBuffer commandBuffer;
+			vk::Semaphore computeFinished;
+			vk::Semaphore graphicsFinished;
+		};
+
+		GpuAllocator* allocator;
+		vk::Device device;
+		QueueFamilies queueFamilies;
+		vk::Queue computeQueue;
+
+		std::vector<Resource> resources;
+		std::vector<Pass> passes;
+		std::vector<Slot> slots;
+		bool compiled;
+
+		// Live passes in the order they run: the async compute ones first, since they're submitted first.
+		std::vector<uint32_t> computeOrder;
+		std::vector<uint32_t> graphicsOrder;
+		BarrierBatch finalBarriers;
+		vk::PipelineStageFlags computeWaitStages;
+		uint32_t barrierCount;
+
+		std::vector<ComputeFrame> computeFrames;
+		uint32_t currentFrame;
+		bool submittedCompute;
+		vk::Semaphore pendingGraphics;
+
+		void Cull();
+		void Schedule();
+		void AllocateTransients();
+		void PlaceBarriers();
+
+		void RecordBarriers(vk::CommandBuffer commandBuffer, const BarrierBatch& batch);
+		void RecordPass(vk::CommandBuffer commandBuffer, Pass& pass, GpuProfiler* profiler);
+	};
+}
\ No newline at end of file
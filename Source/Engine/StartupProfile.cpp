@@ -0,0 +1,55 @@
+#include "StartupProfile.h"
+
+#include <algorithm>
+
+#include "JobSystem.h"
+
+namespace Biendeo::VulkanGame {
+	StartupProfile::StartupProfile(FramePacer::Clock::time_point origin) {
+		this->origin = origin;
+	}
+
+	void StartupProfile::Record(const char* name, FramePacer::Clock::time_point begin, FramePacer::Clock::time_point end) {
+		StartupPhase phase;
+		phase.name = name;
+		phase.start = std::chrono::duration<double>(begin - origin).count();
+		phase.duration = std::chrono::duration<double>(end - begin).count();
+		phase.thread = JobSystem::ThreadIndex();
+
+		std::lock_guard<std::mutex> lock(mutex);
+		phases.push_back(phase);
+	}
+
+	std::vector<StartupPhase> StartupProfile::Phases() {
+		std::vector<StartupPhase> sorted;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			sorted = phases;
+		}
+		std::stable_sort(sorted.begin(), sorted.end(), [](const StartupPhase& a, const StartupPhase& b) { return a.start < b.start; });
+		return sorted;
+	}
+
+	double StartupProfile::Elapsed() {
+		return std::chrono::duration<double>(FramePacer::Clock::now() - origin).count();
+	}
+
+	double StartupProfile::SerialTime() {
+		std::lock_guard<std::mutex> lock(mutex);
+		double total = 0.0;
+		for (StartupPhase& phase : phases) {
+			total += phase.duration;
+		}
+		return total;
+	}
+
+	StartupScope::StartupScope(StartupProfile* profile, const char* name) {
+		this->profile = profile;
+		this->name = name;
+		this->begin = FramePacer::Clock::now();
+	}
+
+	StartupScope::~StartupScope() {
+		profile->Record(name, begin, FramePacer::Clock::now());
+	}
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include "FramePacer.h"
+
+namespace Biendeo::VulkanGame {
+	// One step of startup. Times are in seconds from when the engine started being constructed.
+	struct StartupPhase {
+		const char* name;
+		double start;
+		double duration;
+		unsigned thread;
+	};
+
+	// Times each step of startup on whichever thread runs it, so it's clear which ones overlapped and
+	// which ones everything else had to wait for.
+	class StartupProfile {
+		public:
+		StartupProfile(FramePacer::Clock::time_point origin);
+
+		// The name has to outlive the profile.
+		void Record(const char* name, FramePacer::Clock::time_point begin, FramePacer::Clock::time_point end);
+
+		// Sorted by when each phase started.
+		std::vector<StartupPhase> Phases();
+
+		// How long it's been since the origin.
+		double Elapsed();
+
+		// How long every phase took added together, which is roughly how long startup would take if
+		// nothing overlapped.
+		double SerialTime();
+
+		private:
+		FramePacer::Clock::time_point origin;
+		std::mutex mutex;
+		std::vector<StartupPhase> phases;
+	};
+
+	// Records a phase for as long as it's in scope.
+	class StartupScope {
+		public:
+		StartupScope(StartupProfile* profile, const char* name);
+		~StartupScope();
+
+		private:
+		StartupProfile* profile;
+		const char* name;
+		FramePacer::Clock::time_point begin;
+	};
+}
\ No newline at end of file
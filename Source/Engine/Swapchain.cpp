@@ -0,0 +1,172 @@
+#include "Swapchain.h"
+
+#include <algorithm>
+#include <system_error>
+
+namespace Biendeo::VulkanGame {
+	namespace {
+		bool IsOutOfDate(const std::system_error& error) {
+			return error.code().value() == static_cast<int>(vk::Result::eErrorOutOfDateKHR);
+		}
+	}
+
+	Swapchain::Swapchain(vk::PhysicalDevice physicalDevice, vk::Device device, vk::SurfaceKHR surface, vk::Extent2D extent, vk::PresentModeKHR presentMode, uint32_t imageCount) {
+		this->physicalDevice = physicalDevice;
+		this->device = device;
+		this->surface = surface;
+		this->requestedPresentMode = presentMode;
+		this->requestedImageCount = imageCount;
+
+		Create(extent, vk::SwapchainKHR());
+	}
+
+	Swapchain::~Swapchain() {
+		DestroyViews();
+		device.destroySwapchainKHR(swapchain);
+	}
+
+	void Swapchain::Recreate(vk::Extent2D extent) {
+		vk::SwapchainKHR oldSwapchain = swapchain;
+		DestroyViews();
+		Create(extent, oldSwapchain);
+		device.destroySwapchainKHR(oldSwapchain);
+	}
+
+	bool Swapchain::Acquire(vk::Semaphore imageAcquired, uint32_t& imageIndex) {
+		try {
+			vk::ResultValue<uint32_t> result = device.acquireNextImageKHR(swapchain, UINT64_MAX, imageAcquired, vk::Fence());
+			imageIndex = result.value;
+			// A suboptimal image is still fine to draw into this time.
+			return true;
+		} catch (const std::system_error& error) {
+			if (IsOutOfDate(error)) {
+				return false;
+			}
+			throw;
+		}
+	}
+
+	bool Swapchain::Present(vk::Queue queue, uint32_t imageIndex, vk::Semaphore renderFinished) {
+		vk::PresentInfoKHR presentInfo = vk::PresentInfoKHR();
+		presentInfo.setWaitSemaphoreCount(1);
+		presentInfo.setPWaitSemaphores(&renderFinished);
+		presentInfo.setSwapchainCount(1);
+		presentInfo.setPSwapchains(&swapchain);
+		presentInfo.setPImageIndices(&imageIndex);
+
+		try {
+			return queue.presentKHR(presentInfo) != vk::Result::eSuboptimalKHR;
+		} catch (const std::system_error& error) {
+			if (IsOutOfDate(error)) {
+				return false;
+			}
+			throw;
+		}
+	}
+
+	vk::Format Swapchain::Format() {
+		return surfaceFormat.format;
+	}
+
+	vk::Extent2D Swapchain::Extent() {
+		return extent;
+	}
+
+	vk::PresentModeKHR Swapchain::PresentMode() {
+		return presentMode;
+	}
+
+	uint32_t Swapchain::ImageCount() {
+		return static_cast<uint32_t>(images.size());
+	}
+
+	vk::Image Swapchain::Image(uint32_t index) {
+		return images[index];
+	}
+
+	vk::ImageView Swapchain::View(uint32_t index) {
+		return views[index];
+	}
+
+	bool Swapchain::ParsePresentMode(const std::string& name, vk::PresentModeKHR& presentMode) {
+		if (name == "FIFO") presentMode = vk::PresentModeKHR::eFifo;
+		else if (name == "FIFO_RELAXED") presentMode = vk::PresentModeKHR::eFifoRelaxed;
+		else if (name == "MAILBOX") presentMode = vk::PresentModeKHR::eMailbox;
+		else if (name == "IMMEDIATE") presentMode = vk::PresentModeKHR::eImmediate;
+		else return false;
+		return true;
+	}
+
+	void Swapchain::Create(vk::Extent2D extent, vk::SwapchainKHR oldSwapchain) {
+		vk::SurfaceCapabilitiesKHR capabilities = physicalDevice.getSurfaceCapabilitiesKHR(surface);
+
+		// Prefer plain 8-bit BGRA, but take whatever comes first if that's not there. A single undefined
+		// format means the surface doesn't care.
+		std::vector<vk::SurfaceFormatKHR> formats = physicalDevice.getSurfaceFormatsKHR(surface);
+		surfaceFormat = formats[0];
+		if (formats.size() == 1 && formats[0].format == vk::Format::eUndefined) {
+			surfaceFormat = vk::SurfaceFormatKHR(vk::Format::eB8G8R8A8Unorm, vk::ColorSpaceKHR::eSrgbNonlinear);
+		}
+		for (const vk::SurfaceFormatKHR& format : formats) {
+			if (format.format == vk::Format::eB8G8R8A8Unorm && format.colorSpace == vk::ColorSpaceKHR::eSrgbNonlinear) {
+				surfaceFormat = format;
+				break;
+			}
+		}
+
+		// FIFO is the only mode every driver has to support, so it's the fallback.
+		std::vector<vk::PresentModeKHR> presentModes = physicalDevice.getSurfacePresentModesKHR(surface);
+		presentMode = vk::PresentModeKHR::eFifo;
+		if (std::find(presentModes.begin(), presentModes.end(), requestedPresentMode) != presentModes.end()) {
+			presentMode = requestedPresentMode;
+		}
+
+		// A max image count of zero means there's no limit.
+		uint32_t imageCount = std::max(capabilities.minImageCount, requestedImageCount);
+		if (capabilities.maxImageCount > 0) {
+			imageCount = std::min(capabilities.maxImageCount, imageCount);
+		}
+
+		// Some surfaces dictate their size, others leave it to us within limits.
+		if (capabilities.currentExtent.width != UINT32_MAX) {
+			this->extent = capabilities.currentExtent;
+		} else {
+			this->extent.width = std::max(capabilities.minImageExtent.width, std::min(capabilities.maxImageExtent.width, extent.width));
+			this->extent.height = std::max(capabilities.minImageExtent.height, std::min(capabilities.maxImageExtent.height, extent.height));
+		}
+
+		vk::SwapchainCreateInfoKHR swapchainInfo = vk::SwapchainCreateInfoKHR();
+		swapchainInfo.setSurface(surface);
+		swapchainInfo.setMinImageCount(imageCount);
+		swapchainInfo.setImageFormat(surfaceFormat.format);
+		swapchainInfo.setImageColorSpace(surfaceFormat.colorSpace);
+		swapchainInfo.setImageExtent(this->extent);
+		swapchainInfo.setImageArrayLayers(1);
+		swapchainInfo.setImageUsage(vk::ImageUsageFlagBits::eColorAttachment);
+		swapchainInfo.setImageSharingMode(vk::SharingMode::eExclusive);
+		swapchainInfo.setPreTransform(capabilities.currentTransform);
+		swapchainInfo.setCompositeAlpha(vk::CompositeAlphaFlagBitsKHR::eOpaque);
+		swapchainInfo.setPresentMode(presentMode);
+		swapchainInfo.setClipped(VK_TRUE);
+		swapchainInfo.setOldSwapchain(oldSwapchain);
+		swapchain = device.createSwapchainKHR(swapchainInfo);
+
+		images = device.getSwapchainImagesKHR(swapchain);
+		for (vk::Image image : images) {
+			vk::ImageViewCreateInfo viewInfo = vk::ImageViewCreateInfo();
+			viewInfo.setImage(image);
+			viewInfo.setViewType(vk::ImageViewType::e2D);
+			viewInfo.setFormat(surfaceFormat.format);
+			viewInfo.setSubresourceRange(vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1));
+			views.push_back(device.createImageView(viewInfo));
+		}
+	}
+
+	void Swapchain::DestroyViews() {
+		for (vk::ImageView view : views) {
+			device.destroyImageView(view);
+		}
+		views.clear();
+		images.clear();
+	}
+}
\ No newline at end of file
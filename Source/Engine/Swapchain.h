@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <vulkan/vulkan.hpp>
+
+namespace Biendeo::VulkanGame {
+	class Swapchain {
+		public:
+		Swapchain(vk::PhysicalDevice physicalDevice, vk::Device device, vk::SurfaceKHR surface, vk::Extent2D extent, vk::PresentModeKHR presentMode, uint32_t imageCount);
+		~Swapchain();
+
+		// Rebuilds the swapchain for a new window size, reusing the old one while it's replaced.
+		void Recreate(vk::Extent2D extent);
+
+		// Both of these return false if the swapchain no longer matches the surface and needs recreating.
+		bool Acquire(vk::Semaphore imageAcquired, uint32_t& imageIndex);
+		bool Present(vk::Queue queue, uint32_t imageIndex, vk::Semaphore renderFinished);
+
+		vk::Format Format();
+		vk::Extent2D Extent();
+		vk::PresentModeKHR PresentMode();
+		uint32_t ImageCount();
+		vk::Image Image(uint32_t index);
+		vk::ImageView View(uint32_t index);
+
+		static bool ParsePresentMode(const std::string& name, vk::PresentModeKHR& presentMode);
+
+		private:
+		vk::PhysicalDevice physicalDevice;
+		vk::Device device;
+		vk::SurfaceKHR surface;
+
+		vk::SwapchainKHR swapchain;
+		vk::SurfaceFormatKHR surfaceFormat;
+		vk::Extent2D extent;
+		vk::PresentModeKHR requestedPresentMode;
+		vk::PresentModeKHR presentMode;
+		uint32_t requestedImageCount;
+
+		std::vector<vk::Image> images;
+		std::vector<vk::ImageView> views;
+
+		void Create(vk::Extent2D extent, vk::SwapchainKHR oldSwapchain);
+		void DestroyViews();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include "UniformAllocator.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Biendeo::VulkanGame {
+	UniformAllocator::UniformAllocator(GpuAllocator* allocator, vk::PhysicalDevice physicalDevice, uint32_t framesInFlight, vk::DeviceSize regionSize) {
+		this->allocator = allocator;
+		this->device = allocator->Device();
+		this->framesInFlight = framesInFlight;
+
+		// Slices can be bound as either kind of buffer, so they have to suit the stricter alignment.
+		vk::PhysicalDeviceLimits limits = physicalDevice.getProperties().limits;
+		this->alignment = std::max<vk::DeviceSize>(1, std::max(limits.minUniformBufferOffsetAlignment, limits.minStorageBufferOffsetAlignment));
+		this->regionSize = (regionSize + alignment - 1) / alignment * alignment;
+
+		// Dynamic offsets are only 32 bits.
+		if (this->regionSize * framesInFlight > UINT32_MAX) {
+			throw std::runtime_error("Uniform regions are too big for dynamic offsets.");
+		}
+
+		buffer = device.createBuffer(vk::BufferCreateInfo(vk::BufferCreateFlags(), this->regionSize * framesInFlight, vk::BufferUsageFlagBits::eUniformBuffer | vk::BufferUsageFlagBits::eStorageBuffer, vk::SharingMode::eExclusive));
+		memory = allocator->AllocateBuffer(buffer, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+
+		this->regionStart = 0;
+		this->head = 0;
+		this->highWater = 0;
+	}
+
+	UniformAllocator::~UniformAllocator() {
+		device.destroyBuffer(buffer);
+		allocator->Free(memory);
+	}
+
+	void UniformAllocator::Reset(uint32_t frameIndex) {
+		highWater = std::max<vk::DeviceSize>(highWater, std::min<vk::DeviceSize>(head.load(std::memory_order_relaxed), regionSize));
+		regionStart = frameIndex * regionSize;
+		head.store(0, std::memory_order_relaxed);
+	}
+
+	bool UniformAllocator::Allocate(uint32_t size, UniformSlice& slice) {
+		// Every slice is a whole number of alignments, so every offset stays aligned without any more work.
+		uint64_t alignedSize = (size + alignment - 1) / alignment * alignment;
+		uint64_t offset = head.fetch_add(alignedSize, std::memory_order_relaxed);
+		if (offset + alignedSize > regionSize) {
+			return false;
+		}
+
+		slice.buffer = buffer;
+		slice.offset = static_cast<uint32_t>(regionStart + offset);
+		slice.size = size;
+		slice.data = static_cast<uint8_t*>(memory.mapped) + regionStart + offset;
+		return true;
+	}
+
+	vk::DescriptorBufferInfo UniformAllocator::Descriptor(vk::DeviceSize range) {
+		return vk::DescriptorBufferInfo(buffer, 0, range);
+	}
+
+	vk::Buffer UniformAllocator::Buffer() {
+		return buffer;
+	}
+
+	vk::DeviceSize UniformAllocator::Alignment() {
+		return alignment;
+	}
+
+	vk::DeviceSize UniformAllocator::RegionSize() {
+		return regionSize;
+	}
+
+	vk::DeviceSize UniformAllocator::HighWater() {
+		return std::max<vk::DeviceSize>(highWater, std::min<vk::DeviceSize>(head.load(std::memory_order_relaxed), regionSize));
+	}
+}
\ No newline at end of file
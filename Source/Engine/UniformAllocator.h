@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#include <vulkan/vulkan.hpp>
+
+#include "GpuAllocator.h"
+
+namespace Biendeo::VulkanGame {
+	// A piece of this frame's uniform memory. Write through data, and bind the buffer with offset as the
+	// dynamic offset.
+	struct UniformSlice {
+		vk::Buffer buffer;
+		uint32_t offset;
+		uint32_t size;
+		void* data;
+	};
+
+	// One persistently mapped buffer split into a region per frame in flight. Handing out constants is
+	// an atomic bump and a memcpy, and it's safe from any recording thread. Each region is reset when its
+	// frame comes back around, which is only once the GPU is done with it.
+	class UniformAllocator {
+		public:
+		UniformAllocator(GpuAllocator* allocator, vk::PhysicalDevice physicalDevice, uint32_t framesInFlight, vk::DeviceSize regionSize);
+		~UniformAllocator();
+
+		// Starts handing out from the given frame's region. Call it after that frame's fence is waited on.
+		void Reset(uint32_t frameIndex);
+
+		// Returns false if this frame's region has run out.
+		bool Allocate(uint32_t size, UniformSlice& slice);
+
+		template <typename T>
+		bool Push(const T& value, UniformSlice& slice) {
+			if (!Allocate(static_cast<uint32_t>(sizeof(T)), slice)) {
+				return false;
+			}
+			std::memcpy(slice.data, &value, sizeof(T));
+			return true;
+		}
+
+		// What to write into a dynamic uniform or storage buffer descriptor. Every slice fits in range.
+		vk::DescriptorBufferInfo Descriptor(vk::DeviceSize range);
+
+		vk::Buffer Buffer();
+		vk::DeviceSize Alignment();
+		vk::DeviceSize RegionSize();
+
+		// The most any one frame has used, to size the regions by.
+		vk::DeviceSize HighWater();
+
+		private:
+		GpuAllocator* allocator;
+		vk::Device device;
+		vk::Buffer buffer;
+		GpuAllocation memory;
+
+		vk::DeviceSize alignment;
+		vk::DeviceSize regionSize;
+		uint32_t framesInFlight;
+
+		vk::DeviceSize regionStart;
+		std::atomic<uint64_t> head;
+		vk::DeviceSize highWater;
+	};
+}
\ No newline at end of file
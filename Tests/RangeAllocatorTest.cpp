@@ -0,0 +1,227 @@
+#include <cstdio>
+
+#include "../Source/Engine/RangeAllocator.h"
+
+using namespace Biendeo::VulkanGame;
+
+// These cover the bookkeeping behind GpuAllocator and GpuLinearPool, which doesn't need a device. Each
+// failed check is printed and counted, and the count is the exit code.
+
+namespace {
+	int failures = 0;
+
+	void Check(bool condition, const char* description, int line) {
+		if (!condition) {
+			std::printf("Line %d: %s\n", line, description);
+			++failures;
+		}
+	}
+
+	#define CHECK(condition) Check(condition, #condition, __LINE__)
+
+	void TestBuddyLevels() {
+		// Sizes are rounded up to a power of two, and the smallest node stops the splitting.
+		BuddyAllocator buddy(1000, 100);
+		CHECK(buddy.Size() == 1024);
+		CHECK(buddy.Levels() == 4);
+		CHECK(buddy.NodeSize(0) == 1024);
+		CHECK(buddy.NodeSize(3) == 128);
+
+		CHECK(buddy.LevelFor(1, 1) == 3);
+		CHECK(buddy.LevelFor(128, 1) == 3);
+		CHECK(buddy.LevelFor(129, 1) == 2);
+		CHECK(buddy.LevelFor(600, 1) == 0);
+
+		// A small piece with a big alignment needs a node as big as the alignment.
+		CHECK(buddy.LevelFor(16, 512) == 1);
+	}
+
+	void TestBuddySplit() {
+		BuddyAllocator buddy(1024, 128);
+		CHECK(buddy.FreeNodes(0) == 1);
+
+		// Taking the smallest node splits the whole range, leaving one free buddy at each level below it.
+		uint64_t offset = 1;
+		CHECK(buddy.Allocate(3, offset));
+		CHECK(offset == 0);
+		CHECK(buddy.FreeNodes(0) == 0);
+		CHECK(buddy.FreeNodes(1) == 1);
+		CHECK(buddy.FreeNodes(2) == 1);
+		CHECK(buddy.FreeNodes(3) == 1);
+		CHECK(buddy.Used() == 128);
+		CHECK(buddy.Allocations() == 1);
+		CHECK(buddy.LargestFree() == 512);
+
+		// The next one of the same size is the buddy that was left over, without any more splitting.
+		CHECK(buddy.Allocate(3, offset));
+		CHECK(offset == 128);
+		CHECK(buddy.FreeNodes(3) == 0);
+		CHECK(buddy.FreeNodes(2) == 1);
+
+		// A bigger one comes out of the free half rather than splitting anything it doesn't have to.
+		CHECK(buddy.Allocate(1, offset));
+		CHECK(offset == 512);
+		CHECK(buddy.FreeNodes(1) == 0);
+		CHECK(buddy.LargestFree() == 256);
+		CHECK(buddy.Used() == 768);
+		CHECK(buddy.Allocations() == 3);
+	}
+
+	void TestBuddyFull() {
+		BuddyAllocator buddy(512, 256);
+		uint64_t first = 0;
+		uint64_t second = 0;
+		uint64_t third = 0;
+		CHECK(buddy.Allocate(1, first));
+		CHECK(buddy.Allocate(1, second));
+		CHECK(first != second);
+
+		// Nothing's left, and a failed allocation doesn't touch the books.
+		CHECK(!buddy.Allocate(1, third));
+		CHECK(!buddy.Allocate(0, third));
+		CHECK(buddy.Used() == 512);
+		CHECK(buddy.Allocations() == 2);
+		CHECK(buddy.LargestFree() == 0);
+	}
+
+	void TestBuddyMerge() {
+		BuddyAllocator buddy(1024, 128);
+		uint64_t offsets[8];
+		for (int i = 0; i < 8; ++i) {
+			CHECK(buddy.Allocate(3, offsets[i]));
+		}
+		CHECK(buddy.Used() == 1024);
+
+		// Freeing nodes whose buddies are still taken leaves them at their own level.
+		buddy.Free(offsets[0], 3);
+		buddy.Free(offsets[2], 3);
+		CHECK(buddy.FreeNodes(3) == 2);
+		CHECK(buddy.FreeNodes(2) == 0);
+		CHECK(buddy.LargestFree() == 128);
+
+		// Freeing a buddy merges the pair into the level above, and keeps going while it can.
+		buddy.Free(offsets[1], 3);
+		CHECK(buddy.FreeNodes(3) == 1);
+		CHECK(buddy.FreeNodes(2) == 1);
+		buddy.Free(offsets[3], 3);
+		CHECK(buddy.FreeNodes(3) == 0);
+		CHECK(buddy.FreeNodes(2) == 0);
+		CHECK(buddy.FreeNodes(1) == 1);
+		CHECK(buddy.LargestFree() == 512);
+
+		// Out of order frees from the other half still find their way back to one whole range.
+		buddy.Free(offsets[7], 3);
+		buddy.Free(offsets[4], 3);
+		buddy.Free(offsets[6], 3);
+		CHECK(buddy.FreeNodes(0) == 0);
+		buddy.Free(offsets[5], 3);
+		CHECK(buddy.FreeNodes(0) == 1);
+		CHECK(buddy.FreeNodes(1) == 0);
+		CHECK(buddy.FreeNodes(2) == 0);
+		CHECK(buddy.FreeNodes(3) == 0);
+		CHECK(buddy.Used() == 0);
+		CHECK(buddy.Allocations() == 0);
+		CHECK(buddy.LargestFree() == 1024);
+	}
+
+	void TestBuddyMixedSizes() {
+		BuddyAllocator buddy(1024, 128);
+		uint64_t small = 0;
+		uint64_t large = 0;
+		uint64_t medium = 0;
+		CHECK(buddy.Allocate(3, small));
+		CHECK(buddy.Allocate(1, large));
+		CHECK(buddy.Allocate(2, medium));
+
+		// Nodes are aligned to their own size and never overlap.
+		CHECK(small % 128 == 0);
+		CHECK(large % 512 == 0);
+		CHECK(medium % 256 == 0);
+		CHECK(small + 128 <= medium || medium + 256 <= small);
+		CHECK(large + 512 <= small || small + 128 <= large);
+		CHECK(large + 512 <= medium || medium + 256 <= large);
+
+		// The small node merges with its free buddy straight away, but the half they're in has to wait
+		// for the medium node.
+		buddy.Free(large, 1);
+		buddy.Free(small, 3);
+		CHECK(buddy.FreeNodes(2) == 1);
+		CHECK(buddy.FreeNodes(0) == 0);
+		CHECK(buddy.LargestFree() == 512);
+		buddy.Free(medium, 2);
+		CHECK(buddy.FreeNodes(0) == 1);
+		CHECK(buddy.Used() == 0);
+	}
+
+	void TestLinearAlignment() {
+		LinearAllocator linear(1024);
+		uint64_t offset = 1;
+		CHECK(linear.Allocate(10, 1, offset));
+		CHECK(offset == 0);
+		CHECK(linear.Used() == 10);
+
+		// The next piece starts on its alignment, and the gap counts as used.
+		CHECK(linear.Allocate(100, 64, offset));
+		CHECK(offset == 64);
+		CHECK(linear.Used() == 164);
+		CHECK(linear.Allocate(1, 0, offset));
+		CHECK(offset == 164);
+	}
+
+	void TestLinearOverflow() {
+		LinearAllocator linear(256);
+		uint64_t offset = 0;
+		CHECK(linear.Allocate(200, 1, offset));
+
+		// A piece that doesn't fit fails without moving the head, so a smaller one still can.
+		CHECK(!linear.Allocate(100, 1, offset));
+		CHECK(linear.Used() == 200);
+		CHECK(!linear.Allocate(16, 256, offset));
+		CHECK(linear.Used() == 200);
+		CHECK(linear.Allocate(56, 1, offset));
+		CHECK(offset == 200);
+		CHECK(linear.Used() == 256);
+
+		// Full to the byte, even an empty piece with alignment past the end doesn't fit.
+		CHECK(!linear.Allocate(1, 1, offset));
+		CHECK(!linear.Allocate(0, 512, offset));
+
+		// Sizes big enough to wrap around don't sneak through either.
+		LinearAllocator other(256);
+		CHECK(other.Allocate(16, 1, offset));
+		CHECK(!other.Allocate(UINT64_MAX - 8, 1, offset));
+		CHECK(other.Used() == 16);
+	}
+
+	void TestLinearReset() {
+		LinearAllocator linear(256);
+		uint64_t offset = 0;
+		CHECK(linear.Allocate(256, 1, offset));
+		CHECK(!linear.Allocate(1, 1, offset));
+
+		// Everything comes back at once, and pieces start from the beginning again.
+		linear.Reset();
+		CHECK(linear.Used() == 0);
+		CHECK(linear.Size() == 256);
+		CHECK(linear.Allocate(32, 16, offset));
+		CHECK(offset == 0);
+		CHECK(linear.Allocate(224, 1, offset));
+		CHECK(offset == 32);
+	}
+}
+
+int main() {
+	TestBuddyLevels();
+	TestBuddySplit();
+	TestBuddyFull();
+	TestBuddyMerge();
+	TestBuddyMixedSizes();
+	TestLinearAlignment();
+	TestLinearOverflow();
+	TestLinearReset();
+
+	if (failures == 0) {
+		std::printf("All range allocator tests passed.\n");
+	}
+	return failures;
+}
\ No newline at end of file